@@ -31,4 +31,17 @@ function(cortex_setup_dependencies)
       )
   endif()
 
+  if(CORTEX_BUILD_BENCHMARKS AND NOT TARGET benchmark::benchmark)
+      find_package(benchmark QUIET)
+
+      if(NOT benchmark_FOUND)
+          CPMAddPackage(
+              NAME benchmark
+              GITHUB_REPOSITORY google/benchmark
+              VERSION 1.8.3
+              OPTIONS "BENCHMARK_ENABLE_TESTING OFF" "BENCHMARK_ENABLE_INSTALL OFF"
+          )
+      endif()
+  endif()
+
 endfunction()
@@ -34,6 +34,7 @@ macro(cortex_setup_options)
     option(CORTEX_ENABLE_PCH "Enable precompiled headers" OFF)
     option(CORTEX_ENABLE_CACHE "Enable ccache" ON)
     option(CORTEX_BUILD_TESTING "Enable testing" ON)
+    option(CORTEX_BUILD_BENCHMARKS "Enable benchmarks" OFF)
   else()
     option(CORTEX_WARNINGS_AS_ERRORS "Treat Warnings As Errors" OFF)
     option(CORTEX_ENABLE_SANITIZER_ADDRESS "Enable address sanitizer" OFF)
@@ -45,6 +46,7 @@ macro(cortex_setup_options)
     option(CORTEX_ENABLE_CPPCHECK "Enable cpp-check analysis" OFF)
     option(CORTEX_ENABLE_PCH "Enable precompiled headers" OFF)
     option(CORTEX_ENABLE_CACHE "Enable ccache" OFF)
+    option(CORTEX_BUILD_BENCHMARKS "Enable benchmarks" OFF)
   endif()
 
   message(STATUS "CORTEX_WARNINGS_AS_ERRORS: ${CORTEX_WARNINGS_AS_ERRORS}")
@@ -57,6 +59,7 @@ macro(cortex_setup_options)
   message(STATUS "CORTEX_ENABLE_CPPCHECK: ${CORTEX_ENABLE_CPPCHECK}")
   message(STATUS "CORTEX_ENABLE_PCH: ${CORTEX_ENABLE_PCH}")
   message(STATUS "CORTEX_ENABLE_CACHE: ${CORTEX_ENABLE_CACHE}")
+  message(STATUS "CORTEX_BUILD_BENCHMARKS: ${CORTEX_BUILD_BENCHMARKS}")
 
   if(NOT PROJECT_IS_TOP_LEVEL)
     mark_as_advanced(
@@ -71,7 +74,8 @@ macro(cortex_setup_options)
       CORTEX_ENABLE_CPPCHECK
       CORTEX_ENABLE_COVERAGE
       CORTEX_ENABLE_PCH
-      CORTEX_ENABLE_CACHE)
+      CORTEX_ENABLE_CACHE
+      CORTEX_BUILD_BENCHMARKS)
   endif()
 
 endmacro()
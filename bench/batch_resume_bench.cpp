@@ -0,0 +1,68 @@
+#include <cortex/basic_flow.hpp>
+#include <cortex/execution.hpp>
+#include <cortex/stack_allocator.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace cortex;
+
+namespace {
+
+/// Owns an execution, which is neither copyable nor movable.
+struct holder {
+    holder()
+        : exec(execution::create(stack_allocator::create(128 * 1024), basic_flow::make([](api::suspendable& suspender) {
+                                     while (true) {
+                                         suspender.suspend();
+                                     }
+                                 }))) {}
+
+    execution exec;
+};
+
+/**
+ * A runnable set of `range(0)` suspended executions in a random order, so that neither the stacks nor the handles
+ * are walked in address order and the hardware prefetcher cannot guess the next one.
+ */
+struct runnable_set {
+    explicit runnable_set(std::size_t count) {
+        holders.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            holders.push_back(std::make_unique<holder>());
+            batch.push_back(&holders.back()->exec);
+        }
+        std::shuffle(batch.begin(), batch.end(), std::mt19937(42));
+    }
+
+    std::vector<std::unique_ptr<holder>> holders;
+    std::vector<execution*> batch;
+};
+
+void BM_ResumeEach(benchmark::State& state) {
+    runnable_set set(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        for (execution* exec : set.batch) {
+            exec->resume();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_ResumeBatch(benchmark::State& state) {
+    runnable_set set(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        execution::resume_batch(set.batch);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(BM_ResumeEach)->Arg(64)->Arg(4096)->Arg(32768)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ResumeBatch)->Arg(64)->Arg(4096)->Arg(32768)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,98 @@
+#include <cortex/channel.hpp>
+#include <cortex/wait_group.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+using namespace cortex;
+
+namespace {
+
+constexpr std::int64_t messages_per_pair = 100000;
+
+/**
+ * `range(1)` producer/consumer pairs exchange messages over one channel of capacity `range(2)` on a scheduler with
+ * `range(0)` workers. For an unbounded queue, `range(2)` is the segment size.
+ */
+template <typename Queue>
+void BM_Channel(benchmark::State& state) {
+    const auto workers = static_cast<std::size_t>(state.range(0));
+    const auto pairs = static_cast<std::size_t>(state.range(1));
+    const auto capacity = static_cast<std::size_t>(state.range(2));
+    auto sched = work_stealing_scheduler::create(workers);
+
+    for (auto _ : state) {
+        channel<std::int64_t, Queue> ch(capacity);
+        sched->spawn([&] {
+            wait_group producers(static_cast<std::ptrdiff_t>(pairs));
+            for (std::size_t p = 0; p < pairs; ++p) {
+                work_stealing_scheduler::current()->spawn([&] {
+                    for (std::int64_t i = 0; i < messages_per_pair; ++i) {
+                        ch.send(i);
+                    }
+                    producers.done();
+                });
+                work_stealing_scheduler::current()->spawn([&] {
+                    while (auto value = ch.receive()) {
+                        benchmark::DoNotOptimize(*value);
+                    }
+                });
+            }
+            producers.wait();
+            ch.close();
+        });
+        sched->wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * messages_per_pair * static_cast<std::int64_t>(pairs));
+}
+
+/**
+ * One producer and one consumer over a channel with an SPSC ring of capacity `range(1)` on `range(0)` workers.
+ */
+void BM_SpscChannel(benchmark::State& state) {
+    const auto workers = static_cast<std::size_t>(state.range(0));
+    const auto capacity = static_cast<std::size_t>(state.range(1));
+    auto sched = work_stealing_scheduler::create(workers);
+
+    for (auto _ : state) {
+        spsc_channel<std::int64_t> ch(capacity);
+        sched->spawn([&] {
+            for (std::int64_t i = 0; i < messages_per_pair; ++i) {
+                ch.send(i);
+            }
+            ch.close();
+        });
+        sched->spawn([&] {
+            while (auto value = ch.receive()) {
+                benchmark::DoNotOptimize(*value);
+            }
+        });
+        sched->wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * messages_per_pair);
+}
+
+} // namespace
+
+BENCHMARK(BM_Channel<mpmc_queue<std::int64_t>>)
+    ->ArgNames({"workers", "pairs", "capacity"})
+    ->ArgsProduct({{1, 2, 4, 8}, {1, 4, 16}, {0, 1, 64, 1024}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_Channel<segmented_queue<std::int64_t>>)
+    ->ArgNames({"workers", "pairs", "segment"})
+    ->ArgsProduct({{1, 2, 4, 8}, {1, 4, 16}, {64, 1024}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_SpscChannel)
+    ->ArgNames({"workers", "capacity"})
+    ->ArgsProduct({{1, 2, 4}, {1, 64, 1024}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
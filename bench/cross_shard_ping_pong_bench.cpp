@@ -0,0 +1,63 @@
+#include <cortex/sharded_runtime.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+using namespace cortex;
+
+namespace {
+
+void bounce(const std::shared_ptr<std::int64_t>& remaining) {
+    if (--*remaining > 0) {
+        sharded_runtime::current()->submit(1 - sharded_runtime::current_shard(), [remaining] { bounce(remaining); });
+    }
+}
+
+/**
+ * `range(1)` balls bounce between shard 0 and shard 1 for `range(0)` round trips each.
+ * With a single ball every hop pays for the wakeup of a parked shard, with many balls hops are batched.
+ */
+void BM_PingPong(benchmark::State& state) {
+    const std::int64_t round_trips = state.range(0);
+    const std::int64_t balls = state.range(1);
+    auto rt = sharded_runtime::create(2);
+
+    for (auto _ : state) {
+        for (std::int64_t b = 0; b < balls; ++b) {
+            rt->submit(0, [remaining = std::make_shared<std::int64_t>(round_trips * 2)] { bounce(remaining); });
+        }
+        rt->wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * round_trips * balls * 2);
+}
+
+/**
+ * Shard 0 streams `range(0)` messages to shard 1, which only counts them.
+ */
+void BM_OneWayThroughput(benchmark::State& state) {
+    const std::int64_t messages = state.range(0);
+    auto rt = sharded_runtime::create(2);
+    std::atomic<std::int64_t> received {0};
+
+    for (auto _ : state) {
+        rt->submit(0, [&] {
+            for (std::int64_t i = 0; i < messages; ++i) {
+                sharded_runtime::current()->submit(1, [&received] {
+                    received.fetch_add(1, std::memory_order_relaxed);
+                });
+            }
+        });
+        rt->wait();
+    }
+
+    state.SetItemsProcessed(received.load());
+}
+
+} // namespace
+
+BENCHMARK(BM_PingPong)->ArgNames({"round_trips", "balls"})->ArgsProduct({{1000}, {1, 16, 256}})->UseRealTime();
+BENCHMARK(BM_OneWayThroughput)->ArgName("messages")->Arg(1000)->Arg(100000)->UseRealTime();
@@ -0,0 +1,219 @@
+#include <cortex/blocking_pool.hpp>
+#include <cortex/fiber_semaphore.hpp>
+#include <cortex/mpsc_inbox.hpp>
+#include <cortex/parker.hpp>
+#include <cortex/sharded_runtime.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace cortex;
+
+namespace {
+
+struct message {
+    message*& link() noexcept {
+        return next;
+    }
+
+    message* next = nullptr;
+};
+
+/**
+ * One side of a ping-pong over an inbox: messages arrive in the inbox, the owner sleeps on the parker.
+ */
+struct inbox_endpoint {
+    void send(message& m) {
+        if (inbox.push(m)) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            parking.unpark();
+        }
+    }
+
+    message* receive() {
+        while (true) {
+            if (message* m = inbox.pop(); m != nullptr) {
+                return m;
+            }
+
+            parking.prepare();
+            if (inbox.empty()) {
+                parking.wait();
+            }
+            parking.cancel();
+        }
+    }
+
+    mpsc_inbox<message> inbox;
+    parker parking;
+};
+
+/**
+ * Baseline of `inbox_endpoint` on a locked queue and a condition variable.
+ */
+struct locked_endpoint {
+    void send(message& m) {
+        {
+            std::lock_guard lock(mutex);
+            queue.push_back(&m);
+        }
+        ready.notify_one();
+    }
+
+    message* receive() {
+        std::unique_lock lock(mutex);
+        ready.wait(lock, [this] { return !queue.empty(); });
+        message* m = queue.front();
+        queue.pop_front();
+        return m;
+    }
+
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<message*> queue;
+};
+
+/**
+ * Two threads bounce one message `range(0)` times: every hop wakes up a thread that went to sleep.
+ */
+template <typename Endpoint>
+void thread_ping_pong(benchmark::State& state) {
+    const std::int64_t round_trips = state.range(0);
+    Endpoint ping;
+    Endpoint pong;
+    message m;
+
+    for (auto _ : state) {
+        std::thread echo([&] {
+            for (std::int64_t i = 0; i < round_trips; ++i) {
+                pong.send(*ping.receive());
+            }
+        });
+
+        for (std::int64_t i = 0; i < round_trips; ++i) {
+            ping.send(m);
+            benchmark::DoNotOptimize(pong.receive());
+        }
+        echo.join();
+    }
+
+    state.SetItemsProcessed(state.iterations() * round_trips * 2);
+}
+
+void BM_ParkerPingPong(benchmark::State& state) {
+    thread_ping_pong<inbox_endpoint>(state);
+}
+
+void BM_CondvarPingPong(benchmark::State& state) {
+    thread_ping_pong<locked_endpoint>(state);
+}
+
+/**
+ * `range(0)` producer threads stream messages into one consumer, which sleeps whenever its queue runs dry.
+ */
+template <typename Endpoint>
+void fan_in(benchmark::State& state) {
+    static constexpr std::size_t kMessages = 100'000;
+    const auto producers = static_cast<std::size_t>(state.range(0));
+    std::vector<message> messages(producers * kMessages);
+
+    for (auto _ : state) {
+        Endpoint consumer;
+        std::vector<std::thread> threads;
+        for (std::size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p] {
+                for (std::size_t i = 0; i < kMessages; ++i) {
+                    consumer.send(messages[p * kMessages + i]);
+                }
+            });
+        }
+
+        for (std::size_t i = 0; i < messages.size(); ++i) {
+            benchmark::DoNotOptimize(consumer.receive());
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(kMessages));
+}
+
+void BM_InboxFanIn(benchmark::State& state) {
+    fan_in<inbox_endpoint>(state);
+}
+
+void BM_LockedFanIn(benchmark::State& state) {
+    fan_in<locked_endpoint>(state);
+}
+
+/**
+ * Two fibers on two shards bounce a token `range(0)` times through fiber semaphores, every hop resumes a fiber
+ * through the inbox of the other shard.
+ */
+void BM_ShardFiberPingPong(benchmark::State& state) {
+    const std::int64_t round_trips = state.range(0);
+    auto rt = sharded_runtime::create(2);
+
+    for (auto _ : state) {
+        fiber_semaphore ping(0);
+        fiber_semaphore pong(0);
+
+        rt->submit(1, [&] {
+            for (std::int64_t i = 0; i < round_trips; ++i) {
+                ping.acquire();
+                pong.release();
+            }
+        });
+        rt->submit(0, [&] {
+            for (std::int64_t i = 0; i < round_trips; ++i) {
+                ping.release();
+                pong.acquire();
+            }
+        });
+        rt->wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * round_trips * 2);
+}
+
+/**
+ * `range(0)` fibers on a single worker offload empty calls: every call resumes its fiber through the worker inbox.
+ */
+void BM_OffloadRoundTrip(benchmark::State& state) {
+    static constexpr int kCalls = 100;
+    const std::int64_t fibers = state.range(0);
+    auto pool = blocking_pool::create(4);
+    auto sched = work_stealing_scheduler::create(1);
+
+    for (auto _ : state) {
+        for (std::int64_t f = 0; f < fibers; ++f) {
+            sched->spawn([&] {
+                for (int i = 0; i < kCalls; ++i) {
+                    pool->offload([] {});
+                }
+            });
+        }
+        sched->wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * fibers * kCalls);
+}
+
+} // namespace
+
+BENCHMARK(BM_ParkerPingPong)->ArgName("round_trips")->Arg(10'000)->UseRealTime();
+BENCHMARK(BM_CondvarPingPong)->ArgName("round_trips")->Arg(10'000)->UseRealTime();
+BENCHMARK(BM_InboxFanIn)->ArgName("producers")->Arg(1)->Arg(4)->UseRealTime();
+BENCHMARK(BM_LockedFanIn)->ArgName("producers")->Arg(1)->Arg(4)->UseRealTime();
+BENCHMARK(BM_ShardFiberPingPong)->ArgName("round_trips")->Arg(10'000)->UseRealTime();
+BENCHMARK(BM_OffloadRoundTrip)->ArgName("fibers")->Arg(1)->Arg(64)->UseRealTime();
@@ -0,0 +1,96 @@
+#include <cortex/reactor.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+using namespace cortex;
+
+namespace {
+
+constexpr std::size_t message_size = 64;
+constexpr std::int64_t messages_per_connection = 1000;
+
+int make_listener(sockaddr_in& address) {
+    const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    ::listen(fd, 1024);
+
+    socklen_t length = sizeof(address);
+    ::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length);
+    return fd;
+}
+
+void no_delay(int fd) {
+    const int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+/**
+ * `range(1)` loopback connections each do request/reply round trips of `message_size` bytes against an echo server,
+ * clients and server run on the same scheduler with `range(0)` workers.
+ */
+void BM_Echo(benchmark::State& state) {
+    const auto workers = static_cast<std::size_t>(state.range(0));
+    const auto connections = static_cast<std::size_t>(state.range(1));
+    auto r = reactor::create();
+    auto sched = work_stealing_scheduler::create(workers);
+
+    for (auto _ : state) {
+        sockaddr_in address {};
+        auto listener = r->attach(make_listener(address));
+
+        sched->spawn([&] {
+            for (std::size_t i = 0; i < connections; ++i) {
+                std::shared_ptr<reactor::descriptor> connection = listener->async_accept();
+                no_delay(connection->fd());
+                work_stealing_scheduler::current()->spawn([connection] {
+                    std::array<char, message_size> buffer {};
+                    while (const std::size_t size = connection->async_read(buffer.data(), buffer.size())) {
+                        connection->async_write(buffer.data(), size);
+                    }
+                });
+            }
+        });
+
+        for (std::size_t i = 0; i < connections; ++i) {
+            sched->spawn([&] {
+                auto client = r->attach(::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0));
+                no_delay(client->fd());
+                client->async_connect(reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+
+                std::array<char, message_size> request {};
+                std::array<char, message_size> reply {};
+                for (std::int64_t m = 0; m < messages_per_connection; ++m) {
+                    client->async_write(request.data(), request.size());
+                    std::size_t received = 0;
+                    while (received != reply.size()) {
+                        received += client->async_read(reply.data() + received, reply.size() - received);
+                    }
+                }
+            });
+        }
+        sched->wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * messages_per_connection * static_cast<std::int64_t>(connections));
+}
+
+} // namespace
+
+BENCHMARK(BM_Echo)
+    ->ArgNames({"workers", "connections"})
+    ->ArgsProduct({{1, 2, 4}, {1, 16, 128}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
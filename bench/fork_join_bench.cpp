@@ -0,0 +1,51 @@
+#include <cortex/wait_group.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+using namespace cortex;
+
+namespace {
+
+std::uint64_t busy_work(std::uint64_t seed, std::size_t rounds) {
+    for (std::size_t i = 0; i < rounds; ++i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    }
+    return seed;
+}
+
+/**
+ * One request fans out into `range(1)` sub-tasks on a scheduler with `range(0)` workers and joins them.
+ */
+void BM_ForkJoin(benchmark::State& state) {
+    const auto workers = static_cast<std::size_t>(state.range(0));
+    const auto fan_out = static_cast<std::size_t>(state.range(1));
+    auto sched = work_stealing_scheduler::create(workers);
+
+    for (auto _ : state) {
+        sched->spawn([&] {
+            wait_group pending(static_cast<std::ptrdiff_t>(fan_out));
+            for (std::size_t i = 0; i < fan_out; ++i) {
+                work_stealing_scheduler::current()->spawn([&pending, i] {
+                    benchmark::DoNotOptimize(busy_work(i, 2000));
+                    pending.done();
+                });
+            }
+            pending.wait();
+        });
+        sched->wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+} // namespace
+
+BENCHMARK(BM_ForkJoin)
+    ->ArgNames({"workers", "fan_out"})
+    ->ArgsProduct({{1, 2, 4, 8, 16, 32, 64}, {16, 256, 1024}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
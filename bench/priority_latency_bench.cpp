@@ -0,0 +1,176 @@
+#include <cortex/fiber.hpp>
+#include <cortex/priority_scheduler.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+using namespace cortex;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t workers = 2;
+
+/// Background fibers per worker, enough to keep every worker busy.
+constexpr std::size_t soakers_per_worker = 2;
+
+/// Time a background fiber computes between two yields.
+constexpr auto background_slice = std::chrono::microseconds(50);
+
+/// Time between two interactive requests.
+constexpr auto request_interval = std::chrono::microseconds(200);
+
+/// Time an interactive request computes.
+constexpr auto request_work = std::chrono::microseconds(5);
+
+/**
+ * Log-linear histogram of latencies in nanoseconds: 8 linear buckets per power of two, so percentiles are within 12%.
+ * Recording is lock-free, the workers share it.
+ */
+class latency_histogram {
+public:
+    void record(clock_type::duration latency) noexcept {
+        const auto ns = static_cast<std::uint64_t>(std::max<std::int64_t>(
+            1, std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count()));
+        _buckets[index(ns)].fetch_add(1, std::memory_order_relaxed);
+        _count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// Returns the upper bound, in microseconds, of the bucket holding the given percentile.
+    [[nodiscard]] double percentile(double p) const noexcept {
+        const auto target = static_cast<std::uint64_t>(p / 100.0 * static_cast<double>(_count.load()));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < bucket_count; ++i) {
+            seen += _buckets[i].load(std::memory_order_relaxed);
+            if (seen > target) {
+                return static_cast<double>(upper_bound(i)) / 1000.0;
+            }
+        }
+        return static_cast<double>(upper_bound(bucket_count - 1)) / 1000.0;
+    }
+
+    [[nodiscard]] std::uint64_t count() const noexcept {
+        return _count.load();
+    }
+
+private:
+    static constexpr std::size_t sub_bits = 3;
+    static constexpr std::size_t sub_buckets = std::size_t {1} << sub_bits;
+    static constexpr std::size_t bucket_count = 64 * sub_buckets;
+
+    static std::size_t index(std::uint64_t ns) noexcept {
+        const std::size_t magnitude = std::bit_width(ns);
+        if (magnitude <= sub_bits) {
+            return ns;
+        }
+        const std::size_t shift = magnitude - sub_bits - 1;
+        return (magnitude - sub_bits) * sub_buckets + ((ns >> shift) & (sub_buckets - 1));
+    }
+
+    static std::uint64_t upper_bound(std::size_t i) noexcept {
+        if (i < sub_buckets) {
+            return i + 1;
+        }
+        const std::size_t magnitude = i / sub_buckets + sub_bits;
+        const std::size_t shift = magnitude - sub_bits - 1;
+        return ((sub_buckets + (i % sub_buckets) + 1) << shift);
+    }
+
+    std::array<std::atomic<std::uint64_t>, bucket_count> _buckets {};
+    std::atomic<std::uint64_t> _count {0};
+};
+
+void burn(clock_type::duration duration) {
+    const auto until = clock_type::now() + duration;
+    while (clock_type::now() < until) {
+        benchmark::ClobberMemory();
+    }
+}
+
+template <typename Scheduler>
+void spawn_as(Scheduler& sched, priority_class cls, fiber::routine_t routine) {
+    if constexpr (std::is_same_v<Scheduler, priority_scheduler>) {
+        sched.spawn(cls, std::move(routine));
+    } else {
+        sched.spawn(std::move(routine));
+    }
+}
+
+/**
+ * Background fibers keep every worker busy, computing in slices and yielding in between, while `range(0)`
+ * interactive requests arrive at a fixed rate. Reports the histogram of the time a request waits to start and of the
+ * time a background fiber waits to get the processor back after a yield.
+ */
+template <typename Scheduler>
+void mixed_latency(benchmark::State& state, std::unique_ptr<Scheduler> (*create)()) {
+    const auto requests = static_cast<std::size_t>(state.range(0));
+    latency_histogram interactive;
+    latency_histogram background;
+
+    for (auto _ : state) {
+        auto sched = create();
+        std::atomic<bool> stop {false};
+
+        for (std::size_t i = 0; i < workers * soakers_per_worker; ++i) {
+            spawn_as(*sched, priority_class::background, [&] {
+                while (!stop.load(std::memory_order_relaxed)) {
+                    burn(background_slice);
+                    const auto yielded = clock_type::now();
+                    fiber::yield();
+                    background.record(clock_type::now() - yielded);
+                }
+            });
+        }
+
+        auto next = clock_type::now();
+        for (std::size_t i = 0; i < requests; ++i) {
+            next += request_interval;
+            std::this_thread::sleep_until(next);
+            spawn_as(*sched, priority_class::interactive, [&interactive, spawned = clock_type::now()] {
+                interactive.record(clock_type::now() - spawned);
+                burn(request_work);
+            });
+        }
+
+        stop = true;
+        sched->wait();
+    }
+
+    for (auto& [name, histogram] : {std::pair {"interactive", &interactive}, std::pair {"background", &background}}) {
+        state.counters[std::string(name) + "_p50_us"] = histogram->percentile(50);
+        state.counters[std::string(name) + "_p99_us"] = histogram->percentile(99);
+        state.counters[std::string(name) + "_p999_us"] = histogram->percentile(99.9);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(interactive.count()));
+}
+
+void BM_PrioritySchedulerLatency(benchmark::State& state) {
+    mixed_latency<priority_scheduler>(state, [] { return priority_scheduler::create(workers); });
+}
+
+/**
+ * Baseline of `BM_PrioritySchedulerLatency` on the FIFO injection queue of the work-stealing scheduler, where a
+ * request queues behind the yielded background fibers.
+ */
+void BM_WorkStealingLatency(benchmark::State& state) {
+    mixed_latency<work_stealing_scheduler>(state, [] { return work_stealing_scheduler::create(workers); });
+}
+
+} // namespace
+
+BENCHMARK(BM_PrioritySchedulerLatency)->Arg(2000)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_WorkStealingLatency)->Arg(2000)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,149 @@
+#include <cortex/basic_flow.hpp>
+#include <cortex/execution.hpp>
+#include <cortex/shared_stack.hpp>
+#include <cortex/stack_allocator.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+using namespace cortex;
+
+namespace {
+
+/// Size of the dedicated stacks, large enough for malloc to map them, so that only touched pages count.
+constexpr std::size_t dedicated_stack_size = 256 * 1024;
+
+/// Idle coroutines created by the memory benchmarks.
+constexpr std::size_t idle_coroutines = 10000;
+
+/// Keeps `bytes` of live frames below the flow, then suspends forever.
+void hold(api::suspendable& suspender, std::size_t bytes) {
+    volatile char frame[256];
+    frame[0] = 0;
+    if (bytes > sizeof(frame)) {
+        hold(suspender, bytes - sizeof(frame));
+        // Used after the call, so that the frame is not reused by a tail call.
+        frame[1] = frame[0];
+        return;
+    }
+    // Never cleared, the executions are unwound when they are destroyed.
+    volatile bool suspended = true;
+    while (suspended) {
+        suspender.suspend();
+    }
+}
+
+std::unique_ptr<api::flow> make_holder(std::size_t bytes) {
+    return basic_flow::make([bytes](api::suspendable& suspender) { hold(suspender, bytes); });
+}
+
+/// Returns the resident memory of the process, zero where it is not known.
+std::size_t resident_bytes() {
+#if defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    std::size_t pages = 0;
+    std::size_t resident = 0;
+    statm >> pages >> resident;
+    return resident * 4096;
+#else
+    return 0;
+#endif
+}
+
+struct dedicated_mode {
+    struct holder {
+        explicit holder(std::size_t bytes)
+            : exec(execution::create(stack_allocator::create(dedicated_stack_size), make_holder(bytes))) {}
+
+        execution exec;
+    };
+
+    std::unique_ptr<holder> make(std::size_t bytes) {
+        return std::make_unique<holder>(bytes);
+    }
+
+    static std::size_t held(const holder&) {
+        return sizeof(holder) + dedicated_stack_size;
+    }
+};
+
+struct shared_mode {
+    struct holder {
+        holder(shared_stack& st, std::size_t bytes)
+            : exec(shared_execution::create(st, make_holder(bytes))) {}
+
+        shared_execution exec;
+    };
+
+    std::unique_ptr<holder> make(std::size_t bytes) {
+        return std::make_unique<holder>(*stack, bytes);
+    }
+
+    static std::size_t held(const holder& h) {
+        return sizeof(holder) + h.exec.saved_size();
+    }
+
+    std::unique_ptr<shared_stack> stack = shared_stack::create(stack_allocator::create(1024 * 1024));
+};
+
+/**
+ * Suspends `idle_coroutines` coroutines with `range(0)` bytes of live frames each and reports the resident memory
+ * they add, and the memory they hold, per coroutine.
+ */
+template <typename Mode>
+void BM_IdleMemory(benchmark::State& state) {
+    const auto bytes = static_cast<std::size_t>(state.range(0));
+    Mode mode;
+    double resident = 0;
+    double held_bytes = 0;
+    for (auto _ : state) {
+        std::vector<std::unique_ptr<typename Mode::holder>> holders;
+        holders.reserve(idle_coroutines);
+        const std::size_t before = resident_bytes();
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < idle_coroutines; ++i) {
+            holders.push_back(mode.make(bytes));
+            holders.back()->exec.resume();
+        }
+        for (const auto& h : holders) {
+            total += Mode::held(*h);
+        }
+        resident = static_cast<double>(resident_bytes() - before) / idle_coroutines;
+        held_bytes = static_cast<double>(total) / idle_coroutines;
+    }
+    state.counters["resident_per_coroutine"] = resident;
+    state.counters["held_per_coroutine"] = held_bytes;
+}
+
+/**
+ * Resumes `range(0)` coroutines with `range(1)` bytes of live frames each in turn, so that every shared-stack resume
+ * saves one coroutine and restores another.
+ */
+template <typename Mode>
+void BM_Switch(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto bytes = static_cast<std::size_t>(state.range(1));
+    Mode mode;
+    std::vector<std::unique_ptr<typename Mode::holder>> holders;
+    for (std::size_t i = 0; i < count; ++i) {
+        holders.push_back(mode.make(bytes));
+    }
+
+    std::size_t next = 0;
+    for (auto _ : state) {
+        holders[next]->exec.resume();
+        next = next + 1 == count ? 0 : next + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK(BM_IdleMemory<dedicated_mode>)->Arg(512)->Arg(4096)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_IdleMemory<shared_mode>)->Arg(512)->Arg(4096)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Switch<dedicated_mode>)->ArgsProduct({{1, 64}, {512, 4096}});
+BENCHMARK(BM_Switch<shared_mode>)->ArgsProduct({{1, 64}, {512, 4096}});
@@ -0,0 +1,98 @@
+#include <cortex/fiber.hpp>
+#include <cortex/fiber_pool.hpp>
+#include <cortex/wait_group.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+
+using namespace cortex;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+/// Runs the body in a fiber of the scheduler and blocks until it returns, the pool keeps `wait` from returning.
+void run_in_fiber(work_stealing_scheduler& sched, const std::function<void()>& body) {
+    std::promise<void> done;
+    sched.spawn([&] {
+        body();
+        done.set_value();
+    });
+    done.get_future().wait();
+}
+
+/**
+ * A fiber spawns a task and yields until it has run, the iteration time is the time from the spawn call to the
+ * first instruction of the task. One worker, so both fibers share the thread.
+ */
+template <typename Spawn>
+void spawn_latency(benchmark::State& state, work_stealing_scheduler& sched, Spawn spawn) {
+    run_in_fiber(sched, [&] {
+        for (auto _ : state) {
+            clock_type::time_point started;
+            bool ran = false;
+            const auto spawned = clock_type::now();
+            spawn([&] {
+                started = clock_type::now();
+                ran = true;
+            });
+            while (!ran) {
+                fiber::yield();
+            }
+            state.SetIterationTime(std::chrono::duration<double>(started - spawned).count());
+        }
+    });
+}
+
+/**
+ * A fiber spawns `range(0)` empty tasks and waits for all of them.
+ */
+template <typename Spawn>
+void spawn_burst(benchmark::State& state, work_stealing_scheduler& sched, Spawn spawn) {
+    const std::ptrdiff_t tasks = state.range(0);
+    run_in_fiber(sched, [&] {
+        for (auto _ : state) {
+            wait_group pending(tasks);
+            for (std::ptrdiff_t i = 0; i < tasks; ++i) {
+                spawn([&pending] { pending.done(); });
+            }
+            pending.wait();
+        }
+    });
+    state.SetItemsProcessed(state.iterations() * tasks);
+}
+
+void BM_SchedulerSpawnLatency(benchmark::State& state) {
+    auto sched = work_stealing_scheduler::create(1);
+    spawn_latency(state, *sched, [&](fiber::routine_t task) { sched->spawn(std::move(task)); });
+}
+
+void BM_PoolSpawnLatency(benchmark::State& state) {
+    auto sched = work_stealing_scheduler::create(1);
+    auto pool = fiber_pool::create(*sched);
+    spawn_latency(state, *sched, [&](fiber_pool::task_t task) { pool->spawn(std::move(task)); });
+}
+
+void BM_SchedulerSpawnBurst(benchmark::State& state) {
+    auto sched = work_stealing_scheduler::create(1);
+    spawn_burst(state, *sched, [&](fiber::routine_t task) { sched->spawn(std::move(task)); });
+}
+
+void BM_PoolSpawnBurst(benchmark::State& state) {
+    auto sched = work_stealing_scheduler::create(1);
+    auto pool = fiber_pool::create(*sched);
+    spawn_burst(state, *sched, [&](fiber_pool::task_t task) { pool->spawn(std::move(task)); });
+}
+
+} // namespace
+
+BENCHMARK(BM_SchedulerSpawnLatency)->UseManualTime()->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_PoolSpawnLatency)->UseManualTime()->Unit(benchmark::kNanosecond);
+BENCHMARK(BM_SchedulerSpawnBurst)->Arg(64)->Arg(1024)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PoolSpawnBurst)->Arg(64)->Arg(1024)->UseRealTime()->Unit(benchmark::kMicrosecond);
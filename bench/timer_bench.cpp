@@ -0,0 +1,140 @@
+#include <cortex/timer_service.hpp>
+#include <cortex/timer_wheel.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace cortex;
+
+namespace {
+
+constexpr timer_wheel::tick_t max_timeout = 600'000;
+
+std::vector<timer_wheel::tick_t> make_deadlines(std::size_t count) {
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<timer_wheel::tick_t> deadline(1, max_timeout);
+    std::vector<timer_wheel::tick_t> deadlines(count);
+    for (auto& d : deadlines) {
+        d = deadline(rng);
+    }
+    return deadlines;
+}
+
+/**
+ * Arms and cancels `range(0)` idle timeouts, the common life of a connection timeout.
+ */
+void BM_WheelScheduleCancel(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto deadlines = make_deadlines(count);
+    std::vector<timer_wheel::entry> entries(count);
+    timer_wheel wheel;
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; ++i) {
+            wheel.schedule(entries[i], deadlines[i]);
+        }
+        for (auto& e : entries) {
+            wheel.cancel(e);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * Baseline of `BM_WheelScheduleCancel` on an ordered tree, the usual heap-like structure that supports cancelling.
+ */
+void BM_TreeScheduleCancel(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto deadlines = make_deadlines(count);
+    std::set<std::pair<timer_wheel::tick_t, std::size_t>> tree;
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; ++i) {
+            tree.emplace(deadlines[i], i);
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            tree.erase({deadlines[i], i});
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * Arms `range(0)` timers and lets all of them expire, advancing one millisecond tick at a time.
+ */
+void BM_WheelExpire(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto deadlines = make_deadlines(count);
+    std::vector<timer_wheel::entry> entries(count);
+
+    for (auto _ : state) {
+        timer_wheel wheel;
+        for (std::size_t i = 0; i < count; ++i) {
+            wheel.schedule(entries[i], deadlines[i]);
+        }
+        for (timer_wheel::tick_t now = 1; now <= max_timeout; ++now) {
+            benchmark::DoNotOptimize(wheel.advance(now));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * Baseline of `BM_WheelExpire` on an ordered tree.
+ */
+void BM_TreeExpire(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto deadlines = make_deadlines(count);
+
+    for (auto _ : state) {
+        std::set<std::pair<timer_wheel::tick_t, std::size_t>> tree;
+        for (std::size_t i = 0; i < count; ++i) {
+            tree.emplace(deadlines[i], i);
+        }
+        for (timer_wheel::tick_t now = 1; now <= max_timeout; ++now) {
+            while (!tree.empty() && tree.begin()->first <= now) {
+                tree.erase(tree.begin());
+            }
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * `range(0)` fibers on one worker sleep for one millisecond each.
+ */
+void BM_SleepFor(benchmark::State& state) {
+    const auto fibers = static_cast<std::size_t>(state.range(0));
+    auto timers = timer_service::create();
+    auto sched = work_stealing_scheduler::create(1);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < fibers; ++i) {
+            sched->spawn([&] { timers->sleep_for(std::chrono::milliseconds(1)); });
+        }
+        sched->wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(BM_WheelScheduleCancel)->ArgName("timers")->Arg(1000)->Arg(100'000)->Arg(1'000'000);
+BENCHMARK(BM_TreeScheduleCancel)->ArgName("timers")->Arg(1000)->Arg(100'000)->Arg(1'000'000);
+BENCHMARK(BM_WheelExpire)->ArgName("timers")->Arg(1000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TreeExpire)->ArgName("timers")->Arg(1000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SleepFor)->ArgName("fibers")->Arg(1)->Arg(1000)->Arg(100'000)->UseRealTime()->Unit(
+    benchmark::kMillisecond);
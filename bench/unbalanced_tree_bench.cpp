@@ -0,0 +1,69 @@
+#include <cortex/work_stealing_scheduler.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+
+using namespace cortex;
+
+namespace {
+
+/// Binomial tree in the style of the Unbalanced Tree Search benchmark: a node has `m` children with probability `q`.
+struct tree_shape {
+    std::size_t root_children;
+    std::size_t m;
+    double q;
+};
+
+std::uint64_t mix(std::uint64_t x) {
+    // splitmix64 finalizer
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27U)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31U);
+}
+
+void visit(const tree_shape& shape, std::uint64_t seed, std::atomic<std::size_t>& nodes) {
+    nodes.fetch_add(1, std::memory_order_relaxed);
+
+    const double draw = static_cast<double>(mix(seed) >> 11U) * 0x1.0p-53;
+    if (draw >= shape.q) {
+        return;
+    }
+
+    for (std::size_t i = 0; i < shape.m; ++i) {
+        work_stealing_scheduler::current()->spawn(
+            [&shape, child = mix(seed + i + 1), &nodes] { visit(shape, child, nodes); });
+    }
+}
+
+void BM_UnbalancedTree(benchmark::State& state) {
+    const auto workers = static_cast<std::size_t>(state.range(0));
+    // q * m slightly below one gives a deep tree with wildly different subtree sizes.
+    const tree_shape shape {64, 4, 0.2499};
+    auto sched = work_stealing_scheduler::create(workers);
+
+    std::atomic<std::size_t> nodes {0};
+    for (auto _ : state) {
+        sched->spawn([&] {
+            nodes.fetch_add(1, std::memory_order_relaxed);
+            for (std::size_t i = 0; i < shape.root_children; ++i) {
+                work_stealing_scheduler::current()->spawn([&shape, i, &nodes] { visit(shape, mix(i), nodes); });
+            }
+        });
+        sched->wait();
+    }
+
+    state.counters["nodes"] = static_cast<double>(nodes.load()) / static_cast<double>(state.iterations());
+    state.SetItemsProcessed(static_cast<std::int64_t>(nodes.load()));
+}
+
+} // namespace
+
+BENCHMARK(BM_UnbalancedTree)
+    ->ArgName("workers")
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
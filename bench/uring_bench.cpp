@@ -0,0 +1,203 @@
+#include <cortex/uring.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace cortex;
+
+namespace {
+
+constexpr std::size_t block_size = 4096;
+constexpr std::int64_t blocks_per_writer = 256;
+constexpr std::size_t message_size = 64;
+constexpr std::int64_t messages_per_pair = 1000;
+
+int make_temporary_file() {
+    std::string path = "/tmp/cortex_uring_bench_XXXXXX";
+    const int fd = ::mkstemp(path.data());
+    ::unlink(path.c_str());
+    return fd;
+}
+
+/// Each writer owns a contiguous region of the file.
+std::uint64_t block_offset(std::size_t writer, std::int64_t block) {
+    return (writer * blocks_per_writer + static_cast<std::uint64_t>(block)) * block_size;
+}
+
+/**
+ * `range(1)` fibers on `range(0)` workers each write `blocks_per_writer` blocks to their region of one file.
+ */
+void BM_UringFileWrite(benchmark::State& state) {
+    const auto workers = static_cast<std::size_t>(state.range(0));
+    const auto writers = static_cast<std::size_t>(state.range(1));
+    auto ring = uring::create();
+    auto sched = work_stealing_scheduler::create(workers);
+    const int fd = make_temporary_file();
+
+    for (auto _ : state) {
+        for (std::size_t w = 0; w < writers; ++w) {
+            sched->spawn([&, w] {
+                const std::array<char, block_size> block {};
+                for (std::int64_t b = 0; b < blocks_per_writer; ++b) {
+                    ring->async_write(fd, block.data(), block.size(), block_offset(w, b));
+                }
+            });
+        }
+        sched->wait();
+    }
+
+    ::close(fd);
+    state.SetItemsProcessed(state.iterations() * blocks_per_writer * static_cast<std::int64_t>(writers));
+}
+
+/**
+ * Baseline of `BM_UringFileWrite`: `range(0)` threads doing blocking `pwrite`s.
+ */
+void BM_ThreadFileWrite(benchmark::State& state) {
+    const auto writers = static_cast<std::size_t>(state.range(0));
+    const int fd = make_temporary_file();
+
+    for (auto _ : state) {
+        std::vector<std::thread> threads;
+        for (std::size_t w = 0; w < writers; ++w) {
+            threads.emplace_back([&, w] {
+                const std::array<char, block_size> block {};
+                for (std::int64_t b = 0; b < blocks_per_writer; ++b) {
+                    ::pwrite(fd, block.data(), block.size(), static_cast<off_t>(block_offset(w, b)));
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+
+    ::close(fd);
+    state.SetItemsProcessed(state.iterations() * blocks_per_writer * static_cast<std::int64_t>(writers));
+}
+
+/**
+ * `range(1)` socket pairs each do `messages_per_pair` ping-pong round trips of `message_size` bytes, both ends are
+ * fibers on `range(0)` workers.
+ */
+void BM_UringPingPong(benchmark::State& state) {
+    const auto workers = static_cast<std::size_t>(state.range(0));
+    const auto pairs = static_cast<std::size_t>(state.range(1));
+    auto ring = uring::create();
+    auto sched = work_stealing_scheduler::create(workers);
+
+    for (auto _ : state) {
+        std::vector<std::array<int, 2>> sockets(pairs);
+        for (auto& fds : sockets) {
+            ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds.data());
+            sched->spawn([&ring, fd = fds[0]] {
+                std::array<char, message_size> buffer {};
+                for (std::int64_t m = 0; m < messages_per_pair; ++m) {
+                    ring->async_write(fd, buffer.data(), buffer.size());
+                    for (std::size_t received = 0; received != buffer.size();) {
+                        received += ring->async_read(fd, buffer.data() + received, buffer.size() - received);
+                    }
+                }
+                // The echoing side sees the end of the stream.
+                ::shutdown(fd, SHUT_WR);
+            });
+            sched->spawn([&ring, fd = fds[1]] {
+                std::array<char, message_size> buffer {};
+                while (const std::size_t size = ring->async_read(fd, buffer.data(), buffer.size())) {
+                    ring->async_write(fd, buffer.data(), size);
+                }
+            });
+        }
+
+        sched->wait();
+        for (auto& fds : sockets) {
+            ::close(fds[0]);
+            ::close(fds[1]);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * messages_per_pair * static_cast<std::int64_t>(pairs));
+}
+
+/**
+ * Baseline of `BM_UringPingPong`: both ends of the `range(0)` socket pairs are threads doing blocking reads and writes.
+ */
+void BM_ThreadPingPong(benchmark::State& state) {
+    const auto pairs = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        std::vector<std::thread> threads;
+        std::vector<std::array<int, 2>> sockets(pairs);
+        for (auto& fds : sockets) {
+            ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds.data());
+            threads.emplace_back([fd = fds[0]] {
+                std::array<char, message_size> buffer {};
+                for (std::int64_t m = 0; m < messages_per_pair; ++m) {
+                    ::write(fd, buffer.data(), buffer.size());
+                    for (std::size_t received = 0; received != buffer.size();) {
+                        received += static_cast<std::size_t>(
+                            ::read(fd, buffer.data() + received, buffer.size() - received));
+                    }
+                }
+                ::shutdown(fd, SHUT_WR);
+            });
+            threads.emplace_back([fd = fds[1]] {
+                std::array<char, message_size> buffer {};
+                while (true) {
+                    const ssize_t size = ::read(fd, buffer.data(), buffer.size());
+                    if (size <= 0) {
+                        break;
+                    }
+                    ::write(fd, buffer.data(), static_cast<std::size_t>(size));
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        for (auto& fds : sockets) {
+            ::close(fds[0]);
+            ::close(fds[1]);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * messages_per_pair * static_cast<std::int64_t>(pairs));
+}
+
+} // namespace
+
+BENCHMARK(BM_UringFileWrite)
+    ->ArgNames({"workers", "writers"})
+    ->ArgsProduct({{1, 4}, {1, 16, 128}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ThreadFileWrite)
+    ->ArgName("writers")
+    ->Arg(1)
+    ->Arg(16)
+    ->Arg(128)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_UringPingPong)
+    ->ArgNames({"workers", "pairs"})
+    ->ArgsProduct({{1, 4}, {1, 16, 128}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ThreadPingPong)
+    ->ArgName("pairs")
+    ->Arg(1)
+    ->Arg(16)
+    ->Arg(128)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -49,6 +49,16 @@ struct flow {
      * @internal Consider making it noexcept.
      */
     virtual void run(api::suspendable& suspender) = 0;
+
+    /**
+     * @brief Suspends the running flow on behalf of code that only knows the current execution, e.g.
+     * `this_coroutine::suspend`. The default suspends right away, flows with suspension rules of their own override it.
+     *
+     * @param suspender The suspender the flow runs with.
+     */
+    virtual void suspend_self(api::suspendable& suspender) {
+        suspender.suspend();
+    }
 };
 
 } // namespace cortex::api
@@ -0,0 +1,94 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_API_SCHEDULER_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_API_SCHEDULER_HPP
+
+#include <functional>
+
+namespace cortex {
+
+class fiber;
+
+} // namespace cortex
+
+namespace cortex::api {
+
+/**
+ * @brief The `scheduler` interface represents a runtime that owns runnable fibers.
+ * A fiber that has been parked is handed back to its scheduler through this interface once it becomes runnable again.
+ */
+struct scheduler {
+    /**
+     * @brief Default constructor for the `scheduler` class.
+     */
+    scheduler() = default;
+
+    scheduler(const scheduler&) = delete;
+    scheduler(scheduler&&) = delete;
+    scheduler& operator=(const scheduler&) = delete;
+    scheduler& operator=(scheduler&&) = delete;
+
+    /**
+     * @brief Virtual destructor for proper cleanup in derived classes.
+     */
+    virtual ~scheduler() noexcept = default;
+
+    /**
+     * @brief Runs the routine in a new fiber owned by the scheduler.
+     * May be called from any thread.
+     *
+     * @param routine The routine of the fiber.
+     * @throws invalid_argument_error if the input routine is nullptr.
+     */
+    virtual void spawn(std::function<void()> routine) = 0;
+
+    /**
+     * @brief Makes the fiber runnable.
+     * May be called from any thread, but only once the fiber has been switched out.
+     *
+     * @param f The fiber to enqueue.
+     */
+    virtual void schedule(fiber& f) = 0;
+
+    /**
+     * @brief Requeues a fiber that gave up the processor voluntarily.
+     * Implementations should place it behind the work that is already runnable.
+     *
+     * @param f The fiber to enqueue.
+     */
+    virtual void reschedule(fiber& f) = 0;
+
+    /**
+     * @brief Makes the fiber runnable and asks for it to run right after the current fiber on the calling thread.
+     * Used for direct handoffs, e.g. waking the receiver of a message. The default is a plain `schedule`.
+     *
+     * @param f The fiber to enqueue.
+     */
+    virtual void schedule_next(fiber& f) {
+        schedule(f);
+    }
+
+    /**
+     * @brief Returns a handle of the calling thread to come back to with `schedule_home`.
+     * Must be called from a fiber of this scheduler. The default is a single home shared by every thread.
+     *
+     * @return The handle.
+     */
+    [[nodiscard]] virtual void* home() noexcept {
+        return nullptr;
+    }
+
+    /**
+     * @brief Makes the fiber runnable on the thread `home` was returned on.
+     * May be called from any thread, but only once the fiber has been switched out. The default is a plain
+     * `schedule`.
+     *
+     * @param f The fiber to enqueue.
+     * @param home The handle returned by `home`.
+     */
+    virtual void schedule_home(fiber& f, [[maybe_unused]] void* home) {
+        schedule(f);
+    }
+};
+
+} // namespace cortex::api
+
+#endif
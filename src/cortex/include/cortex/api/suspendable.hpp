@@ -23,6 +23,13 @@ struct suspendable {
      * It is responsible for stopping the current execution.
      */
     virtual void suspend() = 0;
+
+    /**
+     * @brief Pure virtual function that must be implemented by derived classes.
+     * It unwinds the stack of the current execution with `forced_unwind`, running every destructor on the way, and
+     * then finishes the execution as if its flow had returned.
+     */
+    [[noreturn]] virtual void unwind() = 0;
 };
 
 }; // namespace cortex::api
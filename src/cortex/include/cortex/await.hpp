@@ -0,0 +1,214 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_AWAIT_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_AWAIT_HPP
+
+#include <cortex/api/scheduler.hpp>
+#include <cortex/execution.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/future.hpp>
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace cortex {
+
+namespace detail {
+
+/**
+ * @brief Stackless coroutine standing in for a parked fiber: an awaitable resumes it and it wakes the fiber.
+ * It runs to its final suspension point and wakes the fiber only from there, so the fiber may destroy it right away.
+ */
+class fiber_wakeup {
+public:
+    struct promise_type {
+        explicit promise_type(fiber& f) noexcept
+            : owner(&f) {}
+
+        fiber_wakeup get_return_object() noexcept {
+            return fiber_wakeup(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() const noexcept {
+            return {};
+        }
+
+        auto final_suspend() const noexcept {
+            struct waker {
+                bool await_ready() const noexcept {
+                    return false;
+                }
+
+                void await_suspend(std::coroutine_handle<promise_type> handle) const noexcept {
+                    handle.promise().owner->wake();
+                }
+
+                void await_resume() const noexcept {}
+            };
+            return waker {};
+        }
+
+        void return_void() const noexcept {}
+
+        [[noreturn]] void unhandled_exception() const noexcept {
+            std::terminate();
+        }
+
+        fiber* owner;
+    };
+
+    /**
+     * @brief Creates the coroutine, suspended before its body.
+     * @param owner The fiber to wake.
+     */
+    static fiber_wakeup create(fiber& owner);
+
+    fiber_wakeup(const fiber_wakeup&) = delete;
+    fiber_wakeup(fiber_wakeup&& other) noexcept
+        : _handle(std::exchange(other._handle, nullptr)) {}
+    fiber_wakeup& operator=(const fiber_wakeup&) = delete;
+    fiber_wakeup& operator=(fiber_wakeup&&) = delete;
+
+    ~fiber_wakeup() noexcept {
+        if (_handle) {
+            _handle.destroy();
+        }
+    }
+
+    [[nodiscard]] std::coroutine_handle<> handle() const noexcept {
+        return _handle;
+    }
+
+private:
+    explicit fiber_wakeup(std::coroutine_handle<promise_type> handle) noexcept
+        : _handle(handle) {}
+
+    std::coroutine_handle<promise_type> _handle;
+};
+
+/**
+ * @brief An `await_suspend` call to run once the awaiting fiber is switched out, lives on the stack of that fiber.
+ */
+struct fiber_suspension {
+    /// Calls `await_suspend` and reports whether the awaitable took over the wakeup.
+    bool (*start)(fiber_suspension& self) = nullptr;
+    fiber* owner = nullptr;
+    std::coroutine_handle<> wakeup;
+    std::exception_ptr exception;
+};
+
+/**
+ * @brief Parks the current fiber and starts the suspension from the resuming thread.
+ */
+void suspend_fiber(fiber_suspension& s);
+
+template <typename Awaiter>
+struct awaiter_suspension : fiber_suspension {
+    explicit awaiter_suspension(Awaiter& a) noexcept
+        : awaiter(a) {
+        start = [](fiber_suspension& self) -> bool {
+            auto& s = static_cast<awaiter_suspension&>(self);
+            using result_t = decltype(s.awaiter.await_suspend(s.wakeup));
+            if constexpr (std::is_void_v<result_t>) {
+                s.awaiter.await_suspend(s.wakeup);
+                return true;
+            } else if constexpr (std::is_same_v<result_t, bool>) {
+                return s.awaiter.await_suspend(s.wakeup);
+            } else {
+                // Symmetric transfer: the returned coroutine runs here, on the resuming thread.
+                std::coroutine_handle<> next = s.awaiter.await_suspend(s.wakeup);
+                next.resume();
+                return true;
+            }
+        };
+    }
+
+    Awaiter& awaiter;
+};
+
+template <typename Awaitable>
+decltype(auto) get_awaiter(Awaitable&& awaitable) {
+    if constexpr (requires { std::forward<Awaitable>(awaitable).operator co_await(); }) {
+        return std::forward<Awaitable>(awaitable).operator co_await();
+    } else if constexpr (requires { operator co_await(std::forward<Awaitable>(awaitable)); }) {
+        return operator co_await(std::forward<Awaitable>(awaitable));
+    } else {
+        return std::forward<Awaitable>(awaitable);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Awaits a C++20 awaitable from a fiber, suspending the stack of the fiber instead of the thread.
+ * This is how deep call stacks running on fibers consume stackless async code. `await_suspend` is called by the
+ * resuming thread once the fiber is switched out, so the awaitable may resume its handle from anywhere, even from
+ * within `await_suspend`. The fiber is woken up when the handle is resumed and returns the result of `await_resume`.
+ * Awaiting is a cancellation point before the fiber suspends.
+ *
+ * @param awaitable The awaitable, such as a `cortex::future` or a task of a C++20 coroutine library.
+ * @return The result of `await_resume`.
+ * @rethrows the exception thrown by `await_suspend` or `await_resume`.
+ * @throws fiber::not_in_fiber if called outside of a fiber.
+ */
+template <typename Awaitable>
+decltype(auto) await(Awaitable&& awaitable) {
+    fiber* self = fiber::current();
+    if (self == nullptr) {
+        throw fiber::not_in_fiber("Unable to await outside of a fiber.");
+    }
+    fiber::cancellation_point();
+
+    decltype(auto) awaiter = detail::get_awaiter(std::forward<Awaitable>(awaitable));
+    if (!awaiter.await_ready()) {
+        const detail::fiber_wakeup wakeup = detail::fiber_wakeup::create(*self);
+        detail::awaiter_suspension<std::remove_reference_t<decltype(awaiter)>> s(awaiter);
+        s.owner = self;
+        s.wakeup = wakeup.handle();
+        detail::suspend_fiber(s);
+
+        if (s.exception != nullptr) {
+            std::rethrow_exception(s.exception);
+        }
+    }
+    return awaiter.await_resume();
+}
+
+/**
+ * @brief Runs the callable on a new fiber of the scheduler.
+ * The returned future can be waited for from a fiber or awaited from a C++20 coroutine with `co_await`, which makes
+ * deep-stack code callable from stackless code.
+ *
+ * @param sched The scheduler to run the fiber on.
+ * @param fn The callable, taking no arguments.
+ * @return The future of the result of the callable, or of its exception.
+ */
+template <typename F>
+future<std::invoke_result_t<F&>> async(api::scheduler& sched, F fn) {
+    using result_t = std::invoke_result_t<F&>;
+
+    auto p = std::make_shared<promise<result_t>>();
+    future<result_t> f = p->get_future();
+    sched.spawn([p, fn = std::move(fn)]() mutable {
+        try {
+            if constexpr (std::is_void_v<result_t>) {
+                std::invoke(fn);
+                p->set_value();
+            } else {
+                p->set_value(std::invoke(fn));
+            }
+        } catch (const forced_unwind&) {
+            // The fiber was cancelled, the future gets `broken_promise` once the promise is released.
+            throw;
+        } catch (...) {
+            p->set_exception(std::current_exception());
+        }
+    });
+    return f;
+}
+
+} // namespace cortex
+
+#endif
@@ -0,0 +1,165 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_BLOCKING_POOL_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_BLOCKING_POOL_HPP
+
+#include <cortex/error.hpp>
+#include <cortex/fiber.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cortex {
+
+/**
+ * @brief The `blocking_pool` class runs calls that block, such as `getaddrinfo` or `stat`, on dedicated threads.
+ * The calling fiber parks while its call runs on one of the pool threads and is then handed back to its scheduler,
+ * on the thread it parked on, with the result or the exception of the call. The worker threads of the scheduler keep
+ * running other fibers in the meantime.
+ */
+class blocking_pool {
+    /**
+     * @brief A call waiting for a pool thread, lives on the stack of the parked fiber.
+     */
+    struct job {
+        void (*execute)(job& self) = nullptr;
+        fiber* owner = nullptr;
+        /// The thread of the scheduler to resume the fiber on.
+        void* home = nullptr;
+        blocking_pool* pool = nullptr;
+        job* next = nullptr;
+    };
+
+public:
+    /// Default number of pool threads.
+    static constexpr std::size_t default_threads = 16;
+
+private:
+    /**
+     * @brief Private constructor for creating a pool.
+     * @param threads The number of pool threads.
+     */
+    explicit blocking_pool(std::size_t threads);
+
+public:
+    /**
+     * @brief Creates a pool and starts its threads.
+     * @param threads The number of pool threads.
+     * @return A unique pointer to the created pool.
+     * @throws invalid_argument_error if the number of threads is zero.
+     */
+    static std::unique_ptr<blocking_pool> create(std::size_t threads = default_threads);
+
+    /**
+     * @brief Returns the pool used by the free function `offload`, created on first use.
+     * @return The shared pool.
+     */
+    [[nodiscard]] static blocking_pool& shared();
+
+    /**
+     * @brief Runs the queued calls, then stops and joins the pool threads.
+     */
+    ~blocking_pool() noexcept;
+
+    blocking_pool(const blocking_pool&) = delete;
+    blocking_pool(blocking_pool&&) = delete;
+    blocking_pool& operator=(const blocking_pool&) = delete;
+    blocking_pool& operator=(blocking_pool&&) = delete;
+
+    /**
+     * @brief Runs the callable on a pool thread while the current fiber is parked.
+     * Outside of a fiber, the callable simply runs on the calling thread.
+     *
+     * @param fn The callable, taking no arguments.
+     * @return The result of the callable.
+     * @rethrows the exception thrown by the callable.
+     */
+    template <typename F>
+    std::invoke_result_t<F&> offload(F&& fn);
+
+private:
+    template <typename F>
+    struct call;
+
+    /**
+     * @brief Parks the current fiber until a pool thread has executed the job.
+     */
+    void run(job& j);
+
+    /// Park hook publishing the job once its fiber is switched out.
+    static void publish(void* j);
+
+    void work();
+
+    std::mutex _mutex;
+    std::condition_variable _ready;
+    job* _head {nullptr};
+    job* _tail {nullptr};
+    bool _stopping {false};
+    std::vector<std::thread> _threads;
+};
+
+template <typename F>
+struct blocking_pool::call : job {
+    using result_t = std::invoke_result_t<F&>;
+    static_assert(!std::is_reference_v<result_t>, "The offloaded callable must return by value.");
+
+    explicit call(F& f) noexcept
+        : fn(f) {
+        execute = [](job& self) {
+            auto& c = static_cast<call&>(self);
+            try {
+                if constexpr (std::is_void_v<result_t>) {
+                    std::invoke(c.fn);
+                } else {
+                    c.result.emplace(std::invoke(c.fn));
+                }
+            } catch (...) {
+                c.exception = std::current_exception();
+            }
+        };
+    }
+
+    F& fn;
+    std::optional<std::conditional_t<std::is_void_v<result_t>, bool, result_t>> result;
+    std::exception_ptr exception;
+};
+
+template <typename F>
+std::invoke_result_t<F&> blocking_pool::offload(F&& fn) {
+    if (fiber::current() == nullptr) {
+        return std::invoke(fn);
+    }
+
+    call<std::remove_reference_t<F>> c(fn);
+    run(c);
+
+    if (c.exception != nullptr) {
+        std::rethrow_exception(c.exception);
+    }
+    if constexpr (!std::is_void_v<std::invoke_result_t<F&>>) {
+        return std::move(*c.result);
+    }
+}
+
+/**
+ * @brief Runs a blocking callable on the shared `blocking_pool`, parking the current fiber meanwhile.
+ * @param fn The callable, taking no arguments.
+ * @return The result of the callable.
+ * @rethrows the exception thrown by the callable.
+ */
+template <typename F>
+std::invoke_result_t<F&> offload(F&& fn) {
+    return blocking_pool::shared().offload(std::forward<F>(fn));
+}
+
+} // namespace cortex
+
+#endif
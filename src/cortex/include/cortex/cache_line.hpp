@@ -0,0 +1,17 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_CACHE_LINE_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_CACHE_LINE_HPP
+
+#include <cstddef>
+
+namespace cortex {
+
+/**
+ * @brief The size used to keep independently written data on separate cache lines.
+ * @note `std::hardware_destructive_interference_size` is not used because its value may change between compiler
+ * versions and flags, which would make it unsafe in a public header.
+ */
+inline constexpr std::size_t cache_line_size = 64;
+
+} // namespace cortex
+
+#endif
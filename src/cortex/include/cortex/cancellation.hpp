@@ -0,0 +1,102 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_CANCELLATION_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_CANCELLATION_HPP
+
+#include <cortex/api/suspendable.hpp>
+
+#include <atomic>
+#include <exception>
+#include <optional>
+#include <stop_token>
+#include <utility>
+
+namespace cortex {
+
+/**
+ * @brief The `cancellation` class is the cancellation state of a fiber or a coroutine.
+ * Cancellation is requested directly or through a bound `std::stop_token`, from any thread. The owner acts on it at
+ * its next cancellation point by unwinding its stack with `forced_unwind`, which runs the destructors on the way and
+ * releases the stack right away. An owner that may be parked when the request comes in is told about it by a
+ * listener, so that it can cut the wait short.
+ */
+class cancellation {
+public:
+    /// Type alias for the function told about each request, on the requesting thread.
+    using listener_t = void (*)(void* arg) noexcept;
+
+    /**
+     * @brief Creates a cancellation state.
+     * @param listener The function told about each request, may be nullptr.
+     * @param arg The argument passed to the listener.
+     */
+    explicit cancellation(listener_t listener = nullptr, void* arg = nullptr) noexcept
+        : _listener(listener)
+        , _arg(arg) {}
+
+    cancellation(const cancellation&) = delete;
+    cancellation(cancellation&&) = delete;
+    cancellation& operator=(const cancellation&) = delete;
+    cancellation& operator=(cancellation&&) = delete;
+
+    ~cancellation() noexcept = default;
+
+    /**
+     * @brief Requests the cancellation. May be called from any thread.
+     */
+    void request() noexcept {
+        // Sequentially consistent, so that the listener and an owner about to park cannot both miss each other.
+        _requested.store(true, std::memory_order_seq_cst);
+        if (_listener != nullptr) {
+            _listener(_arg);
+        }
+    }
+
+    /**
+     * @brief Checks if the cancellation was requested.
+     * @return `true` if it was requested.
+     */
+    [[nodiscard]] bool is_requested() const noexcept {
+        return _requested.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Requests the cancellation once the token is stopped, right away if it already is.
+     * Replaces the previous token. Must not be called concurrently with itself.
+     *
+     * @param token The token.
+     */
+    void bind(std::stop_token token) {
+        _callback.reset();
+        _callback.emplace(std::move(token), requester {this});
+    }
+
+    /**
+     * @brief Unwinds the current execution if the cancellation was requested.
+     * Does nothing while an exception is in flight: throwing would terminate and the unwinding in progress does the
+     * job anyway.
+     *
+     * @param suspender The suspender of the current execution.
+     */
+    void unwind_if_requested(api::suspendable& suspender) const {
+        if (is_requested() && std::uncaught_exceptions() == 0) {
+            suspender.unwind();
+        }
+    }
+
+private:
+    struct requester {
+        cancellation* self;
+
+        void operator()() const noexcept {
+            self->request();
+        }
+    };
+
+    listener_t _listener;
+    void* _arg;
+    std::atomic<bool> _requested {false};
+    std::optional<std::stop_callback<requester>> _callback;
+};
+
+} // namespace cortex
+
+#endif
@@ -0,0 +1,543 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_CHANNEL_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_CHANNEL_HPP
+
+#include <cortex/error.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/mpmc_queue.hpp>
+#include <cortex/segmented_queue.hpp>
+#include <cortex/spinlock.hpp>
+#include <cortex/spsc_queue.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace cortex {
+
+/// Returned by `try_select` when no case is ready.
+inline constexpr std::size_t select_none = std::numeric_limits<std::size_t>::max();
+
+/**
+ * @brief Exception thrown when sending to a closed channel.
+ */
+struct channel_closed : public error {
+    using error::error;
+};
+
+namespace detail {
+
+/**
+ * @brief A queue that never fills up, such as `segmented_queue`.
+ */
+template <typename Queue>
+concept unbounded_queue = requires { requires Queue::unbounded; };
+
+/**
+ * @brief Shared by every waiter a `select` registers, the first channel to claim it decides which case fires.
+ */
+struct select_state {
+    explicit select_state(fiber* f) noexcept
+        : owner(f) {}
+
+    /**
+     * @brief Marks the case as the one that fired.
+     * @param index The index of the case.
+     * @return `false` if another case has already fired.
+     */
+    bool claim(std::size_t index) noexcept {
+        std::size_t expected = select_none;
+        return fired.compare_exchange_strong(expected, index, std::memory_order_acq_rel, std::memory_order_acquire);
+    }
+
+    fiber* owner;
+    std::atomic<std::size_t> fired {select_none};
+};
+
+/**
+ * @brief Intrusive node of a parked sender or receiver, lives on the stack of the parked fiber.
+ */
+struct channel_waiter {
+    select_state* state = nullptr;
+    /// The index of the case within its `select`.
+    std::size_t index = 0;
+    /// Rendezvous only: the value of a sender (`T*`) or the destination of a receiver (`std::optional<T>*`).
+    void* slot = nullptr;
+    /// Set by the counterpart of a rendezvous once the value has been transferred.
+    bool completed = false;
+    bool linked = false;
+    channel_waiter* prev = nullptr;
+    channel_waiter* next = nullptr;
+};
+
+/**
+ * @brief Doubly linked FIFO of waiters, protected by the spinlock of its channel.
+ * The number of waiters can be read without the lock, which is how the lock-free paths find out that somebody has to
+ * be woken up.
+ */
+class waiter_list {
+public:
+    waiter_list() = default;
+
+    waiter_list(const waiter_list&) = delete;
+    waiter_list(waiter_list&&) = delete;
+    waiter_list& operator=(const waiter_list&) = delete;
+    waiter_list& operator=(waiter_list&&) = delete;
+
+    ~waiter_list() noexcept = default;
+
+    void push_back(channel_waiter& w) noexcept;
+
+    /**
+     * @brief Unlinks the waiter, does nothing if it is not linked anymore.
+     * @param w The waiter to unlink.
+     */
+    void remove(channel_waiter& w) noexcept;
+
+    /**
+     * @brief Unlinks waiters from the front until one of them can be claimed.
+     * Waiters of a `select` that already fired are dropped on the way.
+     *
+     * @param exclude The `select` whose own waiters must be skipped, may be nullptr.
+     * @return The claimed waiter or nullptr.
+     */
+    [[nodiscard]] channel_waiter* claim(const select_state* exclude) noexcept;
+
+    /**
+     * @brief Checks without the lock whether anybody is waiting.
+     * @return `true` if the list looked non-empty.
+     */
+    [[nodiscard]] bool has_waiters() const noexcept;
+
+private:
+    channel_waiter* _head = nullptr;
+    channel_waiter* _tail = nullptr;
+    std::atomic<std::size_t> _size {0};
+};
+
+/**
+ * @brief Type independent state of a channel.
+ */
+struct channel_core {
+    /**
+     * @brief Marks the channel as closed and wakes every waiter.
+     */
+    void close();
+
+    /**
+     * @brief Claims one waiter of the list under the lock and wakes it. Used by the lock-free paths.
+     * @param list The list to take the waiter from.
+     */
+    void notify(waiter_list& list);
+
+    spinlock lock;
+    waiter_list senders;
+    waiter_list receivers;
+    std::atomic<bool> closed {false};
+};
+
+/**
+ * @brief A pending operation of a `select`, bound to one channel.
+ */
+class select_case {
+public:
+    /**
+     * @brief Constructor for the `select_case` class.
+     * @param core The channel of the operation.
+     * @param sending `true` for a send, `false` for a receive.
+     * @param slot The value to send or the destination of the received value.
+     */
+    select_case(channel_core& core, bool sending, void* slot) noexcept
+        : _core(core)
+        , _sending(sending)
+        , _slot(slot) {}
+
+    select_case(const select_case&) = delete;
+    select_case(select_case&&) = delete;
+    select_case& operator=(const select_case&) = delete;
+    select_case& operator=(select_case&&) = delete;
+
+    virtual ~select_case() noexcept = default;
+
+    [[nodiscard]] channel_core& core() const noexcept {
+        return _core;
+    }
+
+    /**
+     * @brief Completes the operation if it can be done right away. The lock of the channel is held.
+     * @param self The `select` the caller's waiters belong to, nullptr if it has none.
+     * @param woken Set to the counterpart to wake once the lock is released.
+     * @return `true` if the operation has completed.
+     */
+    virtual bool try_complete(const select_state* self, fiber*& woken) = 0;
+
+    void enqueue(channel_waiter& w) noexcept {
+        w.slot = _slot;
+        (_sending ? _core.senders : _core.receivers).push_back(w);
+    }
+
+    void dequeue(channel_waiter& w) noexcept {
+        (_sending ? _core.senders : _core.receivers).remove(w);
+    }
+
+private:
+    channel_core& _core;
+    bool _sending;
+    void* _slot;
+};
+
+/**
+ * @brief Runs a `select` over the cases, the scratch spans have one entry per case.
+ * @param cases The cases.
+ * @param locks Scratch for the locks of the channels.
+ * @param waiters Scratch for the waiters of the cases.
+ * @param block Park until a case completes instead of returning `select_none`.
+ * @return The index of the completed case.
+ */
+std::size_t run_select(std::span<select_case* const> cases,
+                       std::span<channel_core*> locks,
+                       std::span<channel_waiter> waiters,
+                       bool block);
+
+template <typename... Cases>
+std::size_t select(bool block, Cases&&... cases) {
+    static_assert(sizeof...(Cases) > 0, "At least one case is required.");
+    static_assert((std::is_base_of_v<select_case, std::remove_cvref_t<Cases>> && ...),
+                  "Cases are made by `channel::on_send` and `channel::on_receive`.");
+
+    const std::array<select_case*, sizeof...(Cases)> list {&cases...};
+    std::array<channel_core*, sizeof...(Cases)> locks {};
+    std::array<channel_waiter, sizeof...(Cases)> waiters {};
+    return run_select(list, locks, waiters, block);
+}
+
+} // namespace detail
+
+/**
+ * @brief The `channel` class is a Go-style typed pipe between fibers.
+ * A buffered channel keeps up to `capacity` values in a lock-free ring, sends and receives that find room or a value
+ * never take the lock. The capacity is rounded up to a power of two by the ring, e.g. `channel<int>(3)` buffers 4
+ * values. A channel of capacity zero is a rendezvous: every send waits for a receiver and the value is handed over
+ * directly. A channel over an unbounded queue, `unbounded_channel`, is always buffered and its sends never wait.
+ * Blocking operations park the calling fiber instead of blocking the thread, the counterpart that completes them wakes
+ * it with `fiber::wake_next`, so a handoff between fibers of the same thread switches straight to the woken fiber.
+ *
+ * @tparam T The value type, must be default constructible and movable.
+ * @tparam Queue The queue of a buffered channel, `mpmc_queue<T>`, `spsc_queue<T>` or `segmented_queue<T>`.
+ */
+template <typename T, typename Queue = mpmc_queue<T>>
+class channel {
+public:
+    /**
+     * @brief Send operation of a `select`.
+     */
+    class send_case final : public detail::select_case {
+    public:
+        send_case(channel& ch, T& value) noexcept
+            : select_case(ch._core, true, &value)
+            , _channel(ch)
+            , _value(value) {}
+
+        bool try_complete(const detail::select_state* self, fiber*& woken) override {
+            return _channel.try_send_locked(_value, self, woken);
+        }
+
+    private:
+        channel& _channel;
+        T& _value;
+    };
+
+    /**
+     * @brief Receive operation of a `select`.
+     */
+    class receive_case final : public detail::select_case {
+    public:
+        receive_case(channel& ch, std::optional<T>& out) noexcept
+            : select_case(ch._core, false, &out)
+            , _channel(ch)
+            , _out(out) {}
+
+        bool try_complete(const detail::select_state* self, fiber*& woken) override {
+            return _channel.try_receive_locked(_out, self, woken);
+        }
+
+    private:
+        channel& _channel;
+        std::optional<T>& _out;
+    };
+
+    /**
+     * @brief Creates an empty channel.
+     * @param capacity The number of buffered values, rounded up to a power of two, zero for a rendezvous channel. For
+     * an unbounded queue, the size of its segments, zero for the default.
+     */
+    explicit channel(std::size_t capacity = 0);
+
+    channel(const channel&) = delete;
+    channel(channel&&) = delete;
+    channel& operator=(const channel&) = delete;
+    channel& operator=(channel&&) = delete;
+
+    ~channel() noexcept = default;
+
+    /**
+     * @brief Returns the number of values the channel can buffer.
+     * @return The capacity after rounding, zero for a rendezvous channel, the largest `std::size_t` for an unbounded
+     * channel.
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept;
+
+    /**
+     * @brief Sends a value, parking the current fiber while the channel is full.
+     * @param value The value to send.
+     * @throws channel_closed if the channel is closed.
+     * @throws fiber::not_in_fiber if the send has to wait outside of a fiber.
+     */
+    void send(T value);
+
+    /**
+     * @brief Sends a value if it can be done without waiting.
+     * @param value The value to send, moved from only on success.
+     * @return `true` if the value was sent.
+     * @throws channel_closed if the channel is closed.
+     */
+    [[nodiscard]] bool try_send(T& value);
+
+    /**
+     * @brief Receives a value, parking the current fiber while the channel is empty.
+     * @return The value or an empty optional once the channel is closed and drained.
+     * @throws fiber::not_in_fiber if the receive has to wait outside of a fiber.
+     */
+    [[nodiscard]] std::optional<T> receive();
+
+    /**
+     * @brief Receives a value if one is available without waiting.
+     * @return The value or an empty optional if none is available.
+     */
+    [[nodiscard]] std::optional<T> try_receive();
+
+    /**
+     * @brief Closes the channel. Pending and future sends throw, receives drain the buffered values and then return
+     * an empty optional. Closing twice has no effect.
+     */
+    void close();
+
+    /**
+     * @brief Checks if the channel is closed.
+     * @return `true` if `close` has been called.
+     */
+    [[nodiscard]] bool is_closed() const noexcept;
+
+    /**
+     * @brief Makes a send case for `select`.
+     * @param value The value to send, must outlive the `select`.
+     * @return The case.
+     */
+    [[nodiscard]] send_case on_send(T& value) noexcept;
+
+    /**
+     * @brief Makes a receive case for `select`. The destination is reset if the case fires on a closed channel.
+     * @param out The destination of the received value, must outlive the `select`.
+     * @return The case.
+     */
+    [[nodiscard]] receive_case on_receive(std::optional<T>& out) noexcept;
+
+private:
+    bool try_send_locked(T& value, const detail::select_state* self, fiber*& woken);
+
+    bool try_receive_locked(std::optional<T>& out, const detail::select_state* self, fiber*& woken);
+
+    detail::channel_core _core;
+    /// nullptr for a rendezvous channel.
+    std::unique_ptr<Queue> _buffer;
+};
+
+/// Channel with a single sending fiber and a single receiving fiber.
+template <typename T>
+using spsc_channel = channel<T, spsc_queue<T>>;
+
+/// Channel that buffers any number of values, sends never park.
+template <typename T>
+using unbounded_channel = channel<T, segmented_queue<T>>;
+
+/**
+ * @brief Waits until one of the cases can complete and completes it.
+ * When several cases are ready, one of them is picked at random.
+ *
+ * @param cases Cases made by `channel::on_send` and `channel::on_receive`.
+ * @return The index of the completed case.
+ * @throws channel_closed if the completed case is a send to a closed channel.
+ * @throws fiber::not_in_fiber if the select has to wait outside of a fiber.
+ */
+template <typename... Cases>
+std::size_t select(Cases&&... cases) {
+    return detail::select(true, std::forward<Cases>(cases)...);
+}
+
+/**
+ * @brief Completes one of the cases if any of them can complete without waiting.
+ * @param cases Cases made by `channel::on_send` and `channel::on_receive`.
+ * @return The index of the completed case or `select_none`.
+ * @throws channel_closed if the completed case is a send to a closed channel.
+ */
+template <typename... Cases>
+std::size_t try_select(Cases&&... cases) {
+    return detail::select(false, std::forward<Cases>(cases)...);
+}
+
+template <typename T, typename Queue>
+channel<T, Queue>::channel(std::size_t capacity) {
+    if constexpr (detail::unbounded_queue<Queue>) {
+        _buffer = capacity == 0 ? std::make_unique<Queue>() : std::make_unique<Queue>(capacity);
+    } else if (capacity != 0) {
+        _buffer = std::make_unique<Queue>(capacity);
+    }
+}
+
+template <typename T, typename Queue>
+std::size_t channel<T, Queue>::capacity() const noexcept {
+    return _buffer == nullptr ? 0 : _buffer->capacity();
+}
+
+template <typename T, typename Queue>
+void channel<T, Queue>::send(T value) {
+    if (!try_send(value)) {
+        select(on_send(value));
+    }
+}
+
+template <typename T, typename Queue>
+bool channel<T, Queue>::try_send(T& value) {
+    if (_core.closed.load(std::memory_order_acquire)) {
+        throw channel_closed("Unable to send to a closed channel.");
+    }
+
+    if (_buffer == nullptr) {
+        // A rendezvous needs a parked receiver, which is only reachable under the lock.
+        return _core.receivers.has_waiters() && try_select(on_send(value)) == 0;
+    }
+
+    if (!_buffer->try_push(value)) {
+        return false;
+    }
+
+    // Pairs with the fence in `detail::select`: either the receiver sees the value or this check sees the receiver.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_core.receivers.has_waiters()) {
+        _core.notify(_core.receivers);
+    }
+    return true;
+}
+
+template <typename T, typename Queue>
+std::optional<T> channel<T, Queue>::receive() {
+    std::optional<T> out = try_receive();
+    if (!out.has_value()) {
+        select(on_receive(out));
+    }
+    return out;
+}
+
+template <typename T, typename Queue>
+std::optional<T> channel<T, Queue>::try_receive() {
+    std::optional<T> out;
+    if (_buffer == nullptr) {
+        if (_core.senders.has_waiters()) {
+            (void)try_select(on_receive(out));
+        }
+        return out;
+    }
+
+    out = _buffer->try_pop();
+    if (out.has_value()) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_core.senders.has_waiters()) {
+            _core.notify(_core.senders);
+        }
+    }
+    return out;
+}
+
+template <typename T, typename Queue>
+void channel<T, Queue>::close() {
+    _core.close();
+}
+
+template <typename T, typename Queue>
+bool channel<T, Queue>::is_closed() const noexcept {
+    return _core.closed.load(std::memory_order_acquire);
+}
+
+template <typename T, typename Queue>
+typename channel<T, Queue>::send_case channel<T, Queue>::on_send(T& value) noexcept {
+    return send_case(*this, value);
+}
+
+template <typename T, typename Queue>
+typename channel<T, Queue>::receive_case channel<T, Queue>::on_receive(std::optional<T>& out) noexcept {
+    return receive_case(*this, out);
+}
+
+template <typename T, typename Queue>
+bool channel<T, Queue>::try_send_locked(T& value, const detail::select_state* self, fiber*& woken) {
+    if (_core.closed.load(std::memory_order_relaxed)) {
+        throw channel_closed("Unable to send to a closed channel.");
+    }
+
+    if (_buffer == nullptr) {
+        detail::channel_waiter* w = _core.receivers.claim(self);
+        if (w == nullptr) {
+            return false;
+        }
+
+        *static_cast<std::optional<T>*>(w->slot) = std::move(value);
+        w->completed = true;
+        woken = w->state->owner;
+        return true;
+    }
+
+    if (!_buffer->try_push(value)) {
+        return false;
+    }
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (detail::channel_waiter* w = _core.receivers.claim(self); w != nullptr) {
+        woken = w->state->owner;
+    }
+    return true;
+}
+
+template <typename T, typename Queue>
+bool channel<T, Queue>::try_receive_locked(std::optional<T>& out, const detail::select_state* self, fiber*& woken) {
+    if (_buffer == nullptr) {
+        if (detail::channel_waiter* w = _core.senders.claim(self); w != nullptr) {
+            out = std::move(*static_cast<T*>(w->slot));
+            w->completed = true;
+            woken = w->state->owner;
+            return true;
+        }
+    } else if (std::optional<T> item = _buffer->try_pop(); item.has_value()) {
+        out = std::move(item);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (detail::channel_waiter* w = _core.senders.claim(self); w != nullptr) {
+            woken = w->state->owner;
+        }
+        return true;
+    }
+
+    // The values sent before `close` are drained first.
+    if (_core.closed.load(std::memory_order_relaxed)) {
+        out.reset();
+        return true;
+    }
+    return false;
+}
+
+} // namespace cortex
+
+#endif
@@ -2,12 +2,14 @@
 #define SRC_CORTEX_INCLUDE_CORTEX_COROUTINE_HPP
 
 #include <cortex/api/suspendable.hpp>
+#include <cortex/cancellation.hpp>
 #include <cortex/error.hpp>
 #include <cortex/execution.hpp>
 #include <cortex/stack_allocator.hpp>
 
 #include <functional>
 #include <memory>
+#include <stop_token>
 
 namespace cortex {
 
@@ -115,10 +117,32 @@ public:
 
     /**
      * @brief Suspends the execution of the coroutine.
+     * A cancelled coroutine unwinds its stack with `forced_unwind` instead of suspending, and also right after it is
+     * resumed if it was cancelled while suspended. It then completes without an exception.
+     *
      * @throws suspend_on_not_started_coroutine if the coroutine has not started yet.
      */
     void suspend();
 
+    /**
+     * @brief Requests the coroutine to unwind at its next suspension point. May be called from any thread.
+     */
+    void cancel() noexcept;
+
+    /**
+     * @brief Cancels the coroutine once the token is stopped, right away if it already is.
+     * Replaces the previous token.
+     *
+     * @param token The token.
+     */
+    void cancel_on(std::stop_token token);
+
+    /**
+     * @brief Checks if the cancellation of the coroutine was requested.
+     * @return `true` if `cancel` was called or the bound token was stopped.
+     */
+    [[nodiscard]] bool is_cancelled() const noexcept;
+
     /**
      * @brief Checks if the coroutine has completed.
      * @return True if the coroutine has completed, false otherwise.
@@ -128,10 +152,13 @@ public:
 private:
     void run(api::suspendable& suspender) override;
 
+    void suspend_self(api::suspendable& suspender) override;
+
 public:
     bool _completed {false};
     routine_i* _routine {nullptr};
     api::suspendable* _suspender = nullptr;
+    cancellation _cancellation;
     execution _exec;
 };
 
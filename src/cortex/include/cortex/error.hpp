@@ -3,6 +3,7 @@
 
 #include <stdexcept>
 #include <string>
+#include <system_error>
 
 namespace cortex {
 
@@ -41,6 +42,34 @@ public:
     using error::error;
 };
 
+/**
+ * @brief The `system_error` class reports a failed system call together with its `errno` value.
+ */
+class system_error : public error {
+public:
+    /**
+     * @brief Constructor to create a `system_error`.
+     *
+     * @param code The `errno` value.
+     * @param str The description of the failed call.
+     */
+    system_error(int code, const std::string& str)
+        : error(str + ": " + std::generic_category().message(code))
+        , _code(code) {}
+
+    /**
+     * @brief Returns the `errno` value of the failed call.
+     *
+     * @return The error code.
+     */
+    [[nodiscard]] int code() const noexcept {
+        return _code;
+    }
+
+private:
+    int _code;
+};
+
 }; // namespace cortex
 
 #endif
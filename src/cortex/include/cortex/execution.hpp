@@ -3,13 +3,20 @@
 
 #include <cortex/api/flow.hpp>
 #include <cortex/api/suspendable.hpp>
+#include <cortex/cache_line.hpp>
 #include <cortex/error.hpp>
+#include <cortex/local_storage.hpp>
 #include <cortex/machine_context.hpp>
 #include <cortex/stack.hpp>
 
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 #include <memory>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <thread>
 #include <type_traits>
 
 namespace cortex {
@@ -36,9 +43,8 @@ inline static constexpr bool
  * @brief The `suspender` class provides a mechanism for disabling the execution flow of a context.
  */
 struct suspender : public api::suspendable {
-    explicit suspender(machine::transfer_t& t, machine::context_t c)
-        : transfer(t)
-        , caller(c) {}
+    explicit suspender(machine::transfer_t& t)
+        : transfer(t) {}
 
     suspender(const suspender&) = delete;
     suspender(suspender&&) = delete;
@@ -48,14 +54,105 @@ struct suspender : public api::suspendable {
     ~suspender() override = default;
 
     void suspend() override {
-        transfer = machine::jump_to_context(caller, nullptr);
+        // Jump back to whoever resumed us last, which is not necessarily the first resumer.
+        transfer = machine::jump_to_context(transfer.fctx, nullptr);
+    }
+
+    [[noreturn]] void unwind() override {
+        // The entry of the frame catches it and leaves through the context of the last resumer.
+        throw forced_unwind(transfer.fctx);
     }
 
 private:
     machine::transfer_t& transfer;
-    machine::context_t caller;
 };
 
+/**
+ * @brief The `execution_hook` struct is the intrusive link of an execution, for the containers that hold executions
+ * while they are not running: run queues, wait lists, timer buckets. Linking an execution takes no allocation, and the
+ * hook has a cache line of its own at the start of the record, so walking a container touches one line per execution.
+ * The fields have three owners, none of them synchronized:
+ * - `owner` is set once, with the execution;
+ * - `next`, `prev` and `state` belong to whichever container holds the execution at the time;
+ * - `key` and `priority` belong to the scheduler the execution runs on, for its whole lifetime, e.g. the class and
+ *   deadline of `priority_scheduler`. They survive the moves of the execution between containers, so a container must
+ *   not use them.
+ */
+struct alignas(cache_line_size) execution_hook {
+    /// The next execution in the container.
+    execution_hook* next = nullptr;
+    /// The previous execution in the container.
+    execution_hook* prev = nullptr;
+    /// The flow of the execution, e.g. its fiber or coroutine.
+    api::flow* owner = nullptr;
+    /// Ordering key of the scheduler, e.g. a deadline.
+    std::int64_t key = 0;
+    /// State word of the container, e.g. which list the execution is on.
+    std::uint32_t state = 0;
+    /// Priority of the execution in the scheduler.
+    std::uint32_t priority = 0;
+};
+
+static_assert(sizeof(execution_hook) == cache_line_size);
+
+/**
+ * @brief The `execution_record` struct is the part of an execution that the code running on it can reach.
+ * It lives in the frame at the top of the stack, and the record of the running execution is published in a single
+ * thread-local pointer, swapped on every resume and restored on every switch back.
+ * The hook fills the first line, the fields a resume reads and writes fill the second one, and the large, colder
+ * arena and fiber-local table come last, so that prefetching the first two lines covers a resume.
+ */
+struct execution_record {
+    /// The intrusive link of the execution.
+    execution_hook hook;
+    /// The flow of the execution.
+    api::flow* flow = nullptr;
+    /// The suspender the flow runs with, nullptr until the flow has started.
+    api::suspendable* suspender = nullptr;
+    /// Start of the current time slice in `preemption` ticks, zero until `maybe_yield` first checks it after a resume.
+    std::uint64_t slice_start = 0;
+    /// Number of live `migration::thread_affinity_guard`s of the execution.
+    std::size_t pinned = 0;
+    /// The thread the execution must be resumed on while `pinned` is not zero.
+    std::thread::id pinned_thread;
+    /// Arena of the allocations made through `this_coroutine::memory_resource`, created on first use and released at
+    /// once with the record, or when its owner resets it, e.g. `fiber_pool` after each task.
+    std::optional<std::pmr::monotonic_buffer_resource> memory;
+    /// The fiber-local values of the execution.
+    local_storage locals;
+
+    /**
+     * @brief Returns the record of the execution running on the calling thread.
+     * A `CORTEX_TLS_ACCESSOR`, so the thread-local pointer is read again after every suspension, even if the execution
+     * has moved to another thread meanwhile.
+     *
+     * @return The record or nullptr outside of any execution.
+     */
+    [[nodiscard]] static execution_record* current() noexcept;
+
+    /**
+     * @brief Publishes the record of the execution about to run on the calling thread.
+     * @param record The record, nullptr outside of any execution.
+     * @return The previous record, to be restored once the execution is switched out.
+     */
+    static execution_record* exchange_current(execution_record* record) noexcept;
+};
+
+namespace detail {
+
+/**
+ * @brief Switches to a suspended or fresh context with the bookkeeping of a resume: the migration check, a new time
+ * slice and the current record, restored once the context switches back together with the switch count of the watchdog.
+ *
+ * @param context The context to switch to.
+ * @param data The value passed to the context.
+ * @param record The record of the execution owning the context.
+ * @return The transfer the context switched back with.
+ */
+machine::transfer_t resume_context(machine::context_t context, void* data, execution_record& record);
+
+} // namespace detail
+
 /**
  * @brief The `execution` class provides control over the execution flow and context management.
  */
@@ -82,6 +179,7 @@ private:
         stack_allocator_t _allocator;
         stack _stack;
         flow_t _flow;
+        execution_record _record;
     };
 
     /**
@@ -147,6 +245,28 @@ public:
      */
     void resume();
 
+    /**
+     * @brief Resumes the executions of a batch in turn, prefetching the saved context and the record of the next one
+     * while the current one runs, so that a scheduler going through a large runnable set does not take a cache miss on
+     * each switch.
+     *
+     * @param batch The executions, none of them completed.
+     * @rethrows the uncaught exception of an execution, the rest of the batch is not resumed.
+     */
+    static void resume_batch(std::span<execution* const> batch);
+
+    /**
+     * @brief Prefetches the lines the next resume reads first: the registers saved at the stack pointer and the record
+     * at the top of the stack. A hint with no effect on the state of the execution.
+     */
+    void prefetch() const noexcept;
+
+    /**
+     * @brief Returns the intrusive link of the execution, which lives in its frame.
+     * @return The hook, valid until the flow completes.
+     */
+    [[nodiscard]] execution_hook& hook() noexcept;
+
 private:
     template <typename StackAlloc, typename Flow>
     static execution pcreate(StackAlloc&& alloc, Flow flow);
@@ -155,11 +275,14 @@ private:
      * @brief Private constructor for creating an `execution` with the specified machine context.
      *
      * @param context The machine context associated with the execution.
+     * @param record The record in the frame of the execution.
      */
-    explicit execution(machine::context_t context);
+    execution(machine::context_t context, execution_record* record);
 
     /// The machine context associated with the execution.
     machine::context_t _context = nullptr;
+    /// Made current on the resuming thread for as long as the execution runs.
+    execution_record* _record = nullptr;
 };
 
 template <typename StackAlloc, typename Flow>
@@ -174,7 +297,8 @@ void execution::frame<StackAlloc, Flow>::entry(machine::transfer_t transfer) noe
         // jump back to `create_context()`
         transfer = machine::jump_to_context(transfer.fctx, nullptr);
         // start executing
-        suspender s(transfer, transfer.fctx);
+        suspender s(transfer);
+        fr->_record.suspender = &s;
         fr->run(s);
     } catch (const forced_unwind& ex) {
         transfer = {ex.context, nullptr};
@@ -210,7 +334,10 @@ template <typename StackAlloc, typename Flow>
 execution::frame<StackAlloc, Flow>::frame(stack_allocator_t&& alloc, stack st, Flow flow)
     : _allocator(std::move(alloc))
     , _stack(st)
-    , _flow(std::move(flow)) {}
+    , _flow(std::move(flow)) {
+    _record.flow = &*_flow;
+    _record.hook.owner = _record.flow;
+}
 
 template <typename StackAlloc, typename Flow>
 void execution::frame<StackAlloc, Flow>::run(api::suspendable& suspender) {
@@ -220,6 +347,7 @@ void execution::frame<StackAlloc, Flow>::run(api::suspendable& suspender) {
 
 template <typename StackAlloc, typename Flow>
 void execution::frame<StackAlloc, Flow>::destroy() {
+    // The record goes with the frame, and with it every block of the arena at once.
     this->~frame();
     _allocator.deallocate(_stack);
 }
@@ -267,7 +395,7 @@ execution execution::pcreate(StackAlloc&& alloc, Flow flow) {
     const machine::context_t ctx = machine::make_context(stack_top, size, &frame_t::entry);
     assert(nullptr != ctx);
     // transfer control structure to context-stack
-    return execution(machine::jump_to_context(ctx, fr).fctx);
+    return execution(machine::jump_to_context(ctx, fr).fctx, &fr->_record);
 }
 
 } // namespace cortex
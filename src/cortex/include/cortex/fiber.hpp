@@ -0,0 +1,246 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_FIBER_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_FIBER_HPP
+
+#include <cortex/api/flow.hpp>
+#include <cortex/api/scheduler.hpp>
+#include <cortex/api/suspendable.hpp>
+#include <cortex/cancellation.hpp>
+#include <cortex/error.hpp>
+#include <cortex/execution.hpp>
+#include <cortex/stack_allocator.hpp>
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <stop_token>
+
+namespace cortex {
+
+/**
+ * @brief The `fiber` class is a stackful task owned by a scheduler.
+ * Unlike `coroutine`, a fiber is never resumed by user code: it runs on the threads of its scheduler, parks itself
+ * when it has to wait and is handed back to the scheduler by whoever makes it runnable again.
+ */
+class fiber : public api::flow {
+public:
+    /// Type alias for the routine executed by the fiber.
+    using routine_t = std::function<void()>;
+
+    /// Type alias for the hook run by the scheduler once a parked fiber has been switched out.
+    using unlock_t = void (*)(void* arg);
+
+    /**
+     * @brief A wait that `cancel` may cut short, registered by `park` for as long as the fiber is parked. Lives on the
+     * stack of the parked fiber.
+     */
+    struct interruption {
+        /// Unlinks the fiber from what it waits for, under the lock the unlock hook of the park releases, so that it
+        /// is switched out by then. Returns `false` if the fiber was not waiting anymore: whoever took it wakes it up.
+        bool (*unlink)(void* arg) noexcept = nullptr;
+        /// The argument passed to `unlink`.
+        void* arg = nullptr;
+        /// Set once `unlink` took the fiber off its wait, it is then woken by the cancellation and by nobody else.
+        bool interrupted = false;
+    };
+
+    /**
+     * @brief Exception thrown when a fiber-only operation is called outside of a fiber.
+     */
+    struct not_in_fiber : public error {
+        using error::error;
+    };
+
+private:
+    /**
+     * @brief Private constructor for creating a fiber.
+     * @param sched The scheduler owning the fiber.
+     * @param alloc The stack allocator for the fiber.
+     * @param routine The routine to be executed by the fiber.
+     */
+    fiber(api::scheduler& sched, stack_allocator alloc, routine_t&& routine);
+
+public:
+    /**
+     * @brief Creates a new fiber.
+     * @param sched The scheduler owning the fiber.
+     * @param alloc The stack allocator for the fiber.
+     * @param routine The routine to be executed by the fiber.
+     * @return A unique pointer to the created fiber.
+     * @throws invalid_argument_error if the input routine is nullptr.
+     */
+    static std::unique_ptr<fiber> make(api::scheduler& sched, stack_allocator alloc, routine_t routine);
+
+    /**
+     * @brief Returns the fiber running on the calling thread.
+     * @return The current fiber or nullptr if called outside of a fiber.
+     */
+    [[nodiscard]] static fiber* current() noexcept;
+
+    /**
+     * @brief Gives up the processor and lets the scheduler run other fibers first.
+     * @throws not_in_fiber if called outside of a fiber.
+     */
+    static void yield();
+
+    /**
+     * @brief Unwinds the current fiber with `forced_unwind` if its cancellation was requested.
+     * Does nothing outside of a fiber or while the fiber is already unwinding. `fiber::yield` and the fiber-aware waits
+     * (semaphore, condition variable, barrier, wait group, task group join, futures, blocking channel operations,
+     * sleeps, descriptor and ring waits and `offload`) are cancellation points too, they unwind instead of parking.
+     * The condition variable, wait group, task group join, future, channel, sleep and descriptor waits are also cut
+     * short by a cancellation requested while the fiber is parked in them. The others, whose wakers hand something
+     * over to the fiber they wake or run an operation on its behalf, only check before parking.
+     * Mutex locks are not cancellation points, so that critical sections can be entered from destructors.
+     */
+    static void cancellation_point();
+
+    ~fiber() noexcept override = default;
+
+    fiber(const fiber&) = delete;
+    fiber(fiber&&) = delete;
+    fiber& operator=(const fiber&) = delete;
+    fiber& operator=(fiber&&) = delete;
+
+    /**
+     * @brief Runs the fiber until it parks or completes. Only schedulers call this.
+     * If the fiber parked, its unlock hook is run after the switch and the fiber must not be touched afterwards,
+     * because it may already be running on another thread.
+     *
+     * @return `true` if the fiber has completed, `false` if it parked.
+     */
+    [[nodiscard]] bool resume();
+
+    /**
+     * @brief Suspends the current fiber without making it runnable again.
+     * `unlock` is called with `arg` by the resuming thread right after the switch, which is the place to publish the
+     * fiber to a wait list or to release the lock protecting it. Must be called from within this fiber.
+     *
+     * @param unlock The hook to run once the fiber is switched out, may be nullptr.
+     * @param arg The argument passed to the hook.
+     */
+    void park(unlock_t unlock, void* arg);
+
+    /**
+     * @brief Suspends the current fiber like `park`, letting `cancel` cut the wait short.
+     * Once the fiber is back, `wait.interrupted` tells whether it was taken off its wait by a cancellation, in which
+     * case the caller unwinds at a cancellation point once it has cleaned up. A fiber that is already unwinding parks
+     * without the interruption.
+     *
+     * @param unlock The hook to run once the fiber is switched out, may be nullptr.
+     * @param arg The argument passed to the hook.
+     * @param wait The interruption of the wait.
+     */
+    void park(unlock_t unlock, void* arg, interruption& wait);
+
+    /**
+     * @brief Makes a parked fiber runnable again by handing it to its scheduler.
+     */
+    void wake();
+
+    /**
+     * @brief Makes a parked fiber runnable again and asks its scheduler to run it as soon as the current fiber gives
+     * up the processor, on the same thread if possible.
+     */
+    void wake_next();
+
+    /**
+     * @brief Requests the fiber to unwind at its next cancellation point. May be called from any thread.
+     * A fiber parked in an interruptible wait is taken off it and woken up, and unwinds right after the wait.
+     * The stack of the fiber is unwound, so its destructors run and its stack is released right away, and the fiber
+     * completes without an exception. Code that catches `forced_unwind` must rethrow it.
+     */
+    void cancel() noexcept;
+
+    /**
+     * @brief Cancels the fiber once the token is stopped, right away if it already is.
+     * Replaces the previous token. Must be called from within this fiber or before it is scheduled.
+     *
+     * @param token The token.
+     */
+    void cancel_on(std::stop_token token);
+
+    /**
+     * @brief Checks if the cancellation of the fiber was requested.
+     * @return `true` if `cancel` was called or the bound token was stopped.
+     */
+    [[nodiscard]] bool is_cancelled() const noexcept;
+
+    /**
+     * @brief Checks if the fiber has completed.
+     * @return True if the fiber has completed, false otherwise.
+     */
+    [[nodiscard]] bool is_completed() const noexcept;
+
+    /**
+     * @brief Returns the exception the routine finished with, if any.
+     * @return The captured exception or nullptr.
+     */
+    [[nodiscard]] std::exception_ptr exception() const noexcept;
+
+    /**
+     * @brief Returns the scheduler owning the fiber.
+     * @return The owning scheduler.
+     */
+    [[nodiscard]] api::scheduler& scheduler() const noexcept;
+
+    /**
+     * @brief Returns the intrusive link a scheduler may queue the fiber with while it is not running.
+     * @return The link, owned by whichever queue holds the fiber.
+     */
+    [[nodiscard]] fiber*& link() noexcept;
+
+    /**
+     * @brief Prefetches what resuming the fiber reads first, for a scheduler that resumes it next. A hint only.
+     */
+    void prefetch() const noexcept;
+
+    /**
+     * @brief Returns the intrusive link of the fiber's execution, where a scheduler or a primitive may queue the fiber
+     * and keep its per-fiber state, e.g. a priority, without allocating.
+     * @return The hook, valid until the fiber completes.
+     */
+    [[nodiscard]] execution_hook& hook() noexcept;
+
+private:
+    void run(api::suspendable& suspender) override;
+
+    void suspend_self(api::suspendable& suspender) override;
+
+    /**
+     * @brief Cuts the registered wait short, if any. Called on each cancellation request.
+     * @param self The fiber.
+     */
+    static void interrupt(void* self) noexcept;
+
+    /**
+     * @brief Takes the registered wait for an interruption, which keeps it alive until `finish_interruption`.
+     * @return The wait or nullptr if there is none or it is being interrupted already.
+     */
+    interruption* claim_interruption() noexcept;
+
+    /**
+     * @brief Unlinks a claimed wait and wakes the fiber if it was still waiting.
+     * @param wait The wait.
+     */
+    void finish_interruption(interruption& wait) noexcept;
+
+    api::scheduler* _scheduler {nullptr};
+    routine_t _routine;
+    api::suspendable* _suspender {nullptr};
+    unlock_t _unlock {nullptr};
+    void* _unlock_arg {nullptr};
+    fiber* _link {nullptr};
+    /// The interruptible wait of the parked fiber, if any.
+    std::atomic<interruption*> _interruption {nullptr};
+    /// Set by `park` if the cancellation may have missed the wait, which the resuming thread interrupts then.
+    bool _interrupt_on_switch {false};
+    cancellation _cancellation;
+    bool _completed {false};
+    std::exception_ptr _exception;
+    execution _exec;
+};
+
+} // namespace cortex
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_FIBER_BARRIER_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_FIBER_BARRIER_HPP
+
+#include <cortex/spinlock.hpp>
+#include <cortex/wait_queue.hpp>
+
+#include <cstddef>
+
+namespace cortex {
+
+/**
+ * @brief The `fiber_barrier` class is a reusable barrier that parks the arriving fibers until the whole party has
+ * arrived.
+ */
+class fiber_barrier {
+public:
+    /**
+     * @brief Creates a barrier.
+     * @param parties The number of fibers taking part in each phase.
+     * @throws invalid_argument_error if the number of parties is zero.
+     */
+    explicit fiber_barrier(std::size_t parties);
+
+    fiber_barrier(const fiber_barrier&) = delete;
+    fiber_barrier(fiber_barrier&&) = delete;
+    fiber_barrier& operator=(const fiber_barrier&) = delete;
+    fiber_barrier& operator=(fiber_barrier&&) = delete;
+
+    ~fiber_barrier() noexcept = default;
+
+    /**
+     * @brief Arrives at the barrier and parks the current fiber until the phase completes.
+     * @return `true` for exactly one fiber of each phase, the last one to arrive.
+     * @throws fiber::not_in_fiber if the caller is not a fiber and would have to wait.
+     */
+    bool arrive_and_wait();
+
+private:
+    const std::size_t _parties;
+    spinlock _lock;
+    std::size_t _arrived {0};
+    wait_queue _waiters;
+};
+
+} // namespace cortex
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_FIBER_CONDITION_VARIABLE_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_FIBER_CONDITION_VARIABLE_HPP
+
+#include <cortex/fiber_mutex.hpp>
+#include <cortex/spinlock.hpp>
+#include <cortex/timer_service.hpp>
+#include <cortex/wait_queue.hpp>
+
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+
+namespace cortex {
+
+/**
+ * @brief The `fiber_condition_variable` class is a condition variable that parks the current fiber instead of blocking
+ * its thread. It is used together with `fiber_mutex`.
+ */
+class fiber_condition_variable {
+public:
+    fiber_condition_variable() = default;
+
+    fiber_condition_variable(const fiber_condition_variable&) = delete;
+    fiber_condition_variable(fiber_condition_variable&&) = delete;
+    fiber_condition_variable& operator=(const fiber_condition_variable&) = delete;
+    fiber_condition_variable& operator=(fiber_condition_variable&&) = delete;
+
+    ~fiber_condition_variable() noexcept = default;
+
+    /**
+     * @brief Atomically releases the mutex and parks the current fiber until notified, then reacquires the mutex.
+     * @param lock The lock owning the mutex.
+     * @throws fiber::not_in_fiber if called outside of a fiber.
+     */
+    void wait(std::unique_lock<fiber_mutex>& lock);
+
+    /**
+     * @brief Waits until the predicate holds.
+     * @param lock The lock owning the mutex.
+     * @param pred The predicate, checked with the mutex held.
+     * @throws fiber::not_in_fiber if called outside of a fiber.
+     */
+    template <typename Predicate>
+    void wait(std::unique_lock<fiber_mutex>& lock, Predicate pred) {
+        while (!pred()) {
+            wait(lock);
+        }
+    }
+
+    /**
+     * @brief Like `wait`, but gives up once the deadline has passed.
+     * @param lock The lock owning the mutex, held again when the call returns.
+     * @param timers The service running the timeout.
+     * @param deadline The deadline.
+     * @return `std::cv_status::timeout` if the deadline passed before a notification.
+     * @throws fiber::not_in_fiber if called outside of a fiber.
+     */
+    std::cv_status wait_until(std::unique_lock<fiber_mutex>& lock,
+                              timer_service& timers,
+                              timer_service::clock::time_point deadline);
+
+    /**
+     * @brief Waits until the predicate holds or the deadline has passed.
+     * @param lock The lock owning the mutex.
+     * @param timers The service running the timeout.
+     * @param deadline The deadline.
+     * @param pred The predicate, checked with the mutex held.
+     * @return The last value of the predicate.
+     * @throws fiber::not_in_fiber if called outside of a fiber.
+     */
+    template <typename Predicate>
+    bool wait_until(std::unique_lock<fiber_mutex>& lock,
+                    timer_service& timers,
+                    timer_service::clock::time_point deadline,
+                    Predicate pred) {
+        while (!pred()) {
+            if (wait_until(lock, timers, deadline) == std::cv_status::timeout) {
+                return pred();
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Like `wait`, but gives up after the given duration.
+     * @param lock The lock owning the mutex, held again when the call returns.
+     * @param timers The service running the timeout.
+     * @param duration The duration.
+     * @return `std::cv_status::timeout` if the duration elapsed before a notification.
+     * @throws fiber::not_in_fiber if called outside of a fiber.
+     */
+    std::cv_status wait_for(std::unique_lock<fiber_mutex>& lock,
+                            timer_service& timers,
+                            timer_service::clock::duration duration) {
+        return wait_until(lock, timers, timer_service::clock::now() + duration);
+    }
+
+    /**
+     * @brief Waits until the predicate holds or the duration has elapsed.
+     * @param lock The lock owning the mutex.
+     * @param timers The service running the timeout.
+     * @param duration The duration.
+     * @param pred The predicate, checked with the mutex held.
+     * @return The last value of the predicate.
+     * @throws fiber::not_in_fiber if called outside of a fiber.
+     */
+    template <typename Predicate>
+    bool wait_for(std::unique_lock<fiber_mutex>& lock,
+                  timer_service& timers,
+                  timer_service::clock::duration duration,
+                  Predicate pred) {
+        return wait_until(lock, timers, timer_service::clock::now() + duration, std::move(pred));
+    }
+
+    /**
+     * @brief Wakes the oldest waiter, if any.
+     */
+    void notify_one();
+
+    /**
+     * @brief Wakes every waiter.
+     */
+    void notify_all();
+
+private:
+    spinlock _lock;
+    wait_queue _waiters;
+};
+
+} // namespace cortex
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_FIBER_LOCAL_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_FIBER_LOCAL_HPP
+
+#include <cortex/local_storage.hpp>
+
+#include <cstddef>
+
+namespace cortex {
+
+/**
+ * @brief The `fiber_local` class is the per-execution counterpart of `thread_local`.
+ * Every fiber and coroutine sees its own value, created on first access and destroyed when its stack is, no matter
+ * which threads it ran on. Outside of any execution the value belongs to the calling thread. Lookup indexes the table
+ * in the frame of the current execution, it never hashes nor allocates after the first access.
+ * At most `local_storage::capacity` variables may exist in a process, usually as globals or static members.
+ *
+ * @tparam T The value type, default constructible.
+ */
+template <typename T>
+class fiber_local {
+public:
+    /**
+     * @brief Reserves the slot of the variable.
+     * @throws local_storage::no_free_slot if every slot is taken.
+     */
+    fiber_local()
+        : _slot(local_storage::allocate_slot()) {}
+
+    fiber_local(const fiber_local&) = delete;
+    fiber_local(fiber_local&&) = delete;
+    fiber_local& operator=(const fiber_local&) = delete;
+    fiber_local& operator=(fiber_local&&) = delete;
+
+    /**
+     * @brief The values outlive the variable, they are destroyed with their executions.
+     */
+    ~fiber_local() noexcept = default;
+
+    /**
+     * @brief Returns the value of the current execution, default constructed on first access.
+     * Must not be cached across suspension points, the execution may resume on another thread.
+     *
+     * @return The value.
+     */
+    [[nodiscard]] T& get() {
+        local_storage& storage = local_storage::current();
+        if (void* value = storage.get(_slot); value != nullptr) {
+            return *static_cast<T*>(value);
+        }
+
+        T* value = new T();
+        storage.set(_slot, value, [](void* v) noexcept { delete static_cast<T*>(v); });
+        return *value;
+    }
+
+    /**
+     * @brief Checks if the current execution has created its value.
+     * @return `true` if `get` was called in the current execution.
+     */
+    [[nodiscard]] bool has_value() const noexcept {
+        return local_storage::current().get(_slot) != nullptr;
+    }
+
+    T& operator*() {
+        return get();
+    }
+
+    T* operator->() {
+        return &get();
+    }
+
+private:
+    std::size_t _slot;
+};
+
+} // namespace cortex
+
+#endif
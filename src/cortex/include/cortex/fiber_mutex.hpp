@@ -0,0 +1,58 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_FIBER_MUTEX_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_FIBER_MUTEX_HPP
+
+#include <cortex/spinlock.hpp>
+#include <cortex/wait_queue.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace cortex {
+
+/**
+ * @brief The `fiber_mutex` class is a mutex that parks the current fiber instead of blocking its thread.
+ * Locking and unlocking an uncontended mutex is a single atomic operation. On contention the waiters are queued in
+ * FIFO order and the mutex is handed over directly to the oldest one. Meets the Lockable requirements, so it works
+ * with `std::lock_guard` and `std::unique_lock`.
+ */
+class fiber_mutex {
+public:
+    fiber_mutex() = default;
+
+    fiber_mutex(const fiber_mutex&) = delete;
+    fiber_mutex(fiber_mutex&&) = delete;
+    fiber_mutex& operator=(const fiber_mutex&) = delete;
+    fiber_mutex& operator=(fiber_mutex&&) = delete;
+
+    ~fiber_mutex() noexcept = default;
+
+    /**
+     * @brief Acquires the mutex, parking the current fiber while it is owned by another one.
+     * @throws fiber::not_in_fiber if the mutex is contended and the caller is not a fiber.
+     */
+    void lock();
+
+    /**
+     * @brief Tries to acquire the mutex without waiting.
+     * @return `true` if the mutex was acquired.
+     */
+    [[nodiscard]] bool try_lock() noexcept;
+
+    /**
+     * @brief Releases the mutex, handing it over to the oldest waiter if there is one.
+     */
+    void unlock();
+
+private:
+    static constexpr std::uint32_t unlocked = 0;
+    static constexpr std::uint32_t locked = 1;
+    static constexpr std::uint32_t contended = 2;
+
+    std::atomic<std::uint32_t> _state {unlocked};
+    spinlock _lock;
+    wait_queue _waiters;
+};
+
+} // namespace cortex
+
+#endif
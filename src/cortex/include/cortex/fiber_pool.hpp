@@ -0,0 +1,168 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_FIBER_POOL_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_FIBER_POOL_HPP
+
+#include <cortex/api/scheduler.hpp>
+#include <cortex/error.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/spinlock.hpp>
+#include <cortex/wait_queue.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace cortex {
+
+/**
+ * @brief The `fiber_pool` class runs short tasks on long-lived worker fibers of a scheduler.
+ * Spawning a fiber allocates a stack, prepares a context and primes it with a first switch. The workers of the pool
+ * pay this once: between tasks they park on an idle list with their stacks, so spawning a task only queues the
+ * callable and wakes one idle worker. The pool adapts to the load: it starts `options::min_workers` workers, spawns
+ * another one when a task finds none idle, up to `options::max_workers`, and a worker that finds no task exits
+ * rather than parking once `options::max_idle` workers are already idle.
+ * Each task starts with fresh `fiber_local` values and a fresh `this_coroutine::memory_resource` arena, those of the
+ * previous task of the worker are destroyed once it returns.
+ *
+ * The workers are fibers of the scheduler, so a scheduler `wait` for every fiber only returns once the pool is gone.
+ */
+class fiber_pool {
+public:
+    /// Type alias for the tasks run by the workers.
+    using task_t = std::function<void()>;
+
+    /**
+     * @brief Options of the pool.
+     */
+    struct options {
+        /// Workers spawned up front and never released.
+        std::size_t min_workers = 8;
+        /// Maximum number of workers, tasks queue up beyond it.
+        std::size_t max_workers = 1024;
+        /// Maximum number of idle workers kept parked.
+        std::size_t max_idle = 64;
+    };
+
+    /**
+     * @brief Exception thrown when `wait` is called from one of the pool's own workers.
+     */
+    struct wait_from_worker : public error {
+        using error::error;
+    };
+
+private:
+    /**
+     * @brief Private constructor for creating a pool.
+     * @param sched The scheduler running the workers.
+     * @param opts The options.
+     */
+    fiber_pool(api::scheduler& sched, const options& opts);
+
+public:
+    /**
+     * @brief Creates a pool and spawns its first workers.
+     * @param sched The scheduler running the workers, it must outlive the pool.
+     * @param opts The options.
+     * @return A unique pointer to the created pool.
+     * @throws invalid_argument_error if `max_workers` is zero or lower than `min_workers`.
+     */
+    static std::unique_ptr<fiber_pool> create(api::scheduler& sched, const options& opts);
+
+    /**
+     * @brief Creates a pool with the default options and spawns its first workers.
+     * @param sched The scheduler running the workers, it must outlive the pool.
+     * @return A unique pointer to the created pool.
+     */
+    static std::unique_ptr<fiber_pool> create(api::scheduler& sched);
+
+    /**
+     * @brief Waits for the queued tasks to complete, then lets every worker exit.
+     * Must not be called from a worker of the pool. Exceptions that were not collected by `wait` are dropped.
+     */
+    ~fiber_pool() noexcept;
+
+    fiber_pool(const fiber_pool&) = delete;
+    fiber_pool(fiber_pool&&) = delete;
+    fiber_pool& operator=(const fiber_pool&) = delete;
+    fiber_pool& operator=(fiber_pool&&) = delete;
+
+    /**
+     * @brief Queues a task for a worker. May be called from any thread.
+     * If a new worker fails to spawn while another one is running, the task is left to that one.
+     *
+     * @param task The task.
+     * @throws invalid_argument_error if the task is empty.
+     * @rethrows the exception of the scheduler's `spawn` if no running worker is left to take the task, which is not
+     * queued then.
+     */
+    void spawn(task_t task);
+
+    /**
+     * @brief Blocks the calling thread until every queued task has completed.
+     * @rethrows the first exception a task finished with since the last call.
+     * @throws wait_from_worker if called from a worker of this pool.
+     */
+    void wait();
+
+    /**
+     * @brief Returns the number of workers, running or idle.
+     * @return The number of workers.
+     */
+    [[nodiscard]] std::size_t workers() const noexcept;
+
+    /**
+     * @brief Returns the number of idle workers.
+     * @return The number of parked workers.
+     */
+    [[nodiscard]] std::size_t idle() const noexcept;
+
+private:
+    void add_worker();
+
+    /**
+     * @brief Takes a task back after its worker failed to spawn, unless a worker took it or can still take it.
+     * @param ticket The position the task was queued at, counted from the first task ever queued.
+     * @return `true` if the task was taken back.
+     */
+    [[nodiscard]] bool withdraw(std::size_t ticket) noexcept;
+
+    void run_worker();
+
+    /**
+     * @brief Removes the calling worker from the count, with `_lock` held, and signals the last one.
+     */
+    void retire_worker() noexcept;
+
+    void finish_task(std::exception_ptr exception) noexcept;
+
+    [[nodiscard]] bool is_worker() const noexcept;
+
+    api::scheduler& _scheduler;
+    const options _options;
+
+    mutable spinlock _lock;
+    std::deque<task_t> _tasks;
+    wait_queue _idlers;
+    std::size_t _idle {0};
+    std::size_t _workers {0};
+    /// Workers spawned that have not taken the lock yet, counted in `_workers`.
+    std::size_t _starting {0};
+    /// Tasks taken off the queue so far, the ticket of the front task.
+    std::size_t _taken {0};
+    bool _stopping {false};
+
+    std::atomic<std::size_t> _pending {0};
+    std::mutex _done_mutex;
+    std::condition_variable _done_cv;
+    std::exception_ptr _exception;
+    /// Set by the last worker to exit once the pool is stopping.
+    bool _drained {false};
+};
+
+} // namespace cortex
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_FIBER_SEMAPHORE_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_FIBER_SEMAPHORE_HPP
+
+#include <cortex/spinlock.hpp>
+#include <cortex/wait_queue.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace cortex {
+
+/**
+ * @brief The `fiber_semaphore` class is a counting semaphore that parks the current fiber instead of blocking its
+ * thread. Acquiring an available token and releasing a token nobody waits for are single atomic operations.
+ */
+class fiber_semaphore {
+public:
+    /**
+     * @brief Creates a semaphore.
+     * @param initial The number of initially available tokens.
+     */
+    explicit fiber_semaphore(std::ptrdiff_t initial);
+
+    fiber_semaphore(const fiber_semaphore&) = delete;
+    fiber_semaphore(fiber_semaphore&&) = delete;
+    fiber_semaphore& operator=(const fiber_semaphore&) = delete;
+    fiber_semaphore& operator=(fiber_semaphore&&) = delete;
+
+    ~fiber_semaphore() noexcept = default;
+
+    /**
+     * @brief Takes a token, parking the current fiber until one is available.
+     * @throws fiber::not_in_fiber if no token is available and the caller is not a fiber.
+     */
+    void acquire();
+
+    /**
+     * @brief Tries to take a token without waiting.
+     * @return `true` if a token was taken.
+     */
+    [[nodiscard]] bool try_acquire() noexcept;
+
+    /**
+     * @brief Returns tokens, waking up to `update` waiters.
+     * @param update The number of tokens to return.
+     */
+    void release(std::ptrdiff_t update = 1);
+
+private:
+    /// Available tokens when positive, minus the number of waiters when negative.
+    std::atomic<std::ptrdiff_t> _count;
+    spinlock _lock;
+    /// Tokens released for waiters that did not make it to the queue yet.
+    std::ptrdiff_t _pending {0};
+    wait_queue _waiters;
+};
+
+} // namespace cortex
+
+#endif
@@ -0,0 +1,667 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_FUTURE_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_FUTURE_HPP
+
+#include <cortex/error.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/spinlock.hpp>
+#include <cortex/wait_queue.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace cortex {
+
+/**
+ * @brief Exception stored in a future whose promise was destroyed without a result.
+ */
+struct broken_promise : public error {
+    using error::error;
+};
+
+/**
+ * @brief Exception thrown when a promise gets a second result.
+ */
+struct promise_already_satisfied : public error {
+    using error::error;
+};
+
+/**
+ * @brief Exception thrown when the future of a promise is retrieved twice.
+ */
+struct future_already_retrieved : public error {
+    using error::error;
+};
+
+/**
+ * @brief Exception thrown when a future without a shared state is used, e.g. after `get`.
+ */
+struct no_future_state : public error {
+    using error::error;
+};
+
+template <typename T>
+class future;
+
+template <typename T>
+class promise;
+
+namespace detail {
+
+/**
+ * @brief Type-independent part of the state shared by a promise and its future.
+ * Reference counted, so that a promise, a future and the combinators observing it need a single allocation.
+ */
+class future_state_base {
+public:
+    /**
+     * @brief Intrusive callback run once by the thread that completes the state, used by the combinators.
+     */
+    struct observer {
+        void (*notify)(observer& self) = nullptr;
+        observer* next = nullptr;
+    };
+
+    future_state_base(const future_state_base&) = delete;
+    future_state_base(future_state_base&&) = delete;
+    future_state_base& operator=(const future_state_base&) = delete;
+    future_state_base& operator=(future_state_base&&) = delete;
+
+    void retain() noexcept;
+
+    void release() noexcept;
+
+    [[nodiscard]] bool is_ready() const noexcept;
+
+    /**
+     * @brief Parks the current fiber until the state is ready.
+     * @throws fiber::not_in_fiber if the state is not ready and the caller is not a fiber.
+     */
+    void wait();
+
+    /**
+     * @brief Registers an observer.
+     * @return `false` if the state is ready already, the observer is not registered in this case.
+     */
+    bool observe(observer& o);
+
+    /**
+     * @brief Completes the state with an exception.
+     * @throws promise_already_satisfied if the state is completed already.
+     */
+    void set_exception(std::exception_ptr exception);
+
+    /**
+     * @brief Retrieves the future of the state.
+     * @throws future_already_retrieved if it was retrieved already.
+     */
+    void retrieve();
+
+    /**
+     * @brief Rethrows the stored exception, if any. Only valid once the state is ready.
+     */
+    void rethrow_if_failed() const;
+
+protected:
+    future_state_base() = default;
+
+    virtual ~future_state_base() noexcept = default;
+
+    /**
+     * @brief Claims the right to complete the state, the winner stores its result and then calls `publish`.
+     * @throws promise_already_satisfied if the state is claimed already.
+     */
+    void claim();
+
+    /**
+     * @brief Gives up a claim whose result could not be stored, the state can be completed again.
+     */
+    void unclaim() noexcept;
+
+    /**
+     * @brief Makes the stored result visible and wakes the waiters and the observers.
+     */
+    void publish() noexcept;
+
+private:
+    std::atomic<std::size_t> _refs {1};
+    std::atomic<bool> _ready {false};
+    spinlock _lock;
+    bool _claimed {false};
+    bool _retrieved {false};
+    std::exception_ptr _exception;
+    wait_queue _waiters;
+    observer* _observers {nullptr};
+};
+
+template <typename T>
+class future_state : public future_state_base {
+public:
+    using value_t = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+    static future_state* create() {
+        return new future_state();
+    }
+
+    template <typename... Args>
+    void set_value(Args&&... args) {
+        claim();
+        try {
+            _value.emplace(std::forward<Args>(args)...);
+        } catch (...) {
+            unclaim();
+            throw;
+        }
+        publish();
+    }
+
+    /// Only valid once the state is ready and did not fail.
+    value_t& value() noexcept {
+        return *_value;
+    }
+
+protected:
+    future_state() = default;
+
+    ~future_state() noexcept override = default;
+
+private:
+    std::optional<value_t> _value;
+};
+
+/**
+ * @brief Owning handle of a shared state.
+ */
+template <typename T>
+class state_ptr {
+public:
+    state_ptr() = default;
+
+    explicit state_ptr(future_state<T>* state) noexcept
+        : _state(state) {}
+
+    state_ptr(const state_ptr& other) noexcept
+        : _state(other._state) {
+        if (_state != nullptr) {
+            _state->retain();
+        }
+    }
+
+    state_ptr(state_ptr&& other) noexcept
+        : _state(std::exchange(other._state, nullptr)) {}
+
+    state_ptr& operator=(state_ptr other) noexcept {
+        std::swap(_state, other._state);
+        return *this;
+    }
+
+    ~state_ptr() noexcept {
+        if (_state != nullptr) {
+            _state->release();
+        }
+    }
+
+    future_state<T>* get() const noexcept {
+        return _state;
+    }
+
+    future_state<T>* operator->() const noexcept {
+        return _state;
+    }
+
+    explicit operator bool() const noexcept {
+        return _state != nullptr;
+    }
+
+private:
+    future_state<T>* _state {nullptr};
+};
+
+template <typename Result, typename T>
+class combinator_state;
+
+} // namespace detail
+
+template <typename T>
+struct when_any_result;
+
+/**
+ * @brief The `future` class is the receiving end of a `promise`.
+ * Waiting for it parks the current fiber, not the thread. The promise and the future share a single allocation.
+ *
+ * @tparam T The value type, may be void.
+ */
+template <typename T>
+class future {
+public:
+    /**
+     * @brief Creates a future without a shared state.
+     */
+    future() noexcept = default;
+
+    future(const future&) = delete;
+    future(future&&) noexcept = default;
+    future& operator=(const future&) = delete;
+    future& operator=(future&&) noexcept = default;
+
+    ~future() noexcept = default;
+
+    /**
+     * @brief Checks if the future has a shared state, i.e. comes from a promise and `get` was not called yet.
+     * @return `true` if the future is valid.
+     */
+    [[nodiscard]] bool valid() const noexcept;
+
+    /**
+     * @brief Checks if the result is available.
+     * @return `true` if `get` would not park.
+     * @throws no_future_state if the future is not valid.
+     */
+    [[nodiscard]] bool is_ready() const;
+
+    /**
+     * @brief Parks the current fiber until the result is available.
+     * @throws no_future_state if the future is not valid.
+     * @throws fiber::not_in_fiber if the result is not available and the caller is not a fiber.
+     */
+    void wait() const;
+
+    /**
+     * @brief Waits for the result and takes it, the future is not valid afterwards.
+     * @return The value.
+     * @rethrows the exception the promise was completed with, `broken_promise` if it was destroyed without a result.
+     * @throws no_future_state if the future is not valid.
+     * @throws fiber::not_in_fiber if the result is not available and the caller is not a fiber.
+     */
+    T get();
+
+    /**
+     * @brief Awaiter suspending a C++20 coroutine until the future is ready.
+     */
+    class awaiter;
+
+    /**
+     * @brief Makes the future awaitable from a C++20 coroutine, `co_await std::move(f)` yields the result of `get`.
+     * The coroutine is resumed by the thread that completes the promise, right from `set_value` or `set_exception`.
+     *
+     * @return The awaiter, owning the future.
+     */
+    awaiter operator co_await() && noexcept;
+
+private:
+    friend class promise<T>;
+
+    template <typename Result, typename U>
+    friend class detail::combinator_state;
+
+    template <typename U>
+    friend future<std::vector<future<U>>> when_all(std::vector<future<U>> futures);
+
+    template <typename U>
+    friend future<when_any_result<U>> when_any(std::vector<future<U>> futures);
+
+    explicit future(detail::state_ptr<T> state) noexcept
+        : _state(std::move(state)) {}
+
+    void check_state() const;
+
+    detail::state_ptr<T> _state;
+};
+
+/**
+ * @brief The `promise` class is the sending end of a `future`. It may be completed from any thread.
+ * @tparam T The value type, may be void.
+ */
+template <typename T>
+class promise {
+public:
+    /**
+     * @brief Creates a promise and its shared state.
+     */
+    promise();
+
+    promise(const promise&) = delete;
+    promise(promise&&) noexcept = default;
+    promise& operator=(const promise&) = delete;
+    promise& operator=(promise&&) noexcept = default;
+
+    /**
+     * @brief Completes the future with `broken_promise` if no result was set.
+     */
+    ~promise() noexcept;
+
+    /**
+     * @brief Returns the future of the promise.
+     * @return The future.
+     * @throws future_already_retrieved if it was retrieved already.
+     * @throws no_future_state if the promise was moved from.
+     */
+    [[nodiscard]] future<T> get_future();
+
+    /**
+     * @brief Completes the future with a value.
+     * @param args The arguments to construct the value from, none for `promise<void>`.
+     * @throws promise_already_satisfied if a result was set already.
+     * @throws no_future_state if the promise was moved from.
+     */
+    template <typename... Args>
+    void set_value(Args&&... args);
+
+    /**
+     * @brief Completes the future with an exception.
+     * @param exception The exception.
+     * @throws promise_already_satisfied if a result was set already.
+     * @throws no_future_state if the promise was moved from.
+     */
+    void set_exception(std::exception_ptr exception);
+
+private:
+    void check_state() const;
+
+    detail::state_ptr<T> _state;
+    bool _satisfied {false};
+};
+
+/**
+ * @brief Result of `when_any`.
+ */
+template <typename T>
+struct when_any_result {
+    /// Index of the first future that became ready, `npos` if there were no futures.
+    std::size_t index = npos;
+    /// The input futures, in their original order.
+    std::vector<future<T>> futures;
+
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+};
+
+/**
+ * @brief Waits for every future without occupying a fiber.
+ * @param futures The futures, all of them valid.
+ * @return A future completed with the input futures once all of them are ready.
+ * @throws no_future_state if one of the futures is not valid.
+ */
+template <typename T>
+future<std::vector<future<T>>> when_all(std::vector<future<T>> futures);
+
+/**
+ * @brief Waits for the first of the futures without occupying a fiber.
+ * @param futures The futures, all of them valid.
+ * @return A future completed with the index of the first ready future and the input futures.
+ * @throws no_future_state if one of the futures is not valid.
+ */
+template <typename T>
+future<when_any_result<T>> when_any(std::vector<future<T>> futures);
+
+template <typename T>
+bool future<T>::valid() const noexcept {
+    return static_cast<bool>(_state);
+}
+
+template <typename T>
+bool future<T>::is_ready() const {
+    check_state();
+    return _state->is_ready();
+}
+
+template <typename T>
+void future<T>::wait() const {
+    check_state();
+    _state->wait();
+}
+
+template <typename T>
+T future<T>::get() {
+    check_state();
+    const detail::state_ptr<T> state = std::move(_state);
+    state->wait();
+    state->rethrow_if_failed();
+
+    if constexpr (!std::is_void_v<T>) {
+        return std::move(state->value());
+    }
+}
+
+template <typename T>
+class future<T>::awaiter : detail::future_state_base::observer {
+public:
+    explicit awaiter(future&& f) noexcept
+        : _future(std::move(f)) {
+        notify = &resume;
+    }
+
+    /**
+     * @throws no_future_state if the future is not valid.
+     */
+    [[nodiscard]] bool await_ready() const {
+        return _future.is_ready();
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+        _handle = handle;
+        // Not registered if the future became ready in the meantime, the coroutine goes on right away then.
+        return _future._state->observe(*this);
+    }
+
+    T await_resume() {
+        return _future.get();
+    }
+
+private:
+    static void resume(detail::future_state_base::observer& self) {
+        static_cast<awaiter&>(self)._handle.resume();
+    }
+
+    future _future;
+    std::coroutine_handle<> _handle;
+};
+
+template <typename T>
+typename future<T>::awaiter future<T>::operator co_await() && noexcept {
+    return awaiter(std::move(*this));
+}
+
+template <typename T>
+void future<T>::check_state() const {
+    if (!_state) {
+        throw no_future_state("The future has no shared state.");
+    }
+}
+
+template <typename T>
+promise<T>::promise()
+    : _state(detail::future_state<T>::create()) {}
+
+template <typename T>
+promise<T>::~promise() noexcept {
+    if (_state && !_satisfied) {
+        try {
+            _state->set_exception(
+                std::make_exception_ptr(broken_promise("The promise was destroyed without a result.")));
+        } catch (...) {
+            // Satisfied through another handle in the meantime, nothing is broken.
+        }
+    }
+}
+
+template <typename T>
+future<T> promise<T>::get_future() {
+    check_state();
+    _state->retrieve();
+    return future<T>(_state);
+}
+
+template <typename T>
+template <typename... Args>
+void promise<T>::set_value(Args&&... args) {
+    check_state();
+    _state->set_value(std::forward<Args>(args)...);
+    _satisfied = true;
+}
+
+template <typename T>
+void promise<T>::set_exception(std::exception_ptr exception) {
+    check_state();
+    _state->set_exception(std::move(exception));
+    _satisfied = true;
+}
+
+template <typename T>
+void promise<T>::check_state() const {
+    if (!_state) {
+        throw no_future_state("The promise has no shared state.");
+    }
+}
+
+namespace detail {
+
+/**
+ * @brief Shared state of a combinator, completed by the observers it registers on its inputs.
+ * Every registered observer holds a reference, so the state outlives the inputs that are not ready yet.
+ */
+template <typename Result, typename T>
+class combinator_state : public future_state<Result> {
+protected:
+    struct link : future_state_base::observer {
+        combinator_state* owner = nullptr;
+        std::size_t index = 0;
+        /// The state of the input, kept alive by the input future wherever the inputs are moved to.
+        future_state_base* input = nullptr;
+    };
+
+    explicit combinator_state(std::vector<future<T>>&& inputs)
+        : _inputs(std::move(inputs))
+        , _links(_inputs.size()) {}
+
+    ~combinator_state() noexcept override = default;
+
+    /**
+     * @brief Observes every input. The first call to `on_ready` may happen before this returns, on another thread, and
+     * may move the inputs out, so they are only read before the first observer is registered.
+     */
+    void observe_inputs() {
+        for (std::size_t i = 0; i < _links.size(); ++i) {
+            link& l = _links[i];
+            l.notify = &notify;
+            l.owner = this;
+            l.index = i;
+            l.input = _inputs[i]._state.get();
+        }
+
+        for (link& l : _links) {
+            this->retain();
+            if (!l.input->observe(l)) {
+                notify(l);
+            }
+        }
+    }
+
+    /**
+     * @brief Called once per input when it becomes ready, on the thread that completed it.
+     */
+    virtual void on_ready(std::size_t index) noexcept = 0;
+
+    std::vector<future<T>> _inputs;
+
+private:
+    static void notify(future_state_base::observer& o) {
+        auto& l = static_cast<link&>(o);
+        combinator_state* owner = l.owner;
+        owner->on_ready(l.index);
+        owner->release();
+    }
+
+    std::vector<link> _links;
+};
+
+template <typename T>
+class when_all_state final : public combinator_state<std::vector<future<T>>, T> {
+    using base_t = combinator_state<std::vector<future<T>>, T>;
+
+public:
+    static state_ptr<std::vector<future<T>>> create(std::vector<future<T>>&& inputs) {
+        state_ptr<std::vector<future<T>>> state(new when_all_state(std::move(inputs)));
+        auto* self = static_cast<when_all_state*>(state.get());
+        self->observe_inputs();
+        // Drops the count that kept the inputs from completing the state while they were being observed.
+        self->on_ready(0);
+        return state;
+    }
+
+private:
+    explicit when_all_state(std::vector<future<T>>&& inputs)
+        : base_t(std::move(inputs))
+        , _remaining(this->_inputs.size() + 1) {}
+
+    void on_ready([[maybe_unused]] std::size_t index) noexcept override {
+        if (_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            this->set_value(std::move(this->_inputs));
+        }
+    }
+
+    std::atomic<std::size_t> _remaining;
+};
+
+template <typename T>
+class when_any_state final : public combinator_state<when_any_result<T>, T> {
+    using base_t = combinator_state<when_any_result<T>, T>;
+
+public:
+    static state_ptr<when_any_result<T>> create(std::vector<future<T>>&& inputs) {
+        state_ptr<when_any_result<T>> state(new when_any_state(std::move(inputs)));
+        auto* self = static_cast<when_any_state*>(state.get());
+        if (self->_inputs.empty()) {
+            self->set_value();
+        } else {
+            self->observe_inputs();
+        }
+        return state;
+    }
+
+private:
+    explicit when_any_state(std::vector<future<T>>&& inputs)
+        : base_t(std::move(inputs)) {}
+
+    void on_ready(std::size_t index) noexcept override {
+        // Only the first ready input moves the inputs out; once observed, they are reached through the links.
+        if (!_fired.exchange(true, std::memory_order_acq_rel)) {
+            this->set_value(when_any_result<T> {index, std::move(this->_inputs)});
+        }
+    }
+
+    std::atomic<bool> _fired {false};
+};
+
+} // namespace detail
+
+template <typename T>
+future<std::vector<future<T>>> when_all(std::vector<future<T>> futures) {
+    for (const auto& f : futures) {
+        if (!f.valid()) {
+            throw no_future_state("One of the futures has no shared state.");
+        }
+    }
+    return future<std::vector<future<T>>>(detail::when_all_state<T>::create(std::move(futures)));
+}
+
+template <typename T>
+future<when_any_result<T>> when_any(std::vector<future<T>> futures) {
+    for (const auto& f : futures) {
+        if (!f.valid()) {
+            throw no_future_state("One of the futures has no shared state.");
+        }
+    }
+    return future<when_any_result<T>>(detail::when_any_state<T>::create(std::move(futures)));
+}
+
+} // namespace cortex
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_HOOK_LIST_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_HOOK_LIST_HPP
+
+#include <cortex/execution.hpp>
+
+#include <cstddef>
+
+namespace cortex {
+
+/**
+ * @brief The `hook_list` class is an intrusive doubly-linked FIFO of executions, linked through their
+ * `execution_hook`s. Linking never allocates and any execution is unlinked in constant time, e.g. a waiter that timed
+ * out. The list uses `next` and `prev` of the hooks it holds and is not synchronized.
+ */
+class hook_list {
+public:
+    hook_list() = default;
+
+    hook_list(const hook_list&) = delete;
+    hook_list(hook_list&&) = delete;
+    hook_list& operator=(const hook_list&) = delete;
+    hook_list& operator=(hook_list&&) = delete;
+
+    ~hook_list() noexcept = default;
+
+    /**
+     * @brief Links an execution at the back.
+     * @param hook The hook, not linked in any list.
+     */
+    void push_back(execution_hook& hook) noexcept;
+
+    /**
+     * @brief Links an execution at the front.
+     * @param hook The hook, not linked in any list.
+     */
+    void push_front(execution_hook& hook) noexcept;
+
+    /**
+     * @brief Unlinks the execution at the front.
+     * @return The hook or nullptr if the list is empty.
+     */
+    [[nodiscard]] execution_hook* pop_front() noexcept;
+
+    /**
+     * @brief Unlinks an execution.
+     * @param hook The hook, linked in this list.
+     */
+    void remove(execution_hook& hook) noexcept;
+
+    /**
+     * @brief Returns the execution at the front.
+     * @return The hook or nullptr if the list is empty.
+     */
+    [[nodiscard]] execution_hook* front() const noexcept;
+
+    /**
+     * @brief Checks if the list is empty.
+     * @return `true` if no execution is linked.
+     */
+    [[nodiscard]] bool empty() const noexcept;
+
+    /**
+     * @brief Returns the number of linked executions.
+     * @return The size of the list.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+private:
+    execution_hook* _head = nullptr;
+    execution_hook* _tail = nullptr;
+    std::size_t _size = 0;
+};
+
+} // namespace cortex
+
+#endif
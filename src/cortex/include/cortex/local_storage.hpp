@@ -0,0 +1,93 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_LOCAL_STORAGE_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_LOCAL_STORAGE_HPP
+
+#include <cortex/error.hpp>
+
+#include <array>
+#include <cstddef>
+
+namespace cortex {
+
+/**
+ * @brief The `local_storage` class is the table of `fiber_local` values of one execution.
+ * It lives in the frame `execution` places at the top of each stack, so reaching it costs no allocation and no lookup:
+ * every `fiber_local` owns a fixed slot index. Threads have a table of their own for code running outside of any
+ * execution. The values are destroyed together with the table, i.e. when the frame of the execution is destroyed, or
+ * when the owner of the execution clears it, e.g. `fiber_pool` between the tasks of a worker.
+ */
+class local_storage {
+public:
+    /// Maximum number of `fiber_local` variables in a process.
+    static constexpr std::size_t capacity = 32;
+
+    /// Type alias for the function destroying the value of a slot.
+    using destroy_t = void (*)(void* value) noexcept;
+
+    /**
+     * @brief Exception thrown when every slot is taken.
+     */
+    struct no_free_slot : public error {
+        using error::error;
+    };
+
+    local_storage() = default;
+
+    local_storage(const local_storage&) = delete;
+    local_storage(local_storage&&) = delete;
+    local_storage& operator=(const local_storage&) = delete;
+    local_storage& operator=(local_storage&&) = delete;
+
+    /**
+     * @brief Destroys the values, in the reverse order of the slots.
+     */
+    ~local_storage() noexcept;
+
+    /**
+     * @brief Destroys the values, in the reverse order of the slots, leaving every slot empty.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Returns the table of the execution running on the calling thread, or of the thread itself.
+     * @return The current table.
+     */
+    [[nodiscard]] static local_storage& current() noexcept;
+
+    /**
+     * @brief Reserves a slot index for a new `fiber_local`. Slots are never released.
+     * @return The slot index.
+     * @throws no_free_slot if all `capacity` slots are taken.
+     */
+    static std::size_t allocate_slot();
+
+    /**
+     * @brief Returns the value of a slot.
+     * @param slot The slot index.
+     * @return The value or nullptr if it was not created yet.
+     */
+    [[nodiscard]] void* get(std::size_t slot) const noexcept {
+        return _slots[slot].value;
+    }
+
+    /**
+     * @brief Stores the value of an empty slot.
+     * @param slot The slot index.
+     * @param value The value.
+     * @param destroy The function destroying the value together with the table.
+     */
+    void set(std::size_t slot, void* value, destroy_t destroy) noexcept {
+        _slots[slot] = {value, destroy};
+    }
+
+private:
+    struct entry {
+        void* value = nullptr;
+        destroy_t destroy = nullptr;
+    };
+
+    std::array<entry, capacity> _slots {};
+};
+
+} // namespace cortex
+
+#endif
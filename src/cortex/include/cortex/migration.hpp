@@ -0,0 +1,102 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_MIGRATION_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_MIGRATION_HPP
+
+/**
+ * @brief Marks a function that reads thread-local state and must stay out of line.
+ * A compiler assumes a function runs on one thread and may keep the address of a thread-local variable in a register
+ * across any call, including a suspension after which the execution continues on another thread. Reading thread-locals
+ * only through such accessors, which even link-time optimization does not inline, makes every read after a suspension
+ * compute the address again on the right thread. Every accessor of the library is one, e.g. `fiber::current`.
+ * The same goes for functions declared const that read the thread pointer, such as `std::this_thread::get_id`.
+ */
+#if defined(_MSC_VER)
+#define CORTEX_TLS_ACCESSOR __declspec(noinline)
+#else
+#define CORTEX_TLS_ACCESSOR [[gnu::noinline]]
+#endif
+
+/**
+ * @brief Enables the detector of executions that migrate while holding thread-affine state, see
+ * `migration::thread_affinity_guard`. Evaluated when the library is built, on by default in debug builds.
+ */
+#if !defined(CORTEX_MIGRATION_CHECKS)
+#if defined(NDEBUG)
+#define CORTEX_MIGRATION_CHECKS 0
+#else
+#define CORTEX_MIGRATION_CHECKS 1
+#endif
+#endif
+
+#include <thread>
+
+namespace cortex {
+
+struct execution_record;
+
+} // namespace cortex
+
+/**
+ * @brief Support for executions that move between threads: a coroutine may be resumed by any thread and a fiber by
+ * any worker of its scheduler. Code running on an execution must not hold thread-affine state, such as a locked
+ * `std::mutex` or a pointer to a thread-local, across a suspension.
+ */
+namespace cortex::migration {
+
+/// Type alias for the function reporting an execution resumed on another thread while pinned to its thread.
+using violation_handler_t = void (*)(const char* message);
+
+/**
+ * @brief Replaces the function reporting affinity violations. The default prints the message and aborts.
+ * @param handler The new handler, nullptr to restore the default.
+ * @return The previous handler.
+ */
+violation_handler_t set_violation_handler(violation_handler_t handler) noexcept;
+
+/**
+ * @brief Returns the identifier of the calling thread, read again on every call.
+ * Unlike a direct `std::this_thread::get_id`, whose result the compiler may reuse across a suspension, it is safe to
+ * call before and after a suspension to see whether the execution has moved.
+ *
+ * @return The identifier of the calling thread.
+ */
+[[nodiscard]] std::thread::id this_thread_id() noexcept;
+
+/**
+ * @brief Checks if the library was built with the affinity detector.
+ * @return `true` if `CORTEX_MIGRATION_CHECKS` was on.
+ */
+[[nodiscard]] bool checks_enabled() noexcept;
+
+/**
+ * @brief The `thread_affinity_guard` class declares that the current execution holds thread-affine state.
+ * With the detector on, resuming the execution on another thread while a guard is alive is reported. Guards nest and
+ * do nothing outside of an execution.
+ */
+class thread_affinity_guard {
+public:
+    thread_affinity_guard() noexcept;
+
+    ~thread_affinity_guard() noexcept;
+
+    thread_affinity_guard(const thread_affinity_guard&) = delete;
+    thread_affinity_guard(thread_affinity_guard&&) = delete;
+    thread_affinity_guard& operator=(const thread_affinity_guard&) = delete;
+    thread_affinity_guard& operator=(thread_affinity_guard&&) = delete;
+
+private:
+    execution_record* _record;
+};
+
+namespace detail {
+
+/**
+ * @brief Reports a violation if the execution of the record is pinned to another thread than the calling one.
+ * Called by `execution::resume` when the detector is on.
+ */
+void check_resume(const execution_record& record) noexcept;
+
+} // namespace detail
+
+} // namespace cortex::migration
+
+#endif
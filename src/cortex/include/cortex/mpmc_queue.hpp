@@ -0,0 +1,158 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_MPMC_QUEUE_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_MPMC_QUEUE_HPP
+
+#include <cortex/cache_line.hpp>
+#include <cortex/error.hpp>
+#include <cortex/spsc_queue.hpp>
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace cortex {
+
+/**
+ * @brief The `mpmc_queue` class is a bounded lock-free multi-producer multi-consumer ring buffer.
+ * Every slot carries a sequence number telling whether it is ready to be written or read in the current lap, so a
+ * push or a pop is a single CAS on the padded enqueue or dequeue index. Has the same interface as `spsc_queue`.
+ *
+ * @tparam T The item type, must be default constructible and movable.
+ */
+template <typename T>
+class mpmc_queue {
+    struct cell {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+public:
+    /**
+     * @brief Creates an empty queue.
+     * @param capacity The capacity, rounded up to a power of two.
+     * @throws invalid_argument_error if the capacity is zero.
+     */
+    explicit mpmc_queue(std::size_t capacity);
+
+    mpmc_queue(const mpmc_queue&) = delete;
+    mpmc_queue(mpmc_queue&&) = delete;
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+    mpmc_queue& operator=(mpmc_queue&&) = delete;
+
+    ~mpmc_queue() noexcept = default;
+
+    /**
+     * @brief Returns the capacity of the queue.
+     * @return The capacity.
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept;
+
+    /**
+     * @brief Pushes an item. Any thread.
+     * @param item The item to push.
+     * @return `false` if the queue is full, the item is left untouched in this case.
+     */
+    bool try_push(T& item);
+
+    /**
+     * @brief Pops an item. Any thread.
+     * @return The item or an empty optional if the queue is empty.
+     */
+    [[nodiscard]] std::optional<T> try_pop();
+
+    /**
+     * @brief Checks if the queue looks empty.
+     * @return `true` if no item was visible at the time of the call.
+     */
+    [[nodiscard]] bool empty() const noexcept;
+
+private:
+    /// The lap of a position: slots are written in lap `l` when their sequence is `2 * l` and read when it is
+    /// `2 * l + 1`, which keeps a full and an empty slot apart even with a capacity of one.
+    [[nodiscard]] std::size_t lap(std::size_t pos) const noexcept {
+        return pos >> _shift;
+    }
+
+    const std::size_t _mask;
+    const std::size_t _shift;
+    std::unique_ptr<cell[]> _cells;
+
+    alignas(cache_line_size) std::atomic<std::size_t> _enqueue {0};
+    alignas(cache_line_size) std::atomic<std::size_t> _dequeue {0};
+};
+
+template <typename T>
+mpmc_queue<T>::mpmc_queue(std::size_t capacity)
+    : _mask(detail::round_up_to_power_of_two(capacity) - 1)
+    , _shift(static_cast<std::size_t>(std::countr_zero(_mask + 1)))
+    , _cells(std::make_unique<cell[]>(_mask + 1)) {
+    if (capacity == 0) {
+        throw invalid_argument_error("The input capacity is zero.");
+    }
+
+    for (std::size_t i = 0; i <= _mask; ++i) {
+        _cells[i].sequence.store(0, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+std::size_t mpmc_queue<T>::capacity() const noexcept {
+    return _mask + 1;
+}
+
+template <typename T>
+bool mpmc_queue<T>::try_push(T& item) {
+    std::size_t pos = _enqueue.load(std::memory_order_acquire);
+    while (true) {
+        cell& c = _cells[pos & _mask];
+        if (c.sequence.load(std::memory_order_acquire) == 2 * lap(pos)) {
+            if (_enqueue.compare_exchange_strong(pos, pos + 1, std::memory_order_acq_rel)) {
+                c.value = std::move(item);
+                c.sequence.store(2 * lap(pos) + 1, std::memory_order_release);
+                return true;
+            }
+        } else {
+            // Either another producer took the position or the slot still holds the item of the previous lap.
+            const std::size_t prev = pos;
+            pos = _enqueue.load(std::memory_order_acquire);
+            if (pos == prev) {
+                return false;
+            }
+        }
+    }
+}
+
+template <typename T>
+std::optional<T> mpmc_queue<T>::try_pop() {
+    std::size_t pos = _dequeue.load(std::memory_order_acquire);
+    while (true) {
+        cell& c = _cells[pos & _mask];
+        if (c.sequence.load(std::memory_order_acquire) == 2 * lap(pos) + 1) {
+            if (_dequeue.compare_exchange_strong(pos, pos + 1, std::memory_order_acq_rel)) {
+                std::optional<T> item(std::move(c.value));
+                c.value = T {};
+                c.sequence.store(2 * lap(pos) + 2, std::memory_order_release);
+                return item;
+            }
+        } else {
+            // Either another consumer took the position or the slot has not been written in this lap yet.
+            const std::size_t prev = pos;
+            pos = _dequeue.load(std::memory_order_acquire);
+            if (pos == prev) {
+                return std::nullopt;
+            }
+        }
+    }
+}
+
+template <typename T>
+bool mpmc_queue<T>::empty() const noexcept {
+    const std::size_t pos = _dequeue.load(std::memory_order_acquire);
+    return _cells[pos & _mask].sequence.load(std::memory_order_acquire) != 2 * lap(pos) + 1;
+}
+
+} // namespace cortex
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_MPSC_INBOX_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_MPSC_INBOX_HPP
+
+#include <cortex/cache_line.hpp>
+
+#include <atomic>
+
+namespace cortex {
+
+/**
+ * @brief The `mpsc_inbox` class is an unbounded lock-free intrusive multi-producer single-consumer queue.
+ * Producers push onto a shared stack with a single CAS. The consumer detaches the whole stack with one exchange once
+ * its private FIFO runs out and reverses it, so items come out in push order per producer and the shared line is
+ * written only once per batch. The consumer never pops a single item from the shared stack, so there is no ABA.
+ *
+ * @tparam T The item type, must provide `T*& link() noexcept`, which the inbox owns while the item is queued.
+ */
+template <typename T>
+class mpsc_inbox {
+public:
+    mpsc_inbox() = default;
+
+    mpsc_inbox(const mpsc_inbox&) = delete;
+    mpsc_inbox(mpsc_inbox&&) = delete;
+    mpsc_inbox& operator=(const mpsc_inbox&) = delete;
+    mpsc_inbox& operator=(mpsc_inbox&&) = delete;
+
+    /**
+     * @brief Destroys the inbox, the queued items are not owned and left untouched.
+     */
+    ~mpsc_inbox() noexcept = default;
+
+    /**
+     * @brief Pushes an item. Any thread.
+     * @param item The item to push, must not be queued already.
+     * @return `true` if no pushed item was pending, i.e. the consumer may have to be woken up.
+     */
+    bool push(T& item) noexcept {
+        T* head = _head.load(std::memory_order_relaxed);
+        do {
+            item.link() = head;
+        } while (!_head.compare_exchange_weak(head, &item, std::memory_order_release, std::memory_order_relaxed));
+        return head == nullptr;
+    }
+
+    /**
+     * @brief Pops the oldest item. Consumer only.
+     * @return The item or nullptr if the inbox is empty.
+     */
+    [[nodiscard]] T* pop() noexcept {
+        if (_cache == nullptr) {
+            // The plain load keeps the line shared while nothing is pushed.
+            if (_head.load(std::memory_order_relaxed) == nullptr) {
+                return nullptr;
+            }
+
+            T* stack = _head.exchange(nullptr, std::memory_order_acquire);
+            while (stack != nullptr) {
+                T* next = stack->link();
+                stack->link() = _cache;
+                _cache = stack;
+                stack = next;
+            }
+        }
+
+        T* item = _cache;
+        _cache = item->link();
+        item->link() = nullptr;
+        return item;
+    }
+
+    /**
+     * @brief Checks if the inbox is empty. Exact only when called by the consumer.
+     * @return `true` if no item was visible at the time of the call.
+     */
+    [[nodiscard]] bool empty() const noexcept {
+        return _cache == nullptr && _head.load(std::memory_order_acquire) == nullptr;
+    }
+
+private:
+    alignas(cache_line_size) std::atomic<T*> _head {nullptr};
+    /// Detached items in FIFO order, touched by the consumer only.
+    alignas(cache_line_size) T* _cache {nullptr};
+};
+
+} // namespace cortex
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_PARKER_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_PARKER_HPP
+
+#include <cortex/spinlock.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace cortex {
+
+/**
+ * @brief The `parker` class puts one owning thread to sleep until another thread claims its wakeup.
+ * The owner announces itself with `prepare`, re-checks its sleeping condition and then either `wait`s or `cancel`s.
+ * `unpark` issues a system call only if the owner is actually asleep: while it runs, a waker only reads the state,
+ * which keeps the line shared. On Linux the owner sleeps on a private futex, elsewhere on `std::atomic::wait`.
+ *
+ * The pattern relies on a Dekker handshake: a waker publishes its work, issues a sequentially consistent fence and
+ * then calls `unpark`, so either the owner's re-check sees the work or the waker sees the owner parked.
+ */
+class parker {
+public:
+    parker() = default;
+
+    parker(const parker&) = delete;
+    parker(parker&&) = delete;
+    parker& operator=(const parker&) = delete;
+    parker& operator=(parker&&) = delete;
+
+    ~parker() noexcept = default;
+
+    /**
+     * @brief Announces that the owner is about to sleep. Owner only.
+     * Must be followed by a re-check of the sleeping condition and then by either `wait` or `cancel`.
+     */
+    void prepare() noexcept {
+        _state.store(parked, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    /**
+     * @brief Blocks the owner until a waker claims it. Owner only, after `prepare`.
+     */
+    void wait() noexcept;
+
+    /**
+     * @brief Leaves the parked state without sleeping. Owner only, after `prepare` or `wait`.
+     * @return `true` if no waker had claimed the owner in the meantime.
+     */
+    bool cancel() noexcept {
+        return _state.exchange(running, std::memory_order_acquire) == parked;
+    }
+
+    /**
+     * @brief Wakes the owner up if it is parked. Any thread.
+     * @return `true` if this call claimed the owner, only one of concurrent wakers does.
+     */
+    bool unpark() noexcept;
+
+private:
+    static constexpr std::uint32_t running = 0;
+    static constexpr std::uint32_t parked = 1;
+
+    std::atomic<std::uint32_t> _state {running};
+};
+
+/// Number of checks an idle thread spins through in `spin_until` before it parks.
+inline constexpr std::size_t idle_spins = 64;
+
+/**
+ * @brief The spin phase before a `parker` sleeps: checks the condition up to `idle_spins` times.
+ * Work often shows up again within a few microseconds, far less than a futex round trip.
+ *
+ * @param ready The condition, e.g. new work or a stop request.
+ * @return `true` if the condition held, `false` if the caller should park.
+ */
+template <typename Ready>
+bool spin_until(Ready&& ready) {
+    for (std::size_t spin = 0; spin < idle_spins; ++spin) {
+        if (ready()) {
+            return true;
+        }
+        cpu_relax();
+    }
+    return false;
+}
+
+} // namespace cortex
+
+#endif
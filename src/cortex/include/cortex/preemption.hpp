@@ -0,0 +1,97 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_PREEMPTION_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_PREEMPTION_HPP
+
+#include <cortex/error.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace cortex {
+
+/**
+ * @brief Gives up the processor if the current execution has used up its time slice, a cooperative preemption point.
+ * Meant for the hot loops of CPU-heavy code that would otherwise never suspend. The slice starts at the first check
+ * after the execution was resumed; once it is used up, a fiber yields to its scheduler and a coroutine suspends back
+ * to its resumer, which is also a cancellation point. Outside of any execution it does nothing.
+ *
+ * The check reads the time stamp counter where there is one, the steady clock elsewhere, or only a counter bumped by
+ * a `preemption::timer` while one is running, which is the cheapest.
+ */
+void maybe_yield();
+
+} // namespace cortex
+
+/**
+ * @brief Settings of the cooperative preemption of `maybe_yield`.
+ */
+namespace cortex::preemption {
+
+/// Default length of a time slice.
+inline constexpr std::chrono::nanoseconds default_time_slice = std::chrono::milliseconds(2);
+
+/**
+ * @brief Sets the length of the time slices, for every thread.
+ * @param slice The new length.
+ * @throws invalid_argument_error if the length is not positive.
+ */
+void set_time_slice(std::chrono::nanoseconds slice);
+
+/**
+ * @brief Returns the length of the time slices.
+ * @return The length, `default_time_slice` unless it was changed.
+ */
+[[nodiscard]] std::chrono::nanoseconds time_slice() noexcept;
+
+/**
+ * @brief The `timer` class runs a thread that marks the passing of time slices while the object is alive.
+ * `maybe_yield` then only compares a counter instead of reading the clock, at the price of a coarser slice: it ends
+ * between one and one and a half slices after the first check. Only one timer may run at a time.
+ */
+class timer {
+public:
+    /**
+     * @brief Exception thrown when a timer is created while another one is running.
+     */
+    struct already_running : public error {
+        using error::error;
+    };
+
+private:
+    /**
+     * @brief Private constructor for creating a timer.
+     */
+    timer();
+
+public:
+    /**
+     * @brief Starts the timer thread.
+     * @return A unique pointer to the created timer.
+     * @throws already_running if another timer is running.
+     */
+    static std::unique_ptr<timer> create();
+
+    /**
+     * @brief Stops and joins the timer thread, `maybe_yield` reads the clock again.
+     */
+    ~timer() noexcept;
+
+    timer(const timer&) = delete;
+    timer(timer&&) = delete;
+    timer& operator=(const timer&) = delete;
+    timer& operator=(timer&&) = delete;
+
+private:
+    void run();
+
+    std::mutex _mutex;
+    std::condition_variable _stop_cv;
+    bool _stopping {false};
+    std::thread _thread;
+};
+
+} // namespace cortex::preemption
+
+#endif
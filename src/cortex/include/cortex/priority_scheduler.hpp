@@ -0,0 +1,233 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_PRIORITY_SCHEDULER_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_PRIORITY_SCHEDULER_HPP
+
+#include <cortex/api/scheduler.hpp>
+#include <cortex/cache_line.hpp>
+#include <cortex/error.hpp>
+#include <cortex/fiber.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cortex {
+
+/**
+ * @brief Scheduling classes of `priority_scheduler`, from the most to the least urgent.
+ */
+enum class priority_class : std::uint8_t {
+    /// Latency-critical work, e.g. the fibers serving requests.
+    interactive,
+    /// The default class.
+    normal,
+    /// Throughput work soaking up idle time, e.g. compaction.
+    background,
+};
+
+/**
+ * @brief The `priority_scheduler` class runs fibers on a fixed set of worker threads in priority and deadline order.
+ * Runnable fibers wait in one queue per class. A worker always takes from the most urgent class that has a runnable
+ * fiber and, within a class, the fiber with the earliest deadline first; fibers without a deadline come after them in
+ * the order they became runnable. Starvation is bounded: a class that has had runnable fibers without getting a
+ * single dispatch for `options::starvation_limit` gets the next one, whatever is queued in the classes above it.
+ *
+ * The queues are shared by the workers and protected by a mutex, which keeps the order global. Schedulers that favor
+ * throughput over ordering, such as `work_stealing_scheduler`, scale further.
+ */
+class priority_scheduler : public api::scheduler {
+public:
+    /// Type alias for the clock of the deadlines.
+    using clock = std::chrono::steady_clock;
+
+    /// Number of scheduling classes.
+    static constexpr std::size_t classes = 3;
+
+    /// Deadline of the fibers that have none.
+    static constexpr clock::time_point no_deadline = clock::time_point::max();
+
+    /**
+     * @brief Options of the scheduler.
+     */
+    struct options {
+        /// Stack size of the spawned fibers.
+        std::size_t stack_size = 256 * 1024;
+        /// Longest time a class with runnable fibers goes without a dispatch.
+        clock::duration starvation_limit = std::chrono::milliseconds(10);
+    };
+
+    /**
+     * @brief Exception thrown when `wait` is called from one of the scheduler's own fibers.
+     */
+    struct wait_from_worker : public error {
+        using error::error;
+    };
+
+private:
+    /**
+     * @brief Position of a runnable fiber in the queue of its class.
+     */
+    struct entry {
+        clock::time_point deadline;
+        std::uint64_t sequence;
+        fiber* f;
+    };
+
+    /**
+     * @brief Runnable fibers of a class, a binary heap ordered by deadline then sequence.
+     */
+    struct run_queue {
+        std::vector<entry> heap;
+        /// When the class last got a dispatch, or became runnable if that came later.
+        clock::time_point served;
+    };
+
+    /**
+     * @brief Private constructor for creating a scheduler.
+     * @param workers The number of worker threads.
+     * @param opts The options.
+     */
+    priority_scheduler(std::size_t workers, const options& opts);
+
+public:
+    /**
+     * @brief Creates a scheduler and starts its worker threads.
+     * @param workers The number of worker threads.
+     * @param opts The options.
+     * @return A unique pointer to the created scheduler.
+     * @throws invalid_argument_error if the number of workers is zero or the starvation limit is not positive.
+     */
+    static std::unique_ptr<priority_scheduler> create(std::size_t workers, const options& opts);
+
+    /**
+     * @brief Creates a scheduler with the default options and starts its worker threads.
+     * @param workers The number of worker threads.
+     * @return A unique pointer to the created scheduler.
+     * @throws invalid_argument_error if the number of workers is zero.
+     */
+    static std::unique_ptr<priority_scheduler> create(std::size_t workers);
+
+    /**
+     * @brief Returns the scheduler whose worker is the calling thread.
+     * @return The scheduler or nullptr if the calling thread is not a worker.
+     */
+    [[nodiscard]] static priority_scheduler* current() noexcept;
+
+    /**
+     * @brief Moves the current fiber to another class, from its next scheduling on.
+     * @param cls The new class.
+     * @throws fiber::not_in_fiber if not called from a fiber of a priority scheduler.
+     */
+    static void set_priority(priority_class cls);
+
+    /**
+     * @brief Sets the deadline of the current fiber, from its next scheduling on.
+     * @param deadline The new deadline, `no_deadline` to clear it.
+     * @throws fiber::not_in_fiber if not called from a fiber of a priority scheduler.
+     */
+    static void set_deadline(clock::time_point deadline);
+
+    /**
+     * @brief Waits for every fiber to complete, then stops and joins the workers.
+     * Exceptions of the fibers that were not collected by `wait` are dropped.
+     */
+    ~priority_scheduler() noexcept override;
+
+    /**
+     * @brief Spawns a new fiber of the `normal` class without a deadline.
+     * @param routine The routine of the fiber.
+     * @throws invalid_argument_error if the input routine is nullptr.
+     */
+    void spawn(fiber::routine_t routine) override;
+
+    /**
+     * @brief Spawns a new fiber of the given class.
+     * @param cls The class of the fiber.
+     * @param routine The routine of the fiber.
+     * @param deadline The deadline of the fiber.
+     * @throws invalid_argument_error if the input routine is nullptr.
+     */
+    void spawn(priority_class cls, fiber::routine_t routine, clock::time_point deadline = no_deadline);
+
+    /**
+     * @brief Blocks the calling thread until every spawned fiber has completed.
+     * @rethrows the first exception a fiber finished with since the last call.
+     * @throws wait_from_worker if called from a worker thread of this scheduler.
+     */
+    void wait();
+
+    /**
+     * @brief Returns the number of worker threads.
+     * @return The number of workers.
+     */
+    [[nodiscard]] std::size_t workers() const noexcept;
+
+    /**
+     * @brief Returns how many dispatches went to a starving class ahead of more urgent ones.
+     * @return The number of promotions so far.
+     */
+    [[nodiscard]] std::size_t promotions() const noexcept;
+
+    void schedule(fiber& f) override;
+
+    void reschedule(fiber& f) override;
+
+private:
+    void run_worker();
+
+    /**
+     * @brief Takes the next fiber to run, waiting for one if there is none.
+     * @return The fiber or nullptr if the scheduler is stopping.
+     */
+    [[nodiscard]] fiber* take();
+
+    /**
+     * @brief Picks the class to dispatch from. Called with the lock held and at least one runnable fiber.
+     * @param now The current time.
+     * @return The index of the class.
+     */
+    [[nodiscard]] std::size_t pick(clock::time_point now) noexcept;
+
+    void complete(fiber* f) noexcept;
+
+    /**
+     * @brief Returns the class of a fiber, kept in the priority of its hook.
+     * @param f The fiber.
+     * @return The class.
+     */
+    [[nodiscard]] static priority_class class_of(fiber& f) noexcept;
+
+    /**
+     * @brief Returns the deadline of a fiber, kept in the key of its hook.
+     * @param f The fiber.
+     * @return The deadline.
+     */
+    [[nodiscard]] static clock::time_point deadline_of(fiber& f) noexcept;
+
+    const options _options;
+    std::vector<std::thread> _workers;
+
+    std::mutex _mutex;
+    std::condition_variable _ready;
+    std::array<run_queue, classes> _queues;
+    std::size_t _runnable {0};
+    std::uint64_t _sequence {0};
+    bool _stopping {false};
+    std::atomic<std::size_t> _promotions {0};
+
+    alignas(cache_line_size) std::atomic<std::size_t> _live {0};
+    std::mutex _done_mutex;
+    std::condition_variable _done_cv;
+    std::exception_ptr _exception;
+};
+
+} // namespace cortex
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_RANDOM_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_RANDOM_HPP
+
+#include <cstdint>
+
+namespace cortex::detail {
+
+/**
+ * @brief Advances a xorshift64* generator, cheap enough to pick a victim or a case on every call.
+ * @param seed The state of the generator, must not be zero.
+ * @return The next pseudo-random number.
+ */
+inline std::uint64_t next_random(std::uint64_t& seed) noexcept {
+    seed ^= seed >> 12U;
+    seed ^= seed << 25U;
+    seed ^= seed >> 27U;
+    return seed * 0x2545F4914F6CDD1DULL;
+}
+
+} // namespace cortex::detail
+
+#endif
@@ -0,0 +1,176 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_REACTOR_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_REACTOR_HPP
+
+#include <cortex/error.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/spinlock.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+
+namespace cortex {
+
+/**
+ * @brief The `reactor` class parks fibers on file descriptor readiness.
+ * Descriptors are registered once with edge-triggered epoll. An operation first tries the non-blocking system call
+ * and parks the calling fiber only when it would block. A dedicated event loop thread drains the ready events in
+ * batches and hands the waiting fibers back to their schedulers, so the fibers never block their threads.
+ */
+class reactor {
+    /**
+     * @brief Readiness state of a registered descriptor, shared with the event loop.
+     * Freed by the event loop once no batch of events can refer to it anymore.
+     */
+    struct registration {
+        spinlock lock;
+        fiber* reader = nullptr;
+        fiber* writer = nullptr;
+        /// An edge arrived while nobody was waiting.
+        bool readable = false;
+        bool writable = false;
+    };
+
+public:
+    /// Default maximum number of events drained by one `epoll_wait`.
+    static constexpr std::size_t default_max_events = 256;
+
+    /**
+     * @brief A file descriptor registered with a reactor, owns the descriptor.
+     * At most one fiber may read and one fiber may write at a time. Must be destroyed before its reactor.
+     */
+    class descriptor {
+        friend class reactor;
+
+        descriptor(reactor& r, int fd, bool socket, std::unique_ptr<registration> state);
+
+    public:
+        /**
+         * @brief Deregisters and closes the descriptor.
+         */
+        ~descriptor() noexcept;
+
+        descriptor(const descriptor&) = delete;
+        descriptor(descriptor&&) = delete;
+        descriptor& operator=(const descriptor&) = delete;
+        descriptor& operator=(descriptor&&) = delete;
+
+        /**
+         * @brief Returns the underlying file descriptor.
+         * @return The file descriptor.
+         */
+        [[nodiscard]] int fd() const noexcept;
+
+        /**
+         * @brief Reads at most `size` bytes, parking the current fiber until some data is available.
+         * @param buffer The destination buffer.
+         * @param size The size of the buffer.
+         * @return The number of bytes read, zero at the end of the stream.
+         * @throws system_error if the read fails.
+         * @throws fiber::not_in_fiber if the read has to wait outside of a fiber.
+         */
+        std::size_t async_read(void* buffer, std::size_t size);
+
+        /**
+         * @brief Writes the whole buffer, parking the current fiber whenever the descriptor is not writable.
+         * Sockets are written with `MSG_NOSIGNAL`, a closed peer is reported as an error instead of a `SIGPIPE`.
+         *
+         * @param buffer The source buffer.
+         * @param size The size of the buffer.
+         * @throws system_error if a write fails.
+         * @throws fiber::not_in_fiber if the write has to wait outside of a fiber.
+         */
+        void async_write(const void* buffer, std::size_t size);
+
+        /**
+         * @brief Accepts a connection on a listening socket, parking the current fiber until one is pending.
+         * @return The connection, registered with the same reactor.
+         * @throws system_error if the accept fails.
+         * @throws fiber::not_in_fiber if the accept has to wait outside of a fiber.
+         */
+        std::unique_ptr<descriptor> async_accept();
+
+        /**
+         * @brief Connects a socket, parking the current fiber until the connection is established.
+         * @param address The address to connect to.
+         * @param length The length of the address.
+         * @throws system_error if the connection fails.
+         * @throws fiber::not_in_fiber if the connect has to wait outside of a fiber.
+         */
+        void async_connect(const sockaddr* address, socklen_t length);
+
+    private:
+        void wait_readable();
+
+        void wait_writable();
+
+        reactor& _reactor;
+        const int _fd;
+        const bool _socket;
+        std::unique_ptr<registration> _state;
+    };
+
+private:
+    /**
+     * @brief Private constructor for creating a reactor.
+     * @param max_events The maximum number of events drained by one `epoll_wait`.
+     */
+    explicit reactor(std::size_t max_events);
+
+public:
+    /**
+     * @brief Creates a reactor and starts its event loop thread.
+     * @param max_events The maximum number of events drained by one `epoll_wait`.
+     * @return A unique pointer to the created reactor.
+     * @throws invalid_argument_error if `max_events` is zero.
+     * @throws system_error if the epoll instance cannot be created.
+     */
+    static std::unique_ptr<reactor> create(std::size_t max_events = default_max_events);
+
+    /**
+     * @brief Stops and joins the event loop. Every descriptor must have been destroyed.
+     */
+    ~reactor() noexcept;
+
+    reactor(const reactor&) = delete;
+    reactor(reactor&&) = delete;
+    reactor& operator=(const reactor&) = delete;
+    reactor& operator=(reactor&&) = delete;
+
+    /**
+     * @brief Registers a file descriptor, switching it to non-blocking mode.
+     * @param fd The file descriptor, owned by the returned object on success and left to the caller on failure.
+     * @return The registered descriptor.
+     * @throws system_error if the descriptor cannot be registered.
+     */
+    std::unique_ptr<descriptor> attach(int fd);
+
+private:
+    void run();
+
+    void dispatch(registration& state, std::uint32_t events, std::vector<fiber*>& ready) noexcept;
+
+    void retire(std::unique_ptr<registration> state);
+
+    void release_retired() noexcept;
+
+    const std::size_t _max_events;
+    int _epoll {-1};
+    /// eventfd used to stop the event loop.
+    int _wakeup {-1};
+    std::atomic<bool> _stopping {false};
+    std::thread _thread;
+
+    std::mutex _retired_mutex;
+    std::vector<std::unique_ptr<registration>> _retired;
+};
+
+} // namespace cortex
+
+#endif
@@ -0,0 +1,202 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_SEGMENTED_QUEUE_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_SEGMENTED_QUEUE_HPP
+
+#include <cortex/error.hpp>
+#include <cortex/spinlock.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace cortex {
+
+/**
+ * @brief The `segmented_queue` class is an unbounded multi-producer multi-consumer queue made of fixed-size segments.
+ * Items are written into the tail segment and a new one is linked once it is full, the head segment is kept as a spare
+ * once it is drained, so a queue that does not keep growing stops allocating. Has the same interface as `mpmc_queue`,
+ * except that a push never fails.
+ *
+ * Pushes and pops are serialized by a spinlock held for a move and an index update: a lock-free version would need a
+ * memory reclamation scheme for the drained segments, which other threads may still be reading.
+ *
+ * @tparam T The item type, must be default constructible and movable.
+ */
+template <typename T>
+class segmented_queue {
+    struct segment {
+        explicit segment(std::size_t size)
+            : slots(std::make_unique<T[]>(size)) {}
+
+        std::unique_ptr<T[]> slots;
+        segment* next = nullptr;
+    };
+
+public:
+    /// Tells `channel` that the queue never fills up.
+    static constexpr bool unbounded = true;
+
+    /// Size of the segments of a default constructed queue.
+    static constexpr std::size_t default_segment_size = 64;
+
+    /**
+     * @brief Creates an empty queue.
+     * @param segment_size The number of items of a segment.
+     * @throws invalid_argument_error if the segment size is zero.
+     */
+    explicit segmented_queue(std::size_t segment_size = default_segment_size);
+
+    segmented_queue(const segmented_queue&) = delete;
+    segmented_queue(segmented_queue&&) = delete;
+    segmented_queue& operator=(const segmented_queue&) = delete;
+    segmented_queue& operator=(segmented_queue&&) = delete;
+
+    /**
+     * @brief Destroys the queue and the items left in it.
+     */
+    ~segmented_queue() noexcept;
+
+    /**
+     * @brief Returns the capacity of the queue.
+     * @return The largest `std::size_t`, the queue is only bounded by memory.
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept;
+
+    /**
+     * @brief Returns the number of items of a segment.
+     * @return The segment size.
+     */
+    [[nodiscard]] std::size_t segment_size() const noexcept;
+
+    /**
+     * @brief Pushes an item. Any thread.
+     * @param item The item to push.
+     * @return `true`, the queue is never full.
+     * @throws std::bad_alloc if a new segment cannot be allocated, the item is left untouched in this case.
+     */
+    bool try_push(T& item);
+
+    /**
+     * @brief Pops an item. Any thread.
+     * @return The item or an empty optional if the queue is empty.
+     */
+    [[nodiscard]] std::optional<T> try_pop();
+
+    /**
+     * @brief Checks if the queue looks empty.
+     * @return `true` if no item was queued at the time of the call.
+     */
+    [[nodiscard]] bool empty() const noexcept;
+
+private:
+    /// The lock is held.
+    [[nodiscard]] bool empty_locked() const noexcept {
+        return _head == _tail && _head_index == _tail_index;
+    }
+
+    const std::size_t _segment_size;
+    mutable spinlock _lock;
+    segment* _head;
+    segment* _tail;
+    /// The next slot to read in the head segment.
+    std::size_t _head_index = 0;
+    /// The next slot to write in the tail segment.
+    std::size_t _tail_index = 0;
+    /// The last drained segment, reused before allocating a new one.
+    segment* _spare = nullptr;
+};
+
+template <typename T>
+segmented_queue<T>::segmented_queue(std::size_t segment_size)
+    : _segment_size(segment_size) {
+    if (segment_size == 0) {
+        throw invalid_argument_error("The input segment size is zero.");
+    }
+
+    _head = new segment(segment_size);
+    _tail = _head;
+}
+
+template <typename T>
+segmented_queue<T>::~segmented_queue() noexcept {
+    segment* s = _head;
+    while (s != nullptr) {
+        delete std::exchange(s, s->next);
+    }
+    delete _spare;
+}
+
+template <typename T>
+std::size_t segmented_queue<T>::capacity() const noexcept {
+    return std::numeric_limits<std::size_t>::max();
+}
+
+template <typename T>
+std::size_t segmented_queue<T>::segment_size() const noexcept {
+    return _segment_size;
+}
+
+template <typename T>
+bool segmented_queue<T>::try_push(T& item) {
+    std::lock_guard guard(_lock);
+    if (_tail_index == _segment_size) {
+        segment* s = std::exchange(_spare, nullptr);
+        if (s == nullptr) {
+            s = new segment(_segment_size);
+        }
+        _tail->next = s;
+        _tail = s;
+        _tail_index = 0;
+    }
+
+    _tail->slots[_tail_index] = std::move(item);
+    ++_tail_index;
+    return true;
+}
+
+template <typename T>
+std::optional<T> segmented_queue<T>::try_pop() {
+    segment* drained = nullptr;
+    std::optional<T> item;
+    {
+        std::lock_guard guard(_lock);
+        if (_head_index == _segment_size && _head != _tail) {
+            drained = std::exchange(_head, _head->next);
+            drained->next = nullptr;
+            _head_index = 0;
+            if (_spare == nullptr) {
+                _spare = std::exchange(drained, nullptr);
+            }
+        }
+
+        if (empty_locked()) {
+            return item;
+        }
+
+        T& slot = _head->slots[_head_index];
+        item.emplace(std::move(slot));
+        slot = T {};
+        ++_head_index;
+
+        if (empty_locked()) {
+            // Drained: writing starts over at the front of the same segment.
+            _head_index = 0;
+            _tail_index = 0;
+        }
+    }
+    // A second drained segment while one is spare, freed outside of the lock.
+    delete drained;
+    return item;
+}
+
+template <typename T>
+bool segmented_queue<T>::empty() const noexcept {
+    std::lock_guard guard(_lock);
+    return empty_locked();
+}
+
+} // namespace cortex
+
+#endif
@@ -0,0 +1,382 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_SENDERS_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_SENDERS_HPP
+
+#include <cortex/api/scheduler.hpp>
+#include <cortex/execution.hpp>
+#include <cortex/fiber.hpp>
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+/**
+ * @brief A self-contained subset of P2300 senders and receivers on top of cortex fibers.
+ * A sender describes work, `connect` binds it to a receiver and yields an operation state, and `start` launches it.
+ * The operation completes by calling exactly one of `set_value`, `set_error` or `set_stopped` on the receiver.
+ * Senders produce at most one value, whose type is `value_type` (void for none).
+ */
+namespace cortex::senders {
+
+/**
+ * @brief A sender: something that names its `value_type` and can be connected to a receiver.
+ */
+template <typename S>
+concept sender = requires { typename std::remove_cvref_t<S>::value_type; };
+
+/**
+ * @brief Base of the pipeable adaptors, `sndr | adaptor` is `adaptor(sndr)`.
+ */
+struct adaptor_closure {};
+
+template <sender S, typename Closure>
+    requires std::is_base_of_v<adaptor_closure, std::remove_cvref_t<Closure>>
+auto operator|(S&& sndr, Closure&& closure) {
+    return std::forward<Closure>(closure)(std::forward<S>(sndr));
+}
+
+/**
+ * @brief Sender completing with a value right away, on the thread that starts it.
+ */
+template <typename T>
+class just_sender {
+public:
+    using value_type = T;
+
+    explicit just_sender(T value)
+        : _value(std::move(value)) {}
+
+    template <typename R>
+    struct operation {
+        T value;
+        R receiver;
+
+        void start() noexcept {
+            receiver.set_value(std::move(value));
+        }
+    };
+
+    template <typename R>
+    operation<R> connect(R receiver) && {
+        return operation<R> {std::move(_value), std::move(receiver)};
+    }
+
+private:
+    T _value;
+};
+
+template <>
+class just_sender<void> {
+public:
+    using value_type = void;
+
+    template <typename R>
+    struct operation {
+        R receiver;
+
+        void start() noexcept {
+            receiver.set_value();
+        }
+    };
+
+    template <typename R>
+    operation<R> connect(R receiver) && {
+        return operation<R> {std::move(receiver)};
+    }
+};
+
+/**
+ * @brief Creates a sender completing with the value.
+ * @param value The value.
+ * @return The sender.
+ */
+template <typename T>
+just_sender<std::decay_t<T>> just(T&& value) {
+    return just_sender<std::decay_t<T>>(std::forward<T>(value));
+}
+
+/**
+ * @brief Creates a sender completing without a value.
+ * @return The sender.
+ */
+inline just_sender<void> just() noexcept {
+    return {};
+}
+
+/**
+ * @brief Sender completing on a new fiber of a scheduler, returned by `fiber_scheduler::schedule`.
+ */
+class schedule_sender {
+public:
+    using value_type = void;
+
+    explicit schedule_sender(api::scheduler& sched) noexcept
+        : _scheduler(&sched) {}
+
+    template <typename R>
+    class operation {
+    public:
+        operation(api::scheduler& sched, R receiver)
+            : _scheduler(sched)
+            , _receiver(std::move(receiver)) {}
+
+        operation(const operation&) = delete;
+        operation(operation&&) = delete;
+        operation& operator=(const operation&) = delete;
+        operation& operator=(operation&&) = delete;
+
+        ~operation() noexcept = default;
+
+        void start() noexcept {
+            try {
+                _scheduler.spawn([this] { _receiver.set_value(); });
+            } catch (...) {
+                _receiver.set_error(std::current_exception());
+            }
+        }
+
+    private:
+        api::scheduler& _scheduler;
+        R _receiver;
+    };
+
+    template <typename R>
+    operation<R> connect(R receiver) const {
+        return operation<R>(*_scheduler, std::move(receiver));
+    }
+
+private:
+    api::scheduler* _scheduler;
+};
+
+/**
+ * @brief The `fiber_scheduler` class exposes a cortex scheduler as a P2300 scheduler.
+ * Work attached to `schedule()` runs on a fiber, so it may park on any cortex primitive.
+ */
+class fiber_scheduler {
+public:
+    /**
+     * @brief Creates a handle of the scheduler, which must outlive the handle and its senders.
+     * @param sched The scheduler.
+     */
+    explicit fiber_scheduler(api::scheduler& sched) noexcept
+        : _scheduler(&sched) {}
+
+    /**
+     * @brief Returns a sender completing on a new fiber of the scheduler.
+     * @return The sender.
+     */
+    [[nodiscard]] schedule_sender schedule() const noexcept {
+        return schedule_sender(*_scheduler);
+    }
+
+    bool operator==(const fiber_scheduler& other) const noexcept = default;
+
+private:
+    api::scheduler* _scheduler;
+};
+
+namespace detail {
+
+template <typename F, typename T>
+struct then_result {
+    using type = std::invoke_result_t<F&, T>;
+};
+
+template <typename F>
+struct then_result<F, void> {
+    using type = std::invoke_result_t<F&>;
+};
+
+} // namespace detail
+
+/**
+ * @brief Sender transforming the value of another sender, returned by `then`.
+ */
+template <typename S, typename F>
+class then_sender {
+public:
+    using value_type = typename detail::then_result<F, typename S::value_type>::type;
+
+    then_sender(S sndr, F fn)
+        : _sender(std::move(sndr))
+        , _fn(std::move(fn)) {}
+
+    template <typename R>
+    struct receiver {
+        F fn;
+        R next;
+
+        /// Not noexcept: a fiber unwinding through `fn` reports `set_stopped` and keeps unwinding.
+        template <typename... Args>
+        void set_value(Args&&... args) {
+            std::optional<std::conditional_t<std::is_void_v<value_type>, std::monostate, value_type>> result;
+            try {
+                if constexpr (std::is_void_v<value_type>) {
+                    std::invoke(fn, std::forward<Args>(args)...);
+                    result.emplace();
+                } else {
+                    result.emplace(std::invoke(fn, std::forward<Args>(args)...));
+                }
+            } catch (const forced_unwind&) {
+                next.set_stopped();
+                throw;
+            } catch (...) {
+                next.set_error(std::current_exception());
+                return;
+            }
+
+            // Outside of the try block, the downstream receivers complete on their own.
+            if constexpr (std::is_void_v<value_type>) {
+                next.set_value();
+            } else {
+                next.set_value(std::move(*result));
+            }
+        }
+
+        void set_error(std::exception_ptr error) noexcept {
+            next.set_error(std::move(error));
+        }
+
+        void set_stopped() noexcept {
+            next.set_stopped();
+        }
+    };
+
+    template <typename R>
+    auto connect(R next) && {
+        return std::move(_sender).connect(receiver<R> {std::move(_fn), std::move(next)});
+    }
+
+private:
+    S _sender;
+    F _fn;
+};
+
+template <typename F>
+struct then_closure : adaptor_closure {
+    F fn;
+
+    template <sender S>
+    then_sender<std::remove_cvref_t<S>, F> operator()(S&& sndr) && {
+        return then_sender<std::remove_cvref_t<S>, F>(std::forward<S>(sndr), std::move(fn));
+    }
+};
+
+/**
+ * @brief Creates a sender invoking the function with the value of another sender and completing with its result.
+ * An exception thrown by the function completes the sender with `set_error`.
+ *
+ * @param sndr The sender.
+ * @param fn The function.
+ * @return The sender.
+ */
+template <sender S, typename F>
+then_sender<std::remove_cvref_t<S>, std::decay_t<F>> then(S&& sndr, F&& fn) {
+    return then_sender<std::remove_cvref_t<S>, std::decay_t<F>>(std::forward<S>(sndr), std::forward<F>(fn));
+}
+
+/**
+ * @brief Creates the pipeable form of `then`, as in `sched.schedule() | then(fn)`.
+ * @param fn The function.
+ * @return The adaptor.
+ */
+template <typename F>
+then_closure<std::decay_t<F>> then(F&& fn) {
+    return then_closure<std::decay_t<F>> {{}, std::forward<F>(fn)};
+}
+
+namespace detail {
+
+template <typename T>
+struct sync_wait_state {
+    using value_t = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+    std::optional<value_t> value;
+    std::exception_ptr error;
+    /// The parked fiber, nullptr if a plain thread waits.
+    fiber* owner = nullptr;
+    std::mutex mutex;
+    std::condition_variable ready;
+    bool done = false;
+
+    void complete() noexcept {
+        if (owner != nullptr) {
+            // The state lives on the stack of the fiber and may be gone once it is woken up.
+            owner->wake();
+            return;
+        }
+
+        // Notified under the lock, the waiter cannot leave and destroy the state before the notification is done.
+        const std::lock_guard lock(mutex);
+        done = true;
+        ready.notify_one();
+    }
+};
+
+template <typename T>
+struct sync_wait_receiver {
+    sync_wait_state<T>* state;
+
+    template <typename... Args>
+    void set_value(Args&&... args) noexcept {
+        try {
+            state->value.emplace(std::forward<Args>(args)...);
+        } catch (...) {
+            state->error = std::current_exception();
+        }
+        state->complete();
+    }
+
+    void set_error(std::exception_ptr error) noexcept {
+        state->error = std::move(error);
+        state->complete();
+    }
+
+    void set_stopped() noexcept {
+        state->complete();
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Starts the sender and waits for its completion.
+ * In a fiber, the fiber parks and the operation is started once it is switched out, so the thread keeps running
+ * other fibers. Outside of a fiber, the calling thread blocks. Waiting in a fiber is a cancellation point.
+ *
+ * @param sndr The sender.
+ * @return The value of the sender, `std::monostate` for a void sender, or nullopt if it completed with `set_stopped`.
+ * @rethrows the error the sender completed with.
+ */
+template <sender S>
+auto sync_wait(S&& sndr) {
+    using value_type = typename std::remove_cvref_t<S>::value_type;
+
+    fiber::cancellation_point();
+
+    detail::sync_wait_state<value_type> state;
+    state.owner = fiber::current();
+    auto op = std::forward<S>(sndr).connect(detail::sync_wait_receiver<value_type> {&state});
+
+    if (state.owner != nullptr) {
+        state.owner->park([](void* arg) { static_cast<decltype(op)*>(arg)->start(); }, &op);
+    } else {
+        op.start();
+        std::unique_lock lock(state.mutex);
+        state.ready.wait(lock, [&state] { return state.done; });
+    }
+
+    if (state.error != nullptr) {
+        std::rethrow_exception(state.error);
+    }
+    return std::move(state.value);
+}
+
+} // namespace cortex::senders
+
+#endif
@@ -0,0 +1,226 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_SHARDED_RUNTIME_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_SHARDED_RUNTIME_HPP
+
+#include <cortex/api/scheduler.hpp>
+#include <cortex/cache_line.hpp>
+#include <cortex/error.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/mpsc_inbox.hpp>
+#include <cortex/parker.hpp>
+#include <cortex/spsc_queue.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cortex {
+
+/**
+ * @brief The `sharded_runtime` class is a shared-nothing thread-per-core runtime.
+ * Every shard is a thread, optionally pinned to a core, running its own fiber loop. Fibers never leave their shard;
+ * shards only talk to each other through one lock-free SPSC queue per ordered pair of shards. Submissions made on a
+ * shard are buffered and flushed once per loop iteration, and the target is woken up only if it is parked.
+ */
+class sharded_runtime {
+public:
+    /// Type alias for the tasks submitted to the shards, each one runs in its own fiber.
+    using task_t = std::function<void()>;
+
+    /**
+     * @brief Options of the runtime.
+     */
+    struct options {
+        /// Capacity of every cross-shard queue.
+        std::size_t queue_capacity = 1024;
+        /// Stack size of the fibers.
+        std::size_t stack_size = 256 * 1024;
+        /// Pin shard `i` to core `i % hardware_concurrency`.
+        bool pin_threads = true;
+    };
+
+    /**
+     * @brief Exception thrown when a shard-only operation is called outside of a shard.
+     */
+    struct not_on_shard : public error {
+        using error::error;
+    };
+
+    /**
+     * @brief Exception thrown when `wait` is called from one of the runtime's own shards.
+     */
+    struct wait_from_shard : public error {
+        using error::error;
+    };
+
+private:
+    /**
+     * @brief Per-thread state of the runtime.
+     */
+    class alignas(cache_line_size) shard : public api::scheduler {
+    public:
+        shard(sharded_runtime& runtime, std::size_t index, std::size_t shards);
+
+        ~shard() noexcept override = default;
+
+        void spawn(task_t routine) override;
+
+        void schedule(fiber& f) override;
+
+        void reschedule(fiber& f) override;
+
+        void schedule_next(fiber& f) override;
+
+        sharded_runtime& runtime;
+        const std::size_t index;
+        std::thread thread;
+
+        /// Runnable fibers, touched by the shard thread only.
+        std::deque<fiber*> run_queue;
+        /// Not yet flushed submissions to every other shard, touched by the shard thread only.
+        std::vector<std::vector<task_t>> outboxes;
+
+        /// Where the shard sleeps when there is nothing to run.
+        alignas(cache_line_size) parker parking;
+
+        /// Fibers woken up by other threads.
+        mpsc_inbox<fiber> remote_fibers;
+
+        /// Tasks submitted by threads that are not shards of this runtime.
+        alignas(cache_line_size) std::atomic<bool> remote_pending {false};
+        std::mutex remote_mutex;
+        std::vector<task_t> remote_tasks;
+    };
+
+    /**
+     * @brief Private constructor for creating a runtime.
+     * @param shards The number of shards.
+     * @param opts The options of the runtime.
+     */
+    sharded_runtime(std::size_t shards, const options& opts);
+
+public:
+    /**
+     * @brief Creates a runtime and starts its shards.
+     * @param shards The number of shards.
+     * @param opts The options of the runtime.
+     * @return A unique pointer to the created runtime.
+     * @throws invalid_argument_error if the number of shards or the queue capacity is zero.
+     */
+    static std::unique_ptr<sharded_runtime> create(std::size_t shards, const options& opts);
+
+    /**
+     * @brief Creates a runtime with the default options and starts its shards.
+     * @param shards The number of shards.
+     * @return A unique pointer to the created runtime.
+     * @throws invalid_argument_error if the number of shards is zero.
+     */
+    static std::unique_ptr<sharded_runtime> create(std::size_t shards);
+
+    /**
+     * @brief Returns the runtime whose shard is the calling thread.
+     * @return The runtime or nullptr if the calling thread is not a shard.
+     */
+    [[nodiscard]] static sharded_runtime* current() noexcept;
+
+    /**
+     * @brief Returns the index of the shard running on the calling thread.
+     * @return The shard index.
+     * @throws not_on_shard if the calling thread is not a shard.
+     */
+    [[nodiscard]] static std::size_t current_shard();
+
+    /**
+     * @brief Waits for every task to complete, then stops and joins the shards.
+     * Exceptions of the tasks that were not collected by `wait` are dropped.
+     */
+    ~sharded_runtime() noexcept;
+
+    sharded_runtime(const sharded_runtime&) = delete;
+    sharded_runtime(sharded_runtime&&) = delete;
+    sharded_runtime& operator=(const sharded_runtime&) = delete;
+    sharded_runtime& operator=(sharded_runtime&&) = delete;
+
+    /**
+     * @brief Returns the number of shards.
+     * @return The number of shards.
+     */
+    [[nodiscard]] std::size_t shards() const noexcept;
+
+    /**
+     * @brief Runs the task in a new fiber on the target shard.
+     * From a shard, the task is buffered and enqueued together with the other submissions of the same loop iteration.
+     * From any other thread, it is handed over under a lock.
+     *
+     * @param target The index of the target shard.
+     * @param task The task to run.
+     * @throws invalid_argument_error if the target is out of range or the task is nullptr.
+     */
+    void submit(std::size_t target, task_t task);
+
+    /**
+     * @brief Blocks the calling thread until every submitted task has completed.
+     * @rethrows the first exception a task finished with since the last call.
+     * @throws wait_from_shard if called from a shard of this runtime.
+     */
+    void wait();
+
+private:
+    void run_shard(shard& s);
+
+    /**
+     * @brief Turns the incoming messages into runnable fibers.
+     * @return `true` if anything was received.
+     */
+    bool receive(shard& s);
+
+    void run_ready(shard& s);
+
+    /**
+     * @brief Moves the outboxes into the cross-shard queues.
+     * @return `true` if every outbox could be emptied.
+     */
+    bool flush(shard& s);
+
+    [[nodiscard]] bool has_incoming(shard& s);
+
+    /**
+     * @brief Spins for a while, then puts the shard to sleep until new work arrives.
+     * @return `false` if the runtime is stopping.
+     */
+    bool park(shard& s);
+
+    void wake(shard& s);
+
+    void push_remote(shard& s, task_t task);
+
+    void push_remote(shard& s, fiber& f);
+
+    void spawn_local(shard& s, task_t task);
+
+    void complete(fiber* f) noexcept;
+
+    [[nodiscard]] spsc_queue<task_t>& channel(std::size_t from, std::size_t to) noexcept;
+
+    const options _options;
+    std::vector<std::unique_ptr<shard>> _shards;
+    /// `_channels[from * shards + to]`, the diagonal is unused.
+    std::vector<std::unique_ptr<spsc_queue<task_t>>> _channels;
+    std::atomic<bool> _stopping {false};
+
+    alignas(cache_line_size) std::atomic<std::size_t> _live {0};
+    std::mutex _done_mutex;
+    std::condition_variable _done_cv;
+    std::exception_ptr _exception;
+};
+
+} // namespace cortex
+
+#endif
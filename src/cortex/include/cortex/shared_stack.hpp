@@ -0,0 +1,203 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_SHARED_STACK_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_SHARED_STACK_HPP
+
+#include <cortex/api/flow.hpp>
+#include <cortex/error.hpp>
+#include <cortex/execution.hpp>
+#include <cortex/machine_context.hpp>
+#include <cortex/stack.hpp>
+#include <cortex/stack_allocator.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <memory>
+
+namespace cortex {
+
+class shared_execution;
+
+/**
+ * @brief The `shared_stack` class is one large stack that many `shared_execution`s run on in turn.
+ * Only one of them, the occupant, has its frames on the stack at a time. When another one is resumed, the used part of
+ * the occupant, from its saved stack pointer up to the top, is copied out to a heap buffer of the same size, and the
+ * saved part of the resumed one is copied back in, at the same addresses.
+ *
+ * The stack is not thread-safe: its executions may move between threads, but only one thread at a time may resume
+ * them, e.g. a stack per worker thread.
+ */
+class shared_stack {
+    friend class shared_execution;
+
+private:
+    /**
+     * @brief Private constructor for creating a shared stack.
+     * @param alloc The allocator of the stack.
+     * @param st The allocated stack.
+     */
+    shared_stack(stack_allocator alloc, stack st);
+
+public:
+    /**
+     * @brief Creates a shared stack.
+     * @param alloc The allocator of the stack.
+     * @return A unique pointer to the created stack.
+     * @throws execution::invalid_stack_size if the stack is smaller than 128 KB.
+     */
+    static std::unique_ptr<shared_stack> create(stack_allocator alloc);
+
+    /**
+     * @brief Releases the stack. Every execution running on it must be destroyed first.
+     */
+    ~shared_stack() noexcept;
+
+    shared_stack(const shared_stack&) = delete;
+    shared_stack(shared_stack&&) = delete;
+    shared_stack& operator=(const shared_stack&) = delete;
+    shared_stack& operator=(shared_stack&&) = delete;
+
+    /**
+     * @brief Returns the size of the stack.
+     * @return The size in bytes.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+private:
+    /**
+     * @brief Returns the size of the stack below the base.
+     * @return The size in bytes.
+     */
+    [[nodiscard]] std::size_t usable_size() const noexcept;
+
+    /**
+     * @brief Checks if an address lies on the stack.
+     * @param address The address.
+     * @return `true` if the address is between the bottom and the top of the stack.
+     */
+    [[nodiscard]] bool contains(const void* address) const noexcept;
+
+    stack_allocator _allocator;
+    stack _stack;
+    /// The top the executions start from, aligned for the machine context.
+    std::byte* _base = nullptr;
+    /// The execution whose frames are on the stack, if any.
+    shared_execution* _occupant = nullptr;
+};
+
+/**
+ * @brief The `shared_execution` class is an execution whose frames live on a `shared_stack` while it runs, and in a
+ * heap buffer sized to its used stack while another execution of the same stack runs.
+ * It trades a copy of the used stack on each switch between executions of the stack for memory: an idle execution
+ * holds only its live frames and its control block instead of a whole stack. Resuming the occupant again copies
+ * nothing.
+ *
+ * The frames move between the stack and the buffer, so the addresses of the locals of a suspended execution are only
+ * valid once it is back on the stack: they must not be handed to other executions of the same stack.
+ */
+class shared_execution {
+private:
+    /**
+     * @brief Private constructor for creating an execution.
+     * @param st The stack the execution runs on.
+     * @param owned The owned flow, if any.
+     * @param flow The flow.
+     */
+    shared_execution(shared_stack& st, std::unique_ptr<api::flow> owned, api::flow* flow);
+
+public:
+    /**
+     * @brief Exception thrown when an execution is resumed from code running on its own shared stack.
+     */
+    struct resume_on_shared_stack : public error {
+        using error::error;
+    };
+
+    /**
+     * @brief Creates an execution on the shared stack. It does not use the stack until it is first resumed.
+     *
+     * @param st The stack, it must outlive the execution.
+     * @param flow The flow of the execution.
+     * @return A new `shared_execution` instance.
+     * @throws execution::invalid_flow if the input flow is nullptr.
+     */
+    static shared_execution create(shared_stack& st, std::unique_ptr<api::flow> flow);
+
+    /**
+     * @brief Creates an execution on the shared stack with a raw flow pointer.
+     * Note: The user must be careful with the lifetimes of execution and the flow.
+     *
+     * @param st The stack, it must outlive the execution.
+     * @param flow The flow of the execution.
+     * @return A new `shared_execution` instance.
+     * @throws execution::invalid_flow if the input flow is nullptr.
+     */
+    static shared_execution create_with_raw_flow(shared_stack& st, api::flow* flow);
+
+    /**
+     * @brief Unwinds the flow if it is suspended, copying it back onto the stack first.
+     */
+    ~shared_execution() noexcept;
+
+    shared_execution(const shared_execution&) = delete;
+    shared_execution(shared_execution&&) = delete;
+    shared_execution& operator=(const shared_execution&) = delete;
+    shared_execution& operator=(shared_execution&&) = delete;
+
+    /**
+     * @brief Resumes the flow, moving the current occupant of the stack out of the way first.
+     * @rethrows the uncaught exception during execution.
+     * @throws resume_on_shared_stack if called from an execution of the same stack.
+     */
+    void resume();
+
+    /**
+     * @brief Checks if the flow has returned.
+     * @return `true` once the flow has completed.
+     */
+    [[nodiscard]] bool is_completed() const noexcept;
+
+    /**
+     * @brief Returns the size of the frames saved off the stack.
+     * @return The size in bytes, zero while the execution occupies the stack or has not started.
+     */
+    [[nodiscard]] std::size_t saved_size() const noexcept;
+
+    /**
+     * @brief Returns the intrusive link of the execution, which lives in its control block.
+     * @return The hook.
+     */
+    [[nodiscard]] execution_hook& hook() noexcept;
+
+private:
+    static void entry(machine::transfer_t transfer) noexcept;
+
+    /**
+     * @brief Puts the frames of the execution on the stack, saving those of the current occupant.
+     */
+    void occupy();
+
+    /**
+     * @brief Copies the frames of the execution, the occupant, to its buffer and frees the stack.
+     */
+    void evacuate();
+
+    /**
+     * @brief Leaves the stack once the flow has completed.
+     */
+    void release() noexcept;
+
+    shared_stack& _stack;
+    std::unique_ptr<api::flow> _owned_flow;
+    execution_record _record;
+    /// The saved context, which is also the lowest address in use on the stack.
+    machine::context_t _context = nullptr;
+    bool _completed = false;
+    std::exception_ptr _exception;
+    /// The frames, from the saved context up to the stack base, while off the stack.
+    std::unique_ptr<std::byte[]> _saved;
+    std::size_t _saved_size = 0;
+    std::size_t _saved_capacity = 0;
+};
+
+} // namespace cortex
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_SPINLOCK_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_SPINLOCK_HPP
+
+#include <atomic>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace cortex {
+
+/**
+ * @brief Tells the processor that the calling thread is busy waiting, to be called once per spin iteration.
+ */
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+/**
+ * @brief The `spinlock` class is a test-and-test-and-set lock for very short critical sections.
+ * It never suspends, so it may be held across a fiber switch and released by the thread that resumes next.
+ */
+class spinlock {
+public:
+    spinlock() = default;
+
+    spinlock(const spinlock&) = delete;
+    spinlock(spinlock&&) = delete;
+    spinlock& operator=(const spinlock&) = delete;
+    spinlock& operator=(spinlock&&) = delete;
+
+    ~spinlock() noexcept = default;
+
+    /**
+     * @brief Acquires the lock, spinning until it is available.
+     */
+    void lock() noexcept {
+        while (_locked.exchange(true, std::memory_order_acquire)) {
+            for (unsigned spins = 0; _locked.load(std::memory_order_relaxed); ++spins) {
+                if (spins < 64) {
+                    cpu_relax();
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Tries to acquire the lock without spinning.
+     * @return `true` if the lock was acquired.
+     */
+    [[nodiscard]] bool try_lock() noexcept {
+        return !_locked.load(std::memory_order_relaxed) && !_locked.exchange(true, std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Releases the lock.
+     */
+    void unlock() noexcept {
+        _locked.store(false, std::memory_order_release);
+    }
+
+private:
+    std::atomic<bool> _locked {false};
+};
+
+} // namespace cortex
+
+#endif
@@ -0,0 +1,201 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_SPSC_QUEUE_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_SPSC_QUEUE_HPP
+
+#include <cortex/cache_line.hpp>
+#include <cortex/error.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace cortex {
+
+/**
+ * @brief The `spsc_queue` class is a bounded lock-free single-producer single-consumer ring buffer.
+ * Head and tail live on separate cache lines and each side keeps a cached copy of the other side's index, so the
+ * shared lines are only touched when the cached view runs out.
+ *
+ * @tparam T The item type, must be default constructible and movable.
+ */
+template <typename T>
+class spsc_queue {
+public:
+    /**
+     * @brief Creates an empty queue.
+     * @param capacity The capacity, rounded up to a power of two.
+     * @throws invalid_argument_error if the capacity is zero.
+     */
+    explicit spsc_queue(std::size_t capacity);
+
+    spsc_queue(const spsc_queue&) = delete;
+    spsc_queue(spsc_queue&&) = delete;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+    spsc_queue& operator=(spsc_queue&&) = delete;
+
+    ~spsc_queue() noexcept = default;
+
+    /**
+     * @brief Returns the capacity of the queue.
+     * @return The capacity.
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept;
+
+    /**
+     * @brief Pushes an item. Producer only.
+     * @param item The item to push.
+     * @return `false` if the queue is full, the item is left untouched in this case.
+     */
+    bool try_push(T& item);
+
+    /**
+     * @brief Pushes items from the range until the queue is full, publishing them with a single store. Producer only.
+     * @param first The beginning of the range.
+     * @param last The end of the range.
+     * @return Iterator to the first item that was not pushed.
+     */
+    template <typename It>
+    It try_push_bulk(It first, It last);
+
+    /**
+     * @brief Pops an item. Consumer only.
+     * @return The item or an empty optional if the queue is empty.
+     */
+    [[nodiscard]] std::optional<T> try_pop();
+
+    /**
+     * @brief Pops every item visible at the time of the call and releases their slots with a single store.
+     * Consumer only.
+     *
+     * @param consumer Callable invoked with each item, by rvalue reference. Must not throw.
+     * @return The number of consumed items.
+     */
+    template <typename Consumer>
+    std::size_t consume_all(Consumer&& consumer);
+
+    /**
+     * @brief Checks if the queue looks empty. Exact only when called by the consumer.
+     * @return `true` if no item was visible at the time of the call.
+     */
+    [[nodiscard]] bool empty() const noexcept;
+
+private:
+    const std::size_t _mask;
+    std::unique_ptr<T[]> _slots;
+
+    /// Next slot to write, owned by the producer.
+    alignas(cache_line_size) std::atomic<std::size_t> _tail {0};
+    std::size_t _cached_head {0};
+
+    /// Next slot to read, owned by the consumer.
+    alignas(cache_line_size) std::atomic<std::size_t> _head {0};
+    std::size_t _cached_tail {0};
+};
+
+namespace detail {
+
+inline std::size_t round_up_to_power_of_two(std::size_t value) noexcept {
+    std::size_t rounded = 1;
+    while (rounded < value) {
+        rounded <<= 1U;
+    }
+    return rounded;
+}
+
+} // namespace detail
+
+template <typename T>
+spsc_queue<T>::spsc_queue(std::size_t capacity)
+    : _mask(detail::round_up_to_power_of_two(capacity) - 1)
+    , _slots(std::make_unique<T[]>(_mask + 1)) {
+    if (capacity == 0) {
+        throw invalid_argument_error("The input capacity is zero.");
+    }
+}
+
+template <typename T>
+std::size_t spsc_queue<T>::capacity() const noexcept {
+    return _mask + 1;
+}
+
+template <typename T>
+bool spsc_queue<T>::try_push(T& item) {
+    const std::size_t tail = _tail.load(std::memory_order_relaxed);
+    if (tail - _cached_head == capacity()) {
+        _cached_head = _head.load(std::memory_order_acquire);
+        if (tail - _cached_head == capacity()) {
+            return false;
+        }
+    }
+
+    _slots[tail & _mask] = std::move(item);
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+template <typename It>
+It spsc_queue<T>::try_push_bulk(It first, It last) {
+    std::size_t tail = _tail.load(std::memory_order_relaxed);
+    const std::size_t begin = tail;
+
+    for (; first != last; ++first, ++tail) {
+        if (tail - _cached_head == capacity()) {
+            _cached_head = _head.load(std::memory_order_acquire);
+            if (tail - _cached_head == capacity()) {
+                break;
+            }
+        }
+        _slots[tail & _mask] = std::move(*first);
+    }
+
+    if (tail != begin) {
+        _tail.store(tail, std::memory_order_release);
+    }
+    return first;
+}
+
+template <typename T>
+std::optional<T> spsc_queue<T>::try_pop() {
+    const std::size_t head = _head.load(std::memory_order_relaxed);
+    if (head == _cached_tail) {
+        _cached_tail = _tail.load(std::memory_order_acquire);
+        if (head == _cached_tail) {
+            return std::nullopt;
+        }
+    }
+
+    std::optional<T> item(std::move(_slots[head & _mask]));
+    _slots[head & _mask] = T {};
+    _head.store(head + 1, std::memory_order_release);
+    return item;
+}
+
+template <typename T>
+template <typename Consumer>
+std::size_t spsc_queue<T>::consume_all(Consumer&& consumer) {
+    const std::size_t head = _head.load(std::memory_order_relaxed);
+    _cached_tail = _tail.load(std::memory_order_acquire);
+
+    std::size_t current = head;
+    for (; current != _cached_tail; ++current) {
+        T item(std::move(_slots[current & _mask]));
+        _slots[current & _mask] = T {};
+        consumer(std::move(item));
+    }
+
+    if (current != head) {
+        _head.store(current, std::memory_order_release);
+    }
+    return current - head;
+}
+
+template <typename T>
+bool spsc_queue<T>::empty() const noexcept {
+    return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+}
+
+} // namespace cortex
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_TASK_GROUP_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_TASK_GROUP_HPP
+
+#include <cortex/api/scheduler.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/spinlock.hpp>
+#include <cortex/wait_queue.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+
+namespace cortex {
+
+/**
+ * @brief The `task_group` class scopes a set of child fibers, like a nursery: the children never outlive the group.
+ * `join` parks the calling fiber until every child has finished and rethrows the first exception a child finished
+ * with. The first failure cancels the other children, which unwind their stacks with `forced_unwind` at their next
+ * cancellation point, see `fiber::cancellation_point`. A child that has not started yet unwinds before it runs.
+ */
+class task_group {
+public:
+    /// Type alias for the routines of the children.
+    using routine_t = std::function<void()>;
+
+    /**
+     * @brief Creates a group whose children run on the scheduler.
+     * @param sched The scheduler of the children.
+     */
+    explicit task_group(api::scheduler& sched);
+
+    /**
+     * @brief Creates a group whose children run on the scheduler of the current fiber.
+     * @throws fiber::not_in_fiber if called outside of a fiber.
+     */
+    task_group();
+
+    /**
+     * @brief Cancels and joins the children that are still running, their exceptions are dropped.
+     * Must be called from a fiber if a child is still running.
+     */
+    ~task_group() noexcept;
+
+    task_group(const task_group&) = delete;
+    task_group(task_group&&) = delete;
+    task_group& operator=(const task_group&) = delete;
+    task_group& operator=(task_group&&) = delete;
+
+    /**
+     * @brief Spawns a child running the routine.
+     * A child spawned after the group was cancelled unwinds as soon as it starts.
+     *
+     * @param routine The routine of the child.
+     * @throws invalid_argument_error if the input routine is nullptr.
+     */
+    void spawn(routine_t routine);
+
+    /**
+     * @brief Parks the current fiber until every child has finished. A cancellation point of the calling fiber.
+     * The group can be reused afterwards, its cancellation is reset.
+     *
+     * @rethrows the first exception a child finished with.
+     * @throws fiber::not_in_fiber if a child is still running and the caller is not a fiber.
+     */
+    void join();
+
+    /**
+     * @brief Requests every running and future child to unwind at its next cancellation point.
+     */
+    void cancel() noexcept;
+
+    /**
+     * @brief Checks if the group was cancelled, explicitly or by a failed child.
+     * @return `true` if the group is cancelled.
+     */
+    [[nodiscard]] bool is_cancelled() const noexcept;
+
+    /**
+     * @brief Returns the number of children that have not finished yet.
+     * @return The number of running children.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+private:
+    /**
+     * @brief Membership of a running child, lives on the stack of the child.
+     */
+    struct child {
+        fiber* self = nullptr;
+        child* prev = nullptr;
+        child* next = nullptr;
+    };
+
+    /**
+     * @brief Keeps a child registered for its whole life, including the unwinding of its stack.
+     */
+    class membership;
+
+    /**
+     * @brief Parks the current fiber until every child has finished and resets the group.
+     * @param cancellable Whether a cancellation of the fiber cuts the wait short, it then unwinds.
+     * @return The first exception a child finished with.
+     */
+    std::exception_ptr wait_children(bool cancellable);
+
+    void run_child(const routine_t& routine);
+
+    void fail(std::exception_ptr exception) noexcept;
+
+    /// Cancels every registered child, `_lock` must be held.
+    void cancel_children() noexcept;
+
+    api::scheduler& _scheduler;
+
+    mutable spinlock _lock;
+    std::size_t _running {0};
+    child* _children {nullptr};
+    bool _cancelled {false};
+    std::exception_ptr _exception;
+    wait_queue _joiners;
+};
+
+} // namespace cortex
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_THIS_COROUTINE_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_THIS_COROUTINE_HPP
+
+#include <cortex/api/suspendable.hpp>
+#include <cortex/error.hpp>
+
+#include <memory_resource>
+
+/**
+ * @brief Access to the execution running on the calling thread, so that deep library code can suspend without being
+ * handed a suspender. The current execution is tracked by `execution::resume` with a single thread-local pointer and
+ * follows nested executions: an execution resumed from another one is current until it suspends or completes.
+ */
+namespace cortex::this_coroutine {
+
+/**
+ * @brief Exception thrown when suspending outside of any execution.
+ */
+struct not_in_coroutine : public error {
+    using error::error;
+};
+
+/**
+ * @brief Returns the suspender of the current execution.
+ * Suspending through it bypasses the rules of the flow, such as the cancellation of coroutines or the rescheduling of
+ * fibers, prefer `suspend`.
+ *
+ * @return The suspender or nullptr outside of any execution or before its flow has started.
+ */
+[[nodiscard]] api::suspendable* get() noexcept;
+
+/**
+ * @brief Checks if the caller runs on an execution, i.e. a coroutine or a fiber.
+ * @return `true` inside of an execution.
+ */
+[[nodiscard]] bool is_inside() noexcept;
+
+/**
+ * @brief Returns the arena of the current execution, a bump allocator whose `deallocate` does nothing.
+ * Its memory comes from chained regions of the default resource and is released at once when the frame of the
+ * execution is destroyed, or at the end of each task on a `fiber_pool` worker, so no allocation made through it may
+ * outlive the execution or the task. It is meant for the many short-lived allocations of a request handled by one
+ * coroutine, e.g. through `std::pmr` containers.
+ *
+ * @return The arena or `std::pmr::get_default_resource()` outside of any execution.
+ */
+[[nodiscard]] std::pmr::memory_resource* memory_resource() noexcept;
+
+/**
+ * @brief Suspends the current execution the way its flow does: a coroutine returns to its resumer, a fiber yields
+ * to its scheduler.
+ *
+ * @throws not_in_coroutine if called outside of any execution.
+ */
+void suspend();
+
+} // namespace cortex::this_coroutine
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_TIMER_SERVICE_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_TIMER_SERVICE_HPP
+
+#include <cortex/error.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/timer_wheel.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace cortex {
+
+/**
+ * @brief The `timer_service` class lets fibers sleep and bound their waits without blocking their threads.
+ * Timers are intrusive entries of a `timer_wheel` that live on the stacks of their fibers. A dedicated thread sleeps
+ * until the next deadline of the wheel, advances it and fires every expired timer of the batch under the lock of the
+ * service, which is what allows `timeout` to cancel a timer synchronously.
+ */
+class timer_service {
+public:
+    /// Type alias for the clock of the deadlines.
+    using clock = std::chrono::steady_clock;
+
+    /// Default length of a tick of the wheel.
+    static constexpr clock::duration default_resolution = std::chrono::milliseconds(1);
+
+    /**
+     * @brief A timer armed for the lifetime of the object, the building block of timed waits.
+     * The callback runs on the thread of the service with its lock held, it must be short and must not touch the
+     * service. It may take the lock of a synchronization primitive, which in turn must never be held while arming or
+     * cancelling a timer.
+     */
+    class timeout {
+        friend class timer_service;
+
+    public:
+        /// Type alias for the callback run when the deadline passes.
+        using callback_t = void (*)(void* arg);
+
+        /**
+         * @brief Arms the timer.
+         * @param service The service running the timer.
+         * @param deadline The deadline.
+         * @param callback The callback.
+         * @param arg The argument passed to the callback.
+         */
+        timeout(timer_service& service, clock::time_point deadline, callback_t callback, void* arg);
+
+        /**
+         * @brief Cancels the timer, waiting for its callback if it is running.
+         */
+        ~timeout() noexcept;
+
+        timeout(const timeout&) = delete;
+        timeout(timeout&&) = delete;
+        timeout& operator=(const timeout&) = delete;
+        timeout& operator=(timeout&&) = delete;
+
+    private:
+        struct node : timer_wheel::entry {
+            callback_t callback = nullptr;
+            void* arg = nullptr;
+        };
+
+        timeout() = default;
+
+        node _node;
+        /// The service to cancel the timer with, nullptr if it is known to have fired.
+        timer_service* _service {nullptr};
+    };
+
+private:
+    /**
+     * @brief Private constructor for creating a timer service.
+     * @param resolution The length of a tick.
+     */
+    explicit timer_service(clock::duration resolution);
+
+public:
+    /**
+     * @brief Creates a timer service and starts its thread.
+     * @param resolution The length of a tick, deadlines are rounded up to it.
+     * @return A unique pointer to the created service.
+     * @throws invalid_argument_error if the resolution is not positive.
+     */
+    static std::unique_ptr<timer_service> create(clock::duration resolution = default_resolution);
+
+    /**
+     * @brief Stops and joins the thread of the service. No timer may be armed.
+     */
+    ~timer_service() noexcept;
+
+    timer_service(const timer_service&) = delete;
+    timer_service(timer_service&&) = delete;
+    timer_service& operator=(const timer_service&) = delete;
+    timer_service& operator=(timer_service&&) = delete;
+
+    /**
+     * @brief Parks the current fiber for at least the given duration.
+     * @param duration The duration.
+     * @throws fiber::not_in_fiber if called outside of a fiber.
+     */
+    void sleep_for(clock::duration duration);
+
+    /**
+     * @brief Parks the current fiber until the deadline has passed, or until it is cancelled.
+     * @param deadline The deadline.
+     * @throws fiber::not_in_fiber if called outside of a fiber.
+     */
+    void sleep_until(clock::time_point deadline);
+
+    /**
+     * @brief Returns the number of armed timers.
+     * @return The number of timers.
+     */
+    [[nodiscard]] std::size_t pending() const;
+
+private:
+    /// Park hook of `sleep_until`.
+    static void arm(void* t);
+
+    static void wake(void* f);
+
+    /// Interruption of `sleep_until`: takes the timer off the wheel, or makes it fire right away if not armed yet.
+    static bool unlink(void* t) noexcept;
+
+    void schedule(timeout& t);
+
+    void cancel(timeout& t) noexcept;
+
+    void run();
+
+    [[nodiscard]] timer_wheel::tick_t to_tick(clock::time_point deadline) const noexcept;
+
+    const clock::duration _resolution;
+    const clock::time_point _epoch;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _wakeup;
+    timer_wheel _wheel;
+    /// The tick the thread sleeps until, an earlier timer has to wake it up.
+    timer_wheel::tick_t _sleeping_until {std::numeric_limits<timer_wheel::tick_t>::max()};
+    bool _stopping {false};
+    std::thread _thread;
+};
+
+} // namespace cortex
+
+#endif
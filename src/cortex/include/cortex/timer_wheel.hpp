@@ -0,0 +1,135 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_TIMER_WHEEL_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_TIMER_WHEEL_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace cortex {
+
+/**
+ * @brief The `timer_wheel` class is a hierarchical timing wheel over intrusive entries.
+ * Each of the `levels` levels has `slots` slots, a slot of level `n` spans `slots^n` ticks. An entry is filed under the
+ * level of the highest 6-bit digit in which its deadline differs from the current tick, so scheduling and cancelling
+ * are O(1) and never allocate. While the wheel advances, the entries of a higher level slot are cascaded down once
+ * its span is reached and expire from level zero. Per-level occupancy bitmaps let `advance` and `next_deadline` skip
+ * empty slots instead of stepping through every tick.
+ * The wheel is not synchronized.
+ */
+class timer_wheel {
+public:
+    /// Type alias for a point in time, counted in ticks.
+    using tick_t = std::uint64_t;
+
+    static constexpr unsigned slot_bits = 6;
+    static constexpr unsigned slots = 1U << slot_bits;
+    static constexpr unsigned levels = 6;
+    /// Deadlines further away than the span of the wheel wait in its last level and are cascaded again.
+    static constexpr tick_t span = tick_t {1} << (slot_bits * levels);
+
+    /**
+     * @brief Intrusive node of a scheduled timer, owned by the caller.
+     */
+    struct entry {
+        tick_t deadline = 0;
+        entry* prev = nullptr;
+        entry* next = nullptr;
+        /// The list holding the entry, nullptr once it expired or was cancelled.
+        entry** list = nullptr;
+        std::uint8_t level = 0;
+        std::uint8_t slot = 0;
+    };
+
+    /**
+     * @brief Creates an empty wheel.
+     * @param now The current tick.
+     */
+    explicit timer_wheel(tick_t now = 0) noexcept;
+
+    timer_wheel(const timer_wheel&) = delete;
+    timer_wheel(timer_wheel&&) = delete;
+    timer_wheel& operator=(const timer_wheel&) = delete;
+    timer_wheel& operator=(timer_wheel&&) = delete;
+
+    ~timer_wheel() noexcept = default;
+
+    /**
+     * @brief Schedules an entry. A deadline that has already passed expires on the next `advance`.
+     * @param e The entry, must not be scheduled already and must outlive its stay in the wheel.
+     * @param deadline The tick at which the entry expires.
+     */
+    void schedule(entry& e, tick_t deadline) noexcept;
+
+    /**
+     * @brief Removes an entry from the wheel.
+     * @param e The entry.
+     * @return `false` if the entry was not scheduled.
+     */
+    bool cancel(entry& e) noexcept;
+
+    /**
+     * @brief Moves the wheel forward, collecting every entry whose deadline is at or before `now`.
+     * @param now The new current tick, ignored if it lies in the past.
+     * @return The expired entries, linked through `next` and already removed from the wheel.
+     */
+    [[nodiscard]] entry* advance(tick_t now) noexcept;
+
+    /**
+     * @brief Returns the earliest tick at which `advance` has work to do, either expiring or cascading entries.
+     * @return The tick or nothing if the wheel is empty.
+     */
+    [[nodiscard]] std::optional<tick_t> next_deadline() const noexcept;
+
+    /**
+     * @brief Returns the current tick.
+     * @return The tick of the last `advance`.
+     */
+    [[nodiscard]] tick_t now() const noexcept;
+
+    /**
+     * @brief Returns the number of scheduled entries.
+     * @return The number of entries.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * @brief Checks if the wheel is empty.
+     * @return `true` if no entry is scheduled.
+     */
+    [[nodiscard]] bool empty() const noexcept;
+
+private:
+    struct level {
+        std::uint64_t occupied = 0;
+        std::array<entry*, slots> heads {};
+    };
+
+    /// The next slot to process and the tick at which it starts.
+    struct due_slot {
+        unsigned level_index;
+        unsigned slot;
+        tick_t start;
+    };
+
+    /// Files the entry under its level and slot relative to the current tick.
+    void insert(entry& e) noexcept;
+
+    static void push(entry*& head, entry& e) noexcept;
+
+    /**
+     * @brief Finds the next occupied slot.
+     * @return The slot or nothing if the levels are empty.
+     */
+    [[nodiscard]] std::optional<due_slot> next_slot() const noexcept;
+
+    tick_t _now;
+    std::size_t _size = 0;
+    /// Entries scheduled in the past.
+    entry* _overdue = nullptr;
+    std::array<level, levels> _levels {};
+};
+
+} // namespace cortex
+
+#endif
@@ -0,0 +1,188 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_URING_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_URING_HPP
+
+#include <cortex/error.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/spinlock.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include <sys/socket.h>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace cortex {
+
+/**
+ * @brief The `uring` class runs the I/O of fibers on an io_uring instance, talking to the kernel through the raw
+ * system calls. A fiber describes its operation on its own stack and parks, a dedicated event loop thread turns all
+ * the operations published since its last iteration into SQEs, submits them and waits for completions with a single
+ * `io_uring_enter`, then stores the result of every reaped CQE in its operation and wakes the fiber.
+ */
+class uring {
+    /**
+     * @brief An operation waiting for its completion, lives on the stack of the parked fiber.
+     */
+    struct operation {
+        uring* ring = nullptr;
+        std::uint8_t opcode = 0;
+        int fd = -1;
+        std::uint64_t addr = 0;
+        std::uint32_t len = 0;
+        std::uint64_t offset = 0;
+        fiber* owner = nullptr;
+        std::int32_t result = 0;
+        operation* next = nullptr;
+    };
+
+public:
+    /// Default number of submission queue entries.
+    static constexpr unsigned default_entries = 256;
+
+    /// Offset value meaning the current file position.
+    static constexpr std::uint64_t current_position = ~std::uint64_t {0};
+
+private:
+    /**
+     * @brief Private constructor for creating a ring.
+     * @param entries The number of submission queue entries.
+     */
+    explicit uring(unsigned entries);
+
+public:
+    /**
+     * @brief Creates a ring and starts its event loop thread.
+     * @param entries The number of submission queue entries, rounded up to a power of two by the kernel.
+     * @return A unique pointer to the created ring.
+     * @throws invalid_argument_error if `entries` is zero.
+     * @throws system_error if the ring cannot be set up.
+     */
+    static std::unique_ptr<uring> create(unsigned entries = default_entries);
+
+    /**
+     * @brief Stops and joins the event loop. No operation may be pending.
+     */
+    ~uring() noexcept;
+
+    uring(const uring&) = delete;
+    uring(uring&&) = delete;
+    uring& operator=(const uring&) = delete;
+    uring& operator=(uring&&) = delete;
+
+    /**
+     * @brief Reads at most `size` bytes, parking the current fiber until the read completes.
+     * @param fd The file descriptor.
+     * @param buffer The destination buffer.
+     * @param size The size of the buffer.
+     * @param offset The file offset or `current_position`.
+     * @return The number of bytes read, zero at the end of the stream.
+     * @throws system_error if the read fails.
+     * @throws fiber::not_in_fiber if called outside of a fiber.
+     */
+    std::size_t async_read(int fd, void* buffer, std::size_t size, std::uint64_t offset = current_position);
+
+    /**
+     * @brief Writes at most `size` bytes, parking the current fiber until the write completes.
+     * @param fd The file descriptor.
+     * @param buffer The source buffer.
+     * @param size The size of the buffer.
+     * @param offset The file offset or `current_position`.
+     * @return The number of bytes written.
+     * @throws system_error if the write fails.
+     * @throws fiber::not_in_fiber if called outside of a fiber.
+     */
+    std::size_t async_write(int fd, const void* buffer, std::size_t size, std::uint64_t offset = current_position);
+
+    /**
+     * @brief Accepts a connection on a listening socket, parking the current fiber until one is pending.
+     * @param fd The listening socket.
+     * @return The accepted socket, with `SOCK_CLOEXEC` set.
+     * @throws system_error if the accept fails.
+     * @throws fiber::not_in_fiber if called outside of a fiber.
+     */
+    int async_accept(int fd);
+
+    /**
+     * @brief Connects a socket, parking the current fiber until the connection is established.
+     * @param fd The socket.
+     * @param address The address to connect to, must stay valid until the call returns.
+     * @param length The length of the address.
+     * @throws system_error if the connection fails.
+     * @throws fiber::not_in_fiber if called outside of a fiber.
+     */
+    void async_connect(int fd, const sockaddr* address, socklen_t length);
+
+    /**
+     * @brief Flushes the file to the storage device, parking the current fiber until the flush completes.
+     * @param fd The file descriptor.
+     * @throws system_error if the flush fails.
+     * @throws fiber::not_in_fiber if called outside of a fiber.
+     */
+    void async_fsync(int fd);
+
+private:
+    /**
+     * @brief Publishes the operation to the event loop and parks until its completion.
+     * @return The result of the CQE.
+     */
+    std::int32_t submit(operation& op, const char* what);
+
+    /**
+     * @brief Park hook publishing the operation once its fiber is off the stack.
+     */
+    static void publish(void* op) noexcept;
+
+    void enqueue(operation& op) noexcept;
+
+    void run();
+
+    /**
+     * @brief Fills the next free SQE.
+     * @return `false` if the submission queue is full.
+     */
+    bool prepare(std::uint8_t opcode, int fd, std::uint64_t addr, std::uint32_t len, std::uint64_t offset,
+                 std::uint64_t user_data) noexcept;
+
+    void unmap() noexcept;
+
+    int _ring {-1};
+    /// eventfd used to wake the event loop, a read of it is always in flight.
+    int _wakeup {-1};
+    std::uint64_t _wakeup_value {0};
+
+    void* _sq_map {nullptr};
+    std::size_t _sq_map_size {0};
+    void* _cq_map {nullptr};
+    std::size_t _cq_map_size {0};
+    io_uring_sqe* _sqes {nullptr};
+    std::size_t _sqes_size {0};
+
+    unsigned* _sq_head {nullptr};
+    unsigned* _sq_tail {nullptr};
+    unsigned* _sq_array {nullptr};
+    unsigned _sq_mask {0};
+    unsigned _sq_entries {0};
+    unsigned* _cq_head {nullptr};
+    unsigned* _cq_tail {nullptr};
+    io_uring_cqe* _cqes {nullptr};
+    unsigned _cq_mask {0};
+
+    /// Operations published since the last iteration of the event loop.
+    spinlock _pending_lock;
+    operation* _pending_head {nullptr};
+    operation* _pending_tail {nullptr};
+
+    /// Set while the event loop may block in `io_uring_enter`.
+    std::atomic<bool> _sleeping {false};
+    std::atomic<bool> _stopping {false};
+    std::thread _thread;
+};
+
+} // namespace cortex
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_WAIT_GROUP_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_WAIT_GROUP_HPP
+
+#include <cortex/error.hpp>
+#include <cortex/spinlock.hpp>
+#include <cortex/wait_queue.hpp>
+
+#include <atomic>
+#include <cstddef>
+
+namespace cortex {
+
+/**
+ * @brief The `wait_group` class waits for a collection of fibers to finish, like Go's `sync.WaitGroup`.
+ * Constructed with a count and never `add`ed to, it is a fiber-aware latch.
+ */
+class wait_group {
+public:
+    /**
+     * @brief Exception thrown when the counter goes negative.
+     */
+    struct negative_counter : public error {
+        using error::error;
+    };
+
+    /**
+     * @brief Creates a wait group.
+     * @param count The initial value of the counter.
+     */
+    explicit wait_group(std::ptrdiff_t count = 0);
+
+    wait_group(const wait_group&) = delete;
+    wait_group(wait_group&&) = delete;
+    wait_group& operator=(const wait_group&) = delete;
+    wait_group& operator=(wait_group&&) = delete;
+
+    ~wait_group() noexcept = default;
+
+    /**
+     * @brief Adds a delta to the counter, waking the waiters when it drops to zero.
+     * @param delta The value to add, may be negative.
+     * @throws negative_counter if the counter goes negative.
+     */
+    void add(std::ptrdiff_t delta);
+
+    /**
+     * @brief Decrements the counter by one.
+     * @throws negative_counter if the counter goes negative.
+     */
+    void done();
+
+    /**
+     * @brief Parks the current fiber until the counter drops to zero.
+     * @throws fiber::not_in_fiber if the counter is not zero and the caller is not a fiber.
+     */
+    void wait();
+
+    /**
+     * @brief Checks if the counter is zero.
+     * @return `true` if `wait` would return immediately.
+     */
+    [[nodiscard]] bool try_wait() const noexcept;
+
+private:
+    std::atomic<std::ptrdiff_t> _count;
+    spinlock _lock;
+    wait_queue _waiters;
+};
+
+} // namespace cortex
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_WAIT_QUEUE_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_WAIT_QUEUE_HPP
+
+#include <cortex/fiber.hpp>
+#include <cortex/spinlock.hpp>
+
+namespace cortex {
+
+/**
+ * @brief The `wait_queue` class is an intrusive FIFO of parked fibers, the building block of the fiber-aware
+ * synchronization primitives. Nodes live on the stacks of the parked fibers, so waiting never allocates.
+ * The queue itself is not synchronized, it is protected by the spinlock of the primitive owning it.
+ */
+class wait_queue {
+public:
+    /**
+     * @brief Intrusive node of a parked fiber.
+     */
+    struct node {
+        fiber* owner = nullptr;
+        node* next = nullptr;
+    };
+
+    wait_queue() = default;
+
+    wait_queue(const wait_queue&) = delete;
+    wait_queue(wait_queue&&) = delete;
+    wait_queue& operator=(const wait_queue&) = delete;
+    wait_queue& operator=(wait_queue&&) = delete;
+
+    ~wait_queue() noexcept = default;
+
+    /**
+     * @brief Enqueues the current fiber and parks it.
+     * `lock` must be held by the caller, it is released by the resuming thread once the fiber is switched out, so a
+     * waker that takes the same lock can never see the fiber before it is parked.
+     *
+     * @param lock The spinlock protecting the queue.
+     * @throws fiber::not_in_fiber if called outside of a fiber, `lock` is released in this case.
+     */
+    void wait(spinlock& lock);
+
+    /**
+     * @brief Enqueues a node provided by the caller and parks its fiber, for waiters that may have to be removed.
+     * @param lock The spinlock protecting the queue, held by the caller and released once the fiber is switched out.
+     * @param n The node, its owner must be the current fiber.
+     */
+    void wait(spinlock& lock, node& n);
+
+    /**
+     * @brief Enqueues the current fiber and parks it like `wait`, unless `fiber::cancel` cuts the wait short: the
+     * fiber is then unlinked under `lock` and woken up. Only for waits whose wakers hand nothing over to the fiber.
+     *
+     * @param lock The spinlock protecting the queue, held by the caller and released once the fiber is switched out.
+     * @return `false` if the wait was cut short, the caller then unwinds at a cancellation point.
+     * @throws fiber::not_in_fiber if called outside of a fiber, `lock` is released in this case.
+     */
+    [[nodiscard]] bool wait_cancellable(spinlock& lock);
+
+    /**
+     * @brief Enqueues a node provided by the caller and parks its fiber like `wait_cancellable`.
+     * @param lock The spinlock protecting the queue, held by the caller and released once the fiber is switched out.
+     * @param n The node, its owner must be the current fiber.
+     * @return `false` if the wait was cut short, the caller then unwinds at a cancellation point.
+     */
+    [[nodiscard]] bool wait_cancellable(spinlock& lock, node& n);
+
+    /**
+     * @brief Dequeues the oldest waiter.
+     * @return The fiber to wake or nullptr if the queue is empty.
+     */
+    [[nodiscard]] fiber* pop() noexcept;
+
+    /**
+     * @brief Detaches every waiter from the queue.
+     * @return The first node of the detached list, to be passed to `wake_all` once the lock is released.
+     */
+    [[nodiscard]] node* take_all() noexcept;
+
+    /**
+     * @brief Unlinks a node, walking the queue from the front.
+     * @param n The node.
+     * @return `false` if the node was not queued anymore.
+     */
+    bool remove(node& n) noexcept;
+
+    /**
+     * @brief Wakes every fiber of a list returned by `take_all`.
+     * @param head The first node of the list.
+     */
+    static void wake_all(node* head);
+
+    /**
+     * @brief Checks if the queue is empty.
+     * @return `true` if nobody is waiting.
+     */
+    [[nodiscard]] bool empty() const noexcept;
+
+private:
+    void push(node& n) noexcept;
+
+    node* _head = nullptr;
+    node* _tail = nullptr;
+};
+
+} // namespace cortex
+
+#endif
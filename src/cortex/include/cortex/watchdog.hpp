@@ -0,0 +1,202 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_WATCHDOG_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_WATCHDOG_HPP
+
+#include <cortex/error.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cortex {
+
+struct execution_record;
+
+/**
+ * @brief The `watchdog` class finds executions that hog their thread, e.g. fiber handlers that never suspend.
+ * Every switch in and out of an execution already publishes the running record in a thread-local slot. While a
+ * watchdog is alive, it also bumps a switch count next to it: one store to a line the switch writes anyway. The
+ * watchdog thread wakes up every `options::interval`, times each thread from the first check that sees its count
+ * change, and reports, once per switch, each execution that has run for longer than `options::threshold` since. On
+ * Linux the report carries a backtrace of the running stack, taken by the hogging thread itself in a handler of
+ * `options::signal`.
+ *
+ * Durations are timed from a check, so they may be underestimated by up to one interval, and an execution that
+ * resumes nested ones is timed from the last switch back to it. Only one watchdog may run at a time.
+ */
+class watchdog {
+public:
+    /// Type alias for the clock of the watchdog.
+    using clock = std::chrono::steady_clock;
+
+    /// Maximum number of frames of a backtrace.
+    static constexpr std::size_t max_frames = 64;
+
+    /**
+     * @brief An execution found running for longer than the threshold.
+     */
+    struct report {
+        /// The thread running the execution.
+        std::thread::id thread;
+        /// Identifies the execution, only valid for comparisons: it may have completed by the time of the report.
+        const void* execution = nullptr;
+        /// How long the execution had been running without a switch.
+        clock::duration running {};
+        /// Return addresses of the running stack, innermost first, empty where backtraces are not supported.
+        std::vector<void*> frames;
+
+        /**
+         * @brief Formats the report with symbolized frames.
+         * @return A multi-line description.
+         */
+        [[nodiscard]] std::string to_string() const;
+    };
+
+    /// Type alias for the function receiving the reports, called on the watchdog thread.
+    using handler_t = std::function<void(const report&)>;
+
+    /**
+     * @brief Options of the watchdog.
+     */
+    struct options {
+        /// Running time above which an execution is reported.
+        clock::duration threshold = std::chrono::milliseconds(100);
+        /// Period of the checks, and resolution of the measured durations.
+        clock::duration interval = std::chrono::milliseconds(10);
+        /// Receives the reports, prints them to the standard error if empty.
+        handler_t handler;
+        /// Signal interrupting a hogging thread to take its backtrace, zero to skip backtraces.
+        int signal = default_signal();
+    };
+
+    /**
+     * @brief Exception thrown when a watchdog is created while another one is running.
+     */
+    struct already_running : public error {
+        using error::error;
+    };
+
+private:
+    /**
+     * @brief Private constructor for creating a watchdog.
+     * @param opts The options.
+     */
+    explicit watchdog(options opts);
+
+public:
+    /**
+     * @brief Starts the watchdog thread.
+     * @param opts The options.
+     * @return A unique pointer to the created watchdog.
+     * @throws invalid_argument_error if the threshold or the interval is not positive.
+     * @throws already_running if another watchdog is running.
+     */
+    static std::unique_ptr<watchdog> create(options opts);
+
+    /**
+     * @brief Stops and joins the watchdog thread.
+     */
+    ~watchdog() noexcept;
+
+    watchdog(const watchdog&) = delete;
+    watchdog(watchdog&&) = delete;
+    watchdog& operator=(const watchdog&) = delete;
+    watchdog& operator=(watchdog&&) = delete;
+
+    /**
+     * @brief Returns the number of reports so far.
+     * @return The number of reports.
+     */
+    [[nodiscard]] std::size_t reports() const noexcept;
+
+    /**
+     * @brief Returns the default signal for backtraces, `SIGURG` where backtraces are supported, otherwise zero.
+     * @return The signal number.
+     */
+    [[nodiscard]] static int default_signal() noexcept;
+
+private:
+    void run();
+
+    void check(std::int64_t now, std::vector<report>& found);
+
+    const options _options;
+    std::atomic<std::size_t> _reports {0};
+
+    std::mutex _mutex;
+    std::condition_variable _stop_cv;
+    bool _stopping {false};
+    std::thread _thread;
+};
+
+namespace detail {
+
+/**
+ * @brief What a thread publishes on each switch, in the thread-local slot of its current record. Written by its owner,
+ * read by the watchdog thread.
+ */
+struct switch_state {
+    /// The running execution, nullptr between executions.
+    std::atomic<execution_record*> record {nullptr};
+    /// Number of switches in and out made while a watchdog runs.
+    std::atomic<std::uint64_t> switches {0};
+    /// Set once the thread has a heartbeat, owned by the thread.
+    bool registered = false;
+};
+
+/**
+ * @brief The registration of a thread with the watchdog, and what the watchdog thread keeps about it.
+ */
+struct heartbeat {
+    explicit heartbeat(const switch_state& st);
+
+    ~heartbeat() noexcept;
+
+    heartbeat(const heartbeat&) = delete;
+    heartbeat(heartbeat&&) = delete;
+    heartbeat& operator=(const heartbeat&) = delete;
+    heartbeat& operator=(heartbeat&&) = delete;
+
+    /// The switches of the thread.
+    const switch_state& state;
+
+    /// The last switch count seen, when it was first seen and the count of the last report, owned by the watchdog
+    /// thread.
+    std::uint64_t seen_switches = 0;
+    std::int64_t seen_at = 0;
+    std::uint64_t reported_switches = 0;
+
+    /// Backtrace taken by the signal handler on request of the watchdog thread.
+    std::atomic<bool> backtrace_ready {false};
+    const execution_record* backtrace_of = nullptr;
+    std::array<void*, watchdog::max_frames> frames {};
+    std::size_t depth = 0;
+
+    std::thread::id thread;
+    std::thread::native_handle_type native_handle {};
+};
+
+/// Set while a watchdog runs, the only cost of the switches otherwise.
+extern std::atomic<bool> watchdog_enabled;
+
+/**
+ * @brief Registers the calling thread with the watchdog. A thread that cannot be registered, e.g. out of memory, is
+ * not watched, and may try again on its next switch.
+ * @param state The switch state of the thread.
+ * @return `true` once the thread is registered.
+ */
+bool register_thread(const switch_state& state) noexcept;
+
+} // namespace detail
+
+} // namespace cortex
+
+#endif
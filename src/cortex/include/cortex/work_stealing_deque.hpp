@@ -0,0 +1,200 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_WORK_STEALING_DEQUE_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_WORK_STEALING_DEQUE_HPP
+
+#include <cortex/cache_line.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cortex {
+
+/**
+ * @brief The `work_stealing_deque` class is a Chase-Lev work-stealing deque of pointers.
+ * The owning thread pushes and pops at the bottom, any other thread may steal from the top.
+ * Memory orderings follow "Correct and Efficient Work-Stealing for Weak Memory Models" (Le et al., PPoPP 2013).
+ *
+ * @tparam T The pointee type, the deque stores `T*` and uses nullptr as the "nothing" value.
+ */
+template <typename T>
+class work_stealing_deque {
+    /**
+     * @brief Circular buffer with a power of two capacity.
+     */
+    class ring {
+    public:
+        explicit ring(std::int64_t capacity)
+            : _mask(capacity - 1)
+            , _slots(std::make_unique<std::atomic<T*>[]>(static_cast<std::size_t>(capacity))) {}
+
+        [[nodiscard]] std::int64_t capacity() const noexcept {
+            return _mask + 1;
+        }
+
+        [[nodiscard]] T* get(std::int64_t index) const noexcept {
+            return _slots[static_cast<std::size_t>(index & _mask)].load(std::memory_order_relaxed);
+        }
+
+        void put(std::int64_t index, T* value) noexcept {
+            _slots[static_cast<std::size_t>(index & _mask)].store(value, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] std::unique_ptr<ring> grow(std::int64_t bottom, std::int64_t top) const {
+            auto bigger = std::make_unique<ring>(capacity() * 2);
+            for (std::int64_t i = top; i != bottom; ++i) {
+                bigger->put(i, get(i));
+            }
+            return bigger;
+        }
+
+    private:
+        std::int64_t _mask;
+        std::unique_ptr<std::atomic<T*>[]> _slots;
+    };
+
+public:
+    /// Default capacity, grown on demand by the owner.
+    static constexpr std::size_t default_capacity = 256;
+
+    /**
+     * @brief Creates an empty deque.
+     * @param capacity The initial capacity, rounded up to a power of two.
+     */
+    explicit work_stealing_deque(std::size_t capacity = default_capacity);
+
+    work_stealing_deque(const work_stealing_deque&) = delete;
+    work_stealing_deque(work_stealing_deque&&) = delete;
+    work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+    work_stealing_deque& operator=(work_stealing_deque&&) = delete;
+
+    ~work_stealing_deque() noexcept = default;
+
+    /**
+     * @brief Pushes an item at the bottom. Owner thread only.
+     * @param item The item to push, must not be nullptr.
+     */
+    void push(T* item);
+
+    /**
+     * @brief Pops the most recently pushed item. Owner thread only.
+     * @return The item or nullptr if the deque is empty.
+     */
+    [[nodiscard]] T* pop() noexcept;
+
+    /**
+     * @brief Steals the oldest item. Any thread.
+     * @return The item or nullptr if the deque is empty or the race for the item was lost.
+     */
+    [[nodiscard]] T* steal() noexcept;
+
+    /**
+     * @brief Returns an estimate of the number of items, exact only when called by the owner with no thieves around.
+     * @return The approximate size.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * @brief Checks if the deque looks empty.
+     * @return `true` if no item was visible at the time of the call.
+     */
+    [[nodiscard]] bool empty() const noexcept;
+
+private:
+    alignas(cache_line_size) std::atomic<std::int64_t> _top {0};
+    alignas(cache_line_size) std::atomic<std::int64_t> _bottom {0};
+    alignas(cache_line_size) std::atomic<ring*> _ring {nullptr};
+    /// Every ring ever installed. Old rings may still be read by a slow thief, so they live as long as the deque.
+    std::vector<std::unique_ptr<ring>> _rings;
+};
+
+template <typename T>
+work_stealing_deque<T>::work_stealing_deque(std::size_t capacity) {
+    std::size_t rounded = 1;
+    while (rounded < capacity) {
+        rounded <<= 1U;
+    }
+
+    _rings.push_back(std::make_unique<ring>(static_cast<std::int64_t>(rounded)));
+    _ring.store(_rings.back().get(), std::memory_order_relaxed);
+}
+
+template <typename T>
+void work_stealing_deque<T>::push(T* item) {
+    assert(item != nullptr);
+
+    const std::int64_t bottom = _bottom.load(std::memory_order_relaxed);
+    const std::int64_t top = _top.load(std::memory_order_acquire);
+    ring* r = _ring.load(std::memory_order_relaxed);
+
+    if (bottom - top > r->capacity() - 1) {
+        _rings.push_back(r->grow(bottom, top));
+        r = _rings.back().get();
+        _ring.store(r, std::memory_order_release);
+    }
+
+    r->put(bottom, item);
+    std::atomic_thread_fence(std::memory_order_release);
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+template <typename T>
+T* work_stealing_deque<T>::pop() noexcept {
+    const std::int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+    ring* r = _ring.load(std::memory_order_relaxed);
+    _bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t top = _top.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+        // Empty.
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    T* item = r->get(bottom);
+    if (top == bottom) {
+        // Last item, race against thieves for it.
+        if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            item = nullptr;
+        }
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return item;
+}
+
+template <typename T>
+T* work_stealing_deque<T>::steal() noexcept {
+    std::int64_t top = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::int64_t bottom = _bottom.load(std::memory_order_acquire);
+
+    if (top >= bottom) {
+        return nullptr;
+    }
+
+    ring* r = _ring.load(std::memory_order_acquire);
+    T* item = r->get(top);
+    if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    return item;
+}
+
+template <typename T>
+std::size_t work_stealing_deque<T>::size() const noexcept {
+    const std::int64_t bottom = _bottom.load(std::memory_order_relaxed);
+    const std::int64_t top = _top.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+}
+
+template <typename T>
+bool work_stealing_deque<T>::empty() const noexcept {
+    return size() == 0;
+}
+
+} // namespace cortex
+
+#endif
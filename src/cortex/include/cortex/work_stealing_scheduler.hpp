@@ -0,0 +1,184 @@
+#ifndef SRC_CORTEX_INCLUDE_CORTEX_WORK_STEALING_SCHEDULER_HPP
+#define SRC_CORTEX_INCLUDE_CORTEX_WORK_STEALING_SCHEDULER_HPP
+
+#include <cortex/api/scheduler.hpp>
+#include <cortex/cache_line.hpp>
+#include <cortex/error.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/mpsc_inbox.hpp>
+#include <cortex/parker.hpp>
+#include <cortex/work_stealing_deque.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cortex {
+
+/**
+ * @brief The `work_stealing_scheduler` class is an M:N runtime running fibers on a fixed set of worker threads.
+ * Every worker owns a Chase-Lev deque: fibers spawned or woken on a worker are pushed to its deque and popped in LIFO
+ * order, idle workers steal the oldest fibers of randomly chosen victims. Fibers created or woken outside of the
+ * workers go through a shared injection queue. A fiber woken with `schedule_next` skips the deque and runs as soon as
+ * the current fiber of the worker parks or yields. A fiber sent back with `schedule_home` goes to the lock-free inbox
+ * of its worker, which is never stolen from. Idle workers spin for a while before they sleep on a futex of their own,
+ * and a wakeup is only sent to a worker that is actually asleep.
+ */
+class work_stealing_scheduler : public api::scheduler {
+public:
+    /// Default stack size of the spawned fibers.
+    static constexpr std::size_t default_stack_size = 256 * 1024;
+
+    /**
+     * @brief Exception thrown when `wait` is called from one of the scheduler's own fibers.
+     */
+    struct wait_from_worker : public error {
+        using error::error;
+    };
+
+private:
+    /**
+     * @brief Per-thread state of the scheduler.
+     */
+    struct alignas(cache_line_size) worker {
+        explicit worker(std::size_t idx)
+            : index(idx)
+            , seed(0x9E3779B97F4A7C15ULL * (idx + 1)) {}
+
+        std::size_t index;
+        std::uint64_t seed;
+        work_stealing_deque<fiber> deque;
+        /// Fiber handed over by `schedule_next`, runs before the deque and is never stolen.
+        fiber* next = nullptr;
+        /// Fibers sent back by `schedule_home`, run before the deque and are never stolen.
+        mpsc_inbox<fiber> inbox;
+        /// Where the worker sleeps when there is nothing to run.
+        parker parking;
+        std::thread thread;
+    };
+
+    /**
+     * @brief Private constructor for creating a scheduler.
+     * @param workers The number of worker threads.
+     * @param stack_size The stack size of the spawned fibers.
+     */
+    work_stealing_scheduler(std::size_t workers, std::size_t stack_size);
+
+public:
+    /**
+     * @brief Creates a scheduler and starts its worker threads.
+     * @param workers The number of worker threads.
+     * @param stack_size The stack size of the spawned fibers.
+     * @return A unique pointer to the created scheduler.
+     * @throws invalid_argument_error if the number of workers is zero.
+     */
+    static std::unique_ptr<work_stealing_scheduler> create(std::size_t workers,
+                                                           std::size_t stack_size = default_stack_size);
+
+    /**
+     * @brief Returns the scheduler whose worker is the calling thread.
+     * @return The scheduler or nullptr if the calling thread is not a worker.
+     */
+    [[nodiscard]] static work_stealing_scheduler* current() noexcept;
+
+    /**
+     * @brief Waits for every fiber to complete, then stops and joins the workers.
+     * Exceptions of the fibers that were not collected by `wait` are dropped.
+     */
+    ~work_stealing_scheduler() noexcept override;
+
+    /**
+     * @brief Spawns a new fiber running the routine.
+     * When called from a worker, the fiber is pushed to that worker's deque.
+     *
+     * @param routine The routine of the fiber.
+     * @throws invalid_argument_error if the input routine is nullptr.
+     */
+    void spawn(fiber::routine_t routine) override;
+
+    /**
+     * @brief Blocks the calling thread until every spawned fiber has completed.
+     * @rethrows the first exception a fiber finished with since the last call.
+     * @throws wait_from_worker if called from a worker thread of this scheduler.
+     */
+    void wait();
+
+    /**
+     * @brief Returns the number of worker threads.
+     * @return The number of workers.
+     */
+    [[nodiscard]] std::size_t workers() const noexcept;
+
+    void schedule(fiber& f) override;
+
+    void reschedule(fiber& f) override;
+
+    void schedule_next(fiber& f) override;
+
+    [[nodiscard]] void* home() noexcept override;
+
+    void schedule_home(fiber& f, void* home) override;
+
+private:
+    void run_worker(worker& w);
+
+    [[nodiscard]] fiber* take(worker& w);
+
+    [[nodiscard]] fiber* take_injected();
+
+    [[nodiscard]] static fiber* take_inbox(worker& w);
+
+    [[nodiscard]] fiber* steal(worker& w);
+
+    [[nodiscard]] bool has_work(const worker& self) const noexcept;
+
+    /**
+     * @brief Spins for a while, then puts the worker to sleep until new work arrives.
+     * @param w The worker.
+     * @return `false` if the scheduler is stopping.
+     */
+    bool idle(worker& w);
+
+    void inject(fiber& f);
+
+    /**
+     * @brief Wakes a sleeping worker, if any, for work that any worker can take.
+     */
+    void notify();
+
+    /**
+     * @brief Wakes the worker if it is asleep.
+     * @return `true` if the worker was asleep.
+     */
+    bool wake(worker& w);
+
+    void complete(fiber* f) noexcept;
+
+    [[nodiscard]] worker* local_worker() const noexcept;
+
+    const std::size_t _stack_size;
+    std::vector<std::unique_ptr<worker>> _workers;
+
+    std::mutex _inject_mutex;
+    std::deque<fiber*> _injected;
+    std::atomic<std::size_t> _injected_size {0};
+
+    std::atomic<std::size_t> _sleepers {0};
+    std::atomic<bool> _stopping {false};
+
+    alignas(cache_line_size) std::atomic<std::size_t> _live {0};
+    std::mutex _done_mutex;
+    std::condition_variable _done_cv;
+    std::exception_ptr _exception;
+};
+
+} // namespace cortex
+
+#endif
@@ -0,0 +1,31 @@
+#include <cortex/await.hpp>
+
+namespace cortex::detail {
+
+namespace {
+
+void start_suspension(void* arg) {
+    auto* s = static_cast<fiber_suspension*>(arg);
+    // The suspension dies with the wait of its fiber, which may end as soon as the awaitable resumes the wakeup.
+    fiber* owner = s->owner;
+    try {
+        if (s->start(*s)) {
+            return;
+        }
+    } catch (...) {
+        s->exception = std::current_exception();
+    }
+    owner->wake();
+}
+
+} // namespace
+
+fiber_wakeup fiber_wakeup::create([[maybe_unused]] fiber& owner) {
+    co_return;
+}
+
+void suspend_fiber(fiber_suspension& s) {
+    s.owner->park(&start_suspension, &s);
+}
+
+} // namespace cortex::detail
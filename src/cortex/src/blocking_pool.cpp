@@ -0,0 +1,87 @@
+#include <cortex/blocking_pool.hpp>
+
+namespace cortex {
+
+blocking_pool::blocking_pool(std::size_t threads) {
+    _threads.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        _threads.emplace_back([this] { work(); });
+    }
+}
+
+std::unique_ptr<blocking_pool> blocking_pool::create(std::size_t threads) {
+    if (threads == 0) {
+        throw invalid_argument_error("The number of threads is zero.");
+    }
+
+    return std::unique_ptr<blocking_pool>(new blocking_pool(threads));
+}
+
+blocking_pool& blocking_pool::shared() {
+    static const std::unique_ptr<blocking_pool> pool = create();
+    return *pool;
+}
+
+blocking_pool::~blocking_pool() noexcept {
+    {
+        std::lock_guard lock(_mutex);
+        _stopping = true;
+    }
+    _ready.notify_all();
+
+    for (auto& t : _threads) {
+        t.join();
+    }
+}
+
+void blocking_pool::run(job& j) {
+    fiber::cancellation_point();
+    fiber* self = fiber::current();
+    j.owner = self;
+    j.home = self->scheduler().home();
+    j.pool = this;
+
+    self->park(&publish, &j);
+}
+
+void blocking_pool::publish(void* j) {
+    auto* self = static_cast<job*>(j);
+    blocking_pool& pool = *self->pool;
+    {
+        std::lock_guard lock(pool._mutex);
+        if (pool._tail != nullptr) {
+            pool._tail->next = self;
+        } else {
+            pool._head = self;
+        }
+        pool._tail = self;
+    }
+    pool._ready.notify_one();
+}
+
+void blocking_pool::work() {
+    while (true) {
+        job* j = nullptr;
+        {
+            std::unique_lock lock(_mutex);
+            _ready.wait(lock, [this] { return _head != nullptr || _stopping; });
+            if (_head == nullptr) {
+                return;
+            }
+
+            j = _head;
+            _head = j->next;
+            if (_head == nullptr) {
+                _tail = nullptr;
+            }
+        }
+
+        j->execute(*j);
+
+        // The job dies with the wait of its fiber.
+        fiber* owner = j->owner;
+        owner->scheduler().schedule_home(*owner, j->home);
+    }
+}
+
+} // namespace cortex
@@ -0,0 +1,262 @@
+#include <cortex/channel.hpp>
+#include <cortex/random.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <mutex>
+
+namespace cortex::detail {
+
+namespace {
+
+thread_local std::uint64_t select_seed = 0x9E3779B97F4A7C15ULL;
+
+/// Claimed by the cancellation of the fiber, which fires no case.
+constexpr std::size_t select_cancelled = select_none - 1;
+
+/// Case to look at first, so that a ready case early in the list cannot starve the others.
+std::size_t first_case(std::size_t count) noexcept {
+    if (count == 1) {
+        return 0;
+    }
+
+    return next_random(select_seed) % count;
+}
+
+void lock_all(std::span<channel_core* const> locks) noexcept {
+    for (channel_core* core : locks) {
+        core->lock.lock();
+    }
+}
+
+void unlock_all(std::span<channel_core* const> locks) noexcept {
+    for (channel_core* core : locks) {
+        core->lock.unlock();
+    }
+}
+
+void release_all(void* locks) {
+    unlock_all(*static_cast<std::span<channel_core* const>*>(locks));
+}
+
+/// A parked `select`, for a cancellation to claim.
+struct select_wait {
+    std::span<channel_core* const> locks;
+    select_state& state;
+};
+
+bool unlink(void* arg) noexcept {
+    auto* w = static_cast<select_wait*>(arg);
+    lock_all(w->locks);
+    const bool claimed = w->state.claim(select_cancelled);
+    unlock_all(w->locks);
+    return claimed;
+}
+
+/// Every lock is held.
+std::size_t complete_any(std::span<select_case* const> cases,
+                         std::size_t first,
+                         const select_state* self,
+                         fiber*& woken) {
+    for (std::size_t i = 0; i < cases.size(); ++i) {
+        const std::size_t index = (first + i) % cases.size();
+        if (cases[index]->try_complete(self, woken)) {
+            return index;
+        }
+    }
+    return select_none;
+}
+
+void dequeue_all(std::span<select_case* const> cases, std::span<channel_waiter> waiters) noexcept {
+    for (std::size_t i = 0; i < cases.size(); ++i) {
+        cases[i]->dequeue(waiters[i]);
+    }
+}
+
+} // namespace
+
+void waiter_list::push_back(channel_waiter& w) noexcept {
+    w.prev = _tail;
+    w.next = nullptr;
+    w.linked = true;
+
+    if (_tail == nullptr) {
+        _head = &w;
+    } else {
+        _tail->next = &w;
+    }
+    _tail = &w;
+
+    _size.fetch_add(1, std::memory_order_seq_cst);
+}
+
+void waiter_list::remove(channel_waiter& w) noexcept {
+    if (!w.linked) {
+        return;
+    }
+
+    if (w.prev == nullptr) {
+        _head = w.next;
+    } else {
+        w.prev->next = w.next;
+    }
+
+    if (w.next == nullptr) {
+        _tail = w.prev;
+    } else {
+        w.next->prev = w.prev;
+    }
+
+    w.prev = nullptr;
+    w.next = nullptr;
+    w.linked = false;
+    _size.fetch_sub(1, std::memory_order_relaxed);
+}
+
+channel_waiter* waiter_list::claim(const select_state* exclude) noexcept {
+    channel_waiter* w = _head;
+    while (w != nullptr) {
+        channel_waiter* next = w->next;
+        if (w->state != exclude) {
+            remove(*w);
+            if (w->state->claim(w->index)) {
+                return w;
+            }
+        }
+        w = next;
+    }
+    return nullptr;
+}
+
+bool waiter_list::has_waiters() const noexcept {
+    return _size.load(std::memory_order_seq_cst) != 0;
+}
+
+void channel_core::close() {
+    channel_waiter* woken = nullptr;
+    {
+        std::lock_guard guard(lock);
+        if (closed.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+
+        for (waiter_list* list : {&senders, &receivers}) {
+            while (channel_waiter* w = list->claim(nullptr)) {
+                w->next = woken;
+                woken = w;
+            }
+        }
+    }
+
+    while (woken != nullptr) {
+        // Read the link before waking, the node dies with the fiber's wait.
+        channel_waiter* next = woken->next;
+        woken->state->owner->wake();
+        woken = next;
+    }
+}
+
+void channel_core::notify(waiter_list& list) {
+    fiber* woken = nullptr;
+    {
+        std::lock_guard guard(lock);
+        if (channel_waiter* w = list.claim(nullptr); w != nullptr) {
+            woken = w->state->owner;
+        }
+    }
+
+    if (woken != nullptr) {
+        woken->wake_next();
+    }
+}
+
+std::size_t run_select(std::span<select_case* const> cases,
+                       std::span<channel_core*> locks,
+                       std::span<channel_waiter> waiters,
+                       bool block) {
+    if (block) {
+        fiber::cancellation_point();
+    }
+
+    // Locks are always taken in address order, a channel appearing in several cases is locked once.
+    std::transform(cases.begin(), cases.end(), locks.begin(), [](select_case* c) { return &c->core(); });
+    std::sort(locks.begin(), locks.end());
+    std::span<channel_core* const> held(locks.begin(), std::unique(locks.begin(), locks.end()));
+
+    const std::size_t first = first_case(cases.size());
+    fiber* self = fiber::current();
+
+    while (true) {
+        fiber* woken = nullptr;
+        std::size_t fired = select_none;
+
+        lock_all(held);
+        try {
+            fired = complete_any(cases, first, nullptr, woken);
+        } catch (...) {
+            unlock_all(held);
+            throw;
+        }
+
+        if (fired == select_none && block) {
+            if (self == nullptr) {
+                unlock_all(held);
+                throw fiber::not_in_fiber("Unable to wait for a channel outside of a fiber.");
+            }
+
+            select_state state(self);
+            for (std::size_t i = 0; i < cases.size(); ++i) {
+                waiters[i] = channel_waiter {};
+                waiters[i].state = &state;
+                waiters[i].index = i;
+                cases[i]->enqueue(waiters[i]);
+            }
+
+            // Buffered channels change without their lock. Pairs with the fence after a lock-free push or pop:
+            // either that side sees the waiters or this second look sees its value.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            try {
+                fired = complete_any(cases, first, &state, woken);
+            } catch (...) {
+                dequeue_all(cases, waiters);
+                unlock_all(held);
+                throw;
+            }
+
+            if (fired == select_none) {
+                // Nobody can claim the waiters before the locks are released by the resuming thread.
+                select_wait w {held, state};
+                fiber::interruption wait {&unlink, &w};
+                self->park(&release_all, &held, wait);
+
+                lock_all(held);
+                dequeue_all(cases, waiters);
+                unlock_all(held);
+
+                if (wait.interrupted) {
+                    fiber::cancellation_point();
+                    continue;
+                }
+
+                const std::size_t index = state.fired.load(std::memory_order_acquire);
+                if (waiters[index].completed) {
+                    return index;
+                }
+
+                // Woken up by a buffered channel or by `close`, the value may already be gone: look again.
+                continue;
+            }
+
+            dequeue_all(cases, waiters);
+        }
+        unlock_all(held);
+
+        if (woken != nullptr) {
+            woken->wake_next();
+        }
+        return fired;
+    }
+}
+
+} // namespace cortex::detail
@@ -1,6 +1,7 @@
 #include <cortex/coroutine.hpp>
 
 #include <cassert>
+#include <utility>
 
 namespace cortex {
 
@@ -44,7 +45,25 @@ void coroutine::suspend() {
         throw suspend_on_not_started_coroutine("Unable to suspend not started coroutine.");
     }
 
+    _cancellation.unwind_if_requested(*_suspender);
     _suspender->suspend();
+    _cancellation.unwind_if_requested(*_suspender);
+}
+
+void coroutine::suspend_self([[maybe_unused]] api::suspendable& suspender) {
+    suspend();
+}
+
+void coroutine::cancel() noexcept {
+    _cancellation.request();
+}
+
+void coroutine::cancel_on(std::stop_token token) {
+    _cancellation.bind(std::move(token));
+}
+
+bool coroutine::is_cancelled() const noexcept {
+    return _cancellation.is_requested();
 }
 
 bool coroutine::is_completed() const {
@@ -53,7 +72,13 @@ bool coroutine::is_completed() const {
 
 void coroutine::run(api::suspendable& suspender) {
     _suspender = &suspender;
-    _routine->run_routine();
+    try {
+        _routine->run_routine();
+    } catch (const forced_unwind&) {
+        // Cancelled or destroyed while suspended, the stack is unwound by now.
+        _completed = true;
+        throw;
+    }
     _completed = true;
 }
 
@@ -1,5 +1,10 @@
 #include <cortex/execution.hpp>
 
+#include <cortex/migration.hpp>
+#include <cortex/watchdog.hpp>
+
+#include <utility>
+
 namespace cortex {
 
 namespace {
@@ -10,19 +15,50 @@ machine::transfer_t unwind(machine::transfer_t transfer) {
 }
 
 } // namespace aux
+
+/// Hints the processor to load the cache line holding an address, without faulting if it is not mapped.
+inline void prefetch_line(const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#else
+    static_cast<void>(address);
+#endif
+}
+
+thread_local detail::switch_state current_state;
+
 } // namespace
 
+CORTEX_TLS_ACCESSOR execution_record* execution_record::current() noexcept {
+    return current_state.record.load(std::memory_order_relaxed);
+}
+
+CORTEX_TLS_ACCESSOR execution_record* execution_record::exchange_current(execution_record* record) noexcept {
+    detail::switch_state& state = current_state;
+    execution_record* prev = state.record.load(std::memory_order_relaxed);
+    state.record.store(record, std::memory_order_relaxed);
+    // All a switch pays for a running watchdog: a store next to the record, which the watchdog times the threads by.
+    if (detail::watchdog_enabled.load(std::memory_order_relaxed)) {
+        if (!state.registered) {
+            state.registered = detail::register_thread(state);
+        }
+        state.switches.store(state.switches.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+    return prev;
+}
+
 execution::~execution() noexcept {
     if (_context != nullptr) {
+        // The destructors run by the unwinding see the execution as the current one.
+        execution_record* prev = execution_record::exchange_current(_record);
         [[maybe_unused]] auto res = machine::ontop_context(std::exchange(_context, nullptr), nullptr, aux::unwind);
+        execution_record::exchange_current(prev);
     }
 }
 
 void execution::resume() {
     assert(_context);
-
-    machine::transfer_t transfer = machine::jump_to_context(_context, nullptr);
-
+    machine::transfer_t transfer = detail::resume_context(_context, nullptr, *_record);
     _context = transfer.fctx;
 
     if (transfer.data != nullptr) { // Exception is happened.
@@ -30,7 +66,51 @@ void execution::resume() {
     }
 }
 
-execution::execution(machine::context_t context)
-    : _context(context) {}
+void execution::resume_batch(std::span<execution* const> batch) {
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        // Two stages, so that reading where the lines of the next execution are does not miss either: its handle was
+        // prefetched one resume earlier, its lines load while this one runs.
+        if (i + 2 < batch.size()) {
+            prefetch_line(batch[i + 2]);
+        }
+        if (i + 1 < batch.size()) {
+            batch[i + 1]->prefetch();
+        }
+        batch[i]->resume();
+    }
+}
+
+void execution::prefetch() const noexcept {
+    // The switch pops the saved registers and the return address, which take a little more than a line.
+    const auto* sp = static_cast<const char*>(_context);
+    prefetch_line(sp);
+    prefetch_line(sp + cache_line_size);
+    // The hook, and the flow, suspender, time slice and pinning fields the resume reads and writes on the line after.
+    const auto* record = reinterpret_cast<const char*>(_record);
+    prefetch_line(record);
+    prefetch_line(record + cache_line_size);
+}
+
+execution_hook& execution::hook() noexcept {
+    return _record->hook;
+}
+
+machine::transfer_t detail::resume_context(machine::context_t context, void* data, execution_record& record) {
+#if CORTEX_MIGRATION_CHECKS
+    migration::detail::check_resume(record);
+#endif
+
+    // A new time slice, measured from the first `maybe_yield` of the execution.
+    record.slice_start = 0;
+
+    execution_record* prev = execution_record::exchange_current(&record);
+    const machine::transfer_t transfer = machine::jump_to_context(context, data);
+    execution_record::exchange_current(prev);
+    return transfer;
+}
+
+execution::execution(machine::context_t context, execution_record* record)
+    : _context(context)
+    , _record(record) {}
 
 } // namespace cortex
@@ -0,0 +1,211 @@
+#include <cortex/fiber.hpp>
+
+#include <cortex/migration.hpp>
+
+#include <cassert>
+#include <exception>
+#include <thread>
+#include <utility>
+
+namespace cortex {
+
+namespace {
+
+thread_local fiber* current_fiber = nullptr;
+
+void reschedule_self(void* arg) {
+    auto* f = static_cast<fiber*>(arg);
+    f->scheduler().reschedule(*f);
+}
+
+/// Registered in place of a wait while it is being interrupted, the wait stays alive until it is replaced.
+fiber::interruption interrupting;
+
+} // namespace
+
+fiber::fiber(api::scheduler& sched, stack_allocator alloc, routine_t&& routine)
+    : _scheduler(&sched)
+    , _routine(std::move(routine))
+    , _cancellation(&fiber::interrupt, this)
+    , _exec(execution::create_with_raw_flow(std::move(alloc), this)) {}
+
+std::unique_ptr<fiber> fiber::make(api::scheduler& sched, stack_allocator alloc, routine_t routine) {
+    if (routine == nullptr) {
+        throw invalid_argument_error("The input routine is nullptr.");
+    }
+
+    return std::unique_ptr<fiber>(new fiber(sched, std::move(alloc), std::move(routine)));
+}
+
+CORTEX_TLS_ACCESSOR fiber* fiber::current() noexcept {
+    return current_fiber;
+}
+
+void fiber::yield() {
+    fiber* self = current();
+    if (self == nullptr) {
+        throw not_in_fiber("Unable to yield outside of a fiber.");
+    }
+
+    cancellation_point();
+    self->park(&reschedule_self, self);
+    cancellation_point();
+}
+
+void fiber::cancellation_point() {
+    if (fiber* self = current(); self != nullptr) {
+        self->_cancellation.unwind_if_requested(*self->_suspender);
+    }
+}
+
+void fiber::suspend_self([[maybe_unused]] api::suspendable& suspender) {
+    // A fiber that merely suspended would never be scheduled again.
+    yield();
+}
+
+bool fiber::resume() {
+    assert(!_completed);
+
+    fiber* prev = std::exchange(current_fiber, this);
+    try {
+        _exec.resume();
+    } catch (...) {
+        _exception = std::current_exception();
+        _completed = true;
+    }
+    current_fiber = prev;
+
+    if (_completed) {
+        return true;
+    }
+
+    // Claimed while the fiber can not be woken yet, so it is kept alive until the interruption is finished.
+    interruption* wait = std::exchange(_interrupt_on_switch, false) ? claim_interruption() : nullptr;
+
+    // The fiber is switched out, from now on it may be picked up by another thread.
+    if (unlock_t unlock = std::exchange(_unlock, nullptr); unlock != nullptr) {
+        unlock(_unlock_arg);
+    }
+    if (wait != nullptr) {
+        finish_interruption(*wait);
+    }
+    return false;
+}
+
+void fiber::park(unlock_t unlock, void* arg) {
+    assert(current() == this);
+    assert(_suspender != nullptr);
+
+    _unlock = unlock;
+    _unlock_arg = arg;
+    _suspender->suspend();
+}
+
+void fiber::park(unlock_t unlock, void* arg, interruption& wait) {
+    wait.interrupted = false;
+    if (std::uncaught_exceptions() != 0) {
+        // Cut short again and again, as the unwinding in progress ignores the cancellation points.
+        park(unlock, arg);
+        return;
+    }
+
+    _interruption.store(&wait, std::memory_order_seq_cst);
+    // `cancel` requests first and looks for a wait then, so at least one of them sees the other. If the request may
+    // have come too early to see the wait, the resuming thread interrupts it once the fiber is switched out.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    _interrupt_on_switch = _cancellation.is_requested();
+    park(unlock, arg);
+
+    // An interruption that lost the race against the waker still refers to `wait` until it lets go.
+    interruption* expected = &wait;
+    if (!_interruption.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel)) {
+        while (_interruption.load(std::memory_order_acquire) != nullptr) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void fiber::wake() {
+    _scheduler->schedule(*this);
+}
+
+void fiber::wake_next() {
+    _scheduler->schedule_next(*this);
+}
+
+void fiber::cancel() noexcept {
+    _cancellation.request();
+}
+
+void fiber::cancel_on(std::stop_token token) {
+    _cancellation.bind(std::move(token));
+}
+
+void fiber::interrupt(void* self) noexcept {
+    auto* f = static_cast<fiber*>(self);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (interruption* wait = f->claim_interruption(); wait != nullptr) {
+        f->finish_interruption(*wait);
+    }
+}
+
+fiber::interruption* fiber::claim_interruption() noexcept {
+    interruption* wait = _interruption.load(std::memory_order_acquire);
+    if (wait == nullptr || wait == &interrupting ||
+        !_interruption.compare_exchange_strong(wait, &interrupting, std::memory_order_acq_rel)) {
+        return nullptr;
+    }
+    return wait;
+}
+
+void fiber::finish_interruption(interruption& wait) noexcept {
+    const bool unlinked = wait.unlink(wait.arg);
+    wait.interrupted = unlinked;
+    // Let go of the wait: unless it was unlinked, the fiber may be back and leave it right away.
+    _interruption.store(nullptr, std::memory_order_release);
+    if (unlinked) {
+        wake();
+    }
+}
+
+bool fiber::is_cancelled() const noexcept {
+    return _cancellation.is_requested();
+}
+
+bool fiber::is_completed() const noexcept {
+    return _completed;
+}
+
+std::exception_ptr fiber::exception() const noexcept {
+    return _exception;
+}
+
+api::scheduler& fiber::scheduler() const noexcept {
+    return *_scheduler;
+}
+
+fiber*& fiber::link() noexcept {
+    return _link;
+}
+
+void fiber::prefetch() const noexcept {
+    _exec.prefetch();
+}
+
+execution_hook& fiber::hook() noexcept {
+    return _exec.hook();
+}
+
+void fiber::run(api::suspendable& suspender) {
+    _suspender = &suspender;
+    try {
+        _routine();
+    } catch (const forced_unwind&) {
+        // Cancelled or destroyed while parked, the stack is unwound by now.
+        _completed = true;
+        throw;
+    }
+    _completed = true;
+}
+
+} // namespace cortex
@@ -0,0 +1,34 @@
+#include <cortex/error.hpp>
+#include <cortex/fiber_barrier.hpp>
+
+namespace cortex {
+
+fiber_barrier::fiber_barrier(std::size_t parties)
+    : _parties(parties) {
+    if (parties == 0) {
+        throw invalid_argument_error("The number of parties is zero.");
+    }
+}
+
+bool fiber_barrier::arrive_and_wait() {
+    fiber::cancellation_point();
+    _lock.lock();
+    if (++_arrived < _parties) {
+        if (fiber::current() == nullptr) {
+            --_arrived;
+            _lock.unlock();
+            throw fiber::not_in_fiber("Unable to wait outside of a fiber.");
+        }
+        _waiters.wait(_lock);
+        return false;
+    }
+
+    _arrived = 0;
+    wait_queue::node* waiters = _waiters.take_all();
+    _lock.unlock();
+
+    wait_queue::wake_all(waiters);
+    return true;
+}
+
+} // namespace cortex
@@ -0,0 +1,117 @@
+#include <cortex/fiber_condition_variable.hpp>
+
+#include <cassert>
+
+namespace cortex {
+
+void fiber_condition_variable::wait(std::unique_lock<fiber_mutex>& lock) {
+    assert(lock.owns_lock());
+
+    if (fiber::current() == nullptr) {
+        throw fiber::not_in_fiber("Unable to wait outside of a fiber.");
+    }
+
+    fiber::cancellation_point();
+
+    _lock.lock();
+    // A notifier needs `_lock`, so it can not slip in between releasing the mutex and parking.
+    lock.mutex()->unlock();
+    const bool woken = _waiters.wait_cancellable(_lock);
+
+    // Unwinds with the mutex locked, as the owner of `lock` expects.
+    lock.mutex()->lock();
+    if (!woken) {
+        fiber::cancellation_point();
+    }
+}
+
+namespace {
+
+/**
+ * @brief State of a timed wait, shared with its timer.
+ */
+struct timed_waiter {
+    spinlock& lock;
+    wait_queue& waiters;
+    wait_queue::node node;
+    /// Set under `lock` once the node is in `waiters`.
+    bool queued = false;
+    bool timed_out = false;
+};
+
+/// Runs on the thread of the timer service, the fiber is either not queued yet, still queued or already notified.
+void expire(void* arg) {
+    auto* w = static_cast<timed_waiter*>(arg);
+    fiber* woken = nullptr;
+
+    w->lock.lock();
+    if (!w->queued) {
+        w->timed_out = true;
+    } else if (w->waiters.remove(w->node)) {
+        w->timed_out = true;
+        woken = w->node.owner;
+    }
+    w->lock.unlock();
+
+    if (woken != nullptr) {
+        woken->wake();
+    }
+}
+
+} // namespace
+
+std::cv_status fiber_condition_variable::wait_until(std::unique_lock<fiber_mutex>& lock,
+                                                    timer_service& timers,
+                                                    timer_service::clock::time_point deadline) {
+    assert(lock.owns_lock());
+
+    fiber* self = fiber::current();
+    if (self == nullptr) {
+        throw fiber::not_in_fiber("Unable to wait outside of a fiber.");
+    }
+
+    fiber::cancellation_point();
+
+    timed_waiter w {_lock, _waiters, {self, nullptr}};
+    bool woken = true;
+    {
+        // Armed before `_lock` is taken, the timer callback takes `_lock` under the lock of the service.
+        timer_service::timeout t(timers, deadline, &expire, &w);
+
+        _lock.lock();
+        if (w.timed_out) {
+            _lock.unlock();
+            return std::cv_status::timeout;
+        }
+
+        w.queued = true;
+        lock.mutex()->unlock();
+        woken = _waiters.wait_cancellable(_lock, w.node);
+    }
+
+    lock.mutex()->lock();
+    if (!woken) {
+        fiber::cancellation_point();
+    }
+    return w.timed_out ? std::cv_status::timeout : std::cv_status::no_timeout;
+}
+
+void fiber_condition_variable::notify_one() {
+    _lock.lock();
+    fiber* next = _waiters.pop();
+    _lock.unlock();
+
+    if (next != nullptr) {
+        next->wake();
+    }
+}
+
+void fiber_condition_variable::notify_all() {
+    _lock.lock();
+    wait_queue::node* waiters = _waiters.take_all();
+    _lock.unlock();
+
+    wait_queue::wake_all(waiters);
+}
+
+} // namespace cortex
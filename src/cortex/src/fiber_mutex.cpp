@@ -0,0 +1,50 @@
+#include <cortex/fiber_mutex.hpp>
+
+namespace cortex {
+
+void fiber_mutex::lock() {
+    std::uint32_t expected = unlocked;
+    if (_state.compare_exchange_strong(expected, locked, std::memory_order_acquire, std::memory_order_relaxed)) {
+        return;
+    }
+
+    _lock.lock();
+    if (_state.exchange(contended, std::memory_order_acquire) == unlocked) {
+        // Released in the meantime, it is ours now.
+        if (_waiters.empty()) {
+            _state.store(locked, std::memory_order_relaxed);
+        }
+        _lock.unlock();
+        return;
+    }
+
+    // The owner hands the mutex over to us in `unlock`, there is nothing to retry after waking up.
+    _waiters.wait(_lock);
+}
+
+bool fiber_mutex::try_lock() noexcept {
+    std::uint32_t expected = unlocked;
+    return _state.compare_exchange_strong(expected, locked, std::memory_order_acquire, std::memory_order_relaxed);
+}
+
+void fiber_mutex::unlock() {
+    std::uint32_t expected = locked;
+    if (_state.compare_exchange_strong(expected, unlocked, std::memory_order_release, std::memory_order_relaxed)) {
+        return;
+    }
+
+    _lock.lock();
+    fiber* next = _waiters.pop();
+    if (next == nullptr) {
+        _state.store(unlocked, std::memory_order_release);
+    } else {
+        _state.store(_waiters.empty() ? locked : contended, std::memory_order_release);
+    }
+    _lock.unlock();
+
+    if (next != nullptr) {
+        next->wake();
+    }
+}
+
+} // namespace cortex
@@ -0,0 +1,232 @@
+#include <cortex/execution.hpp>
+#include <cortex/fiber_local.hpp>
+#include <cortex/fiber_pool.hpp>
+
+#include <utility>
+
+namespace cortex {
+
+namespace {
+
+/// The pool a worker fiber belongs to.
+fiber_local<const fiber_pool*> current_pool;
+
+} // namespace
+
+fiber_pool::fiber_pool(api::scheduler& sched, const options& opts)
+    : _scheduler(sched)
+    , _options(opts) {}
+
+std::unique_ptr<fiber_pool> fiber_pool::create(api::scheduler& sched, const options& opts) {
+    if (opts.max_workers == 0 || opts.max_workers < opts.min_workers) {
+        throw invalid_argument_error("The maximum number of workers is zero or lower than the minimum.");
+    }
+
+    // Spawned once the pool is owned, so that its destructor lets the first workers go if one fails to spawn.
+    auto pool = std::unique_ptr<fiber_pool>(new fiber_pool(sched, opts));
+    for (std::size_t i = 0; i < opts.min_workers; ++i) {
+        {
+            const std::lock_guard lock(pool->_lock);
+            ++pool->_workers;
+            ++pool->_starting;
+        }
+        pool->add_worker();
+    }
+    return pool;
+}
+
+std::unique_ptr<fiber_pool> fiber_pool::create(api::scheduler& sched) {
+    return create(sched, options {});
+}
+
+fiber_pool::~fiber_pool() noexcept {
+    std::unique_lock done(_done_mutex);
+    _done_cv.wait(done, [this] { return _pending.load(std::memory_order_acquire) == 0; });
+
+    _lock.lock();
+    _stopping = true;
+    _idle = 0;
+    wait_queue::node* idlers = _idlers.take_all();
+    const bool drained = _workers == 0;
+    _lock.unlock();
+
+    wait_queue::wake_all(idlers);
+    _done_cv.wait(done, [this, drained] {
+        // Set by the last worker under the lock of `done`, so it has let go of the pool by the time it is seen.
+        return drained || _drained;
+    });
+}
+
+void fiber_pool::spawn(task_t task) {
+    if (!task) {
+        throw invalid_argument_error("The task is empty.");
+    }
+
+    // Counted before it is queued, so that a worker finishing it can never see the count drop below zero.
+    _pending.fetch_add(1, std::memory_order_relaxed);
+    fiber* idler = nullptr;
+    bool grow = false;
+    std::size_t ticket = 0;
+    {
+        const std::lock_guard lock(_lock);
+        try {
+            _tasks.push_back(std::move(task));
+        } catch (...) {
+            _pending.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
+        ticket = _taken + _tasks.size() - 1;
+        idler = _idlers.pop();
+        if (idler != nullptr) {
+            --_idle;
+        } else if (_workers < _options.max_workers) {
+            ++_workers;
+            ++_starting;
+            grow = true;
+        }
+    }
+
+    if (idler != nullptr) {
+        idler->wake();
+    } else if (grow) {
+        try {
+            add_worker();
+        } catch (...) {
+            if (withdraw(ticket)) {
+                throw;
+            }
+        }
+    }
+    // Otherwise every worker is busy and one of them takes the task once it is done.
+}
+
+void fiber_pool::wait() {
+    if (is_worker()) {
+        throw wait_from_worker("Unable to wait for the pool from its own worker.");
+    }
+
+    std::unique_lock lock(_done_mutex);
+    _done_cv.wait(lock, [this] { return _pending.load(std::memory_order_acquire) == 0; });
+    if (_exception != nullptr) {
+        std::rethrow_exception(std::exchange(_exception, nullptr));
+    }
+}
+
+std::size_t fiber_pool::workers() const noexcept {
+    const std::lock_guard lock(_lock);
+    return _workers;
+}
+
+std::size_t fiber_pool::idle() const noexcept {
+    const std::lock_guard lock(_lock);
+    return _idle;
+}
+
+void fiber_pool::add_worker() {
+    try {
+        _scheduler.spawn([this] { run_worker(); });
+    } catch (...) {
+        const std::lock_guard lock(_lock);
+        --_workers;
+        --_starting;
+        throw;
+    }
+}
+
+bool fiber_pool::withdraw(std::size_t ticket) noexcept {
+    {
+        const std::lock_guard lock(_lock);
+        // A running worker only exits once the queue is empty, so it takes the task sooner or later.
+        if (ticket < _taken || _workers > _starting) {
+            return false;
+        }
+        // Emptied rather than erased, so that the tickets of the tasks queued behind it stay valid.
+        _tasks[ticket - _taken] = nullptr;
+    }
+    finish_task(nullptr);
+    return true;
+}
+
+void fiber_pool::run_worker() {
+    *current_pool = this;
+
+    _lock.lock();
+    --_starting;
+    while (true) {
+        if (!_tasks.empty()) {
+            task_t task = std::move(_tasks.front());
+            _tasks.pop_front();
+            ++_taken;
+            if (!task) {
+                // Withdrawn by a spawn that failed to start its worker.
+                continue;
+            }
+            _lock.unlock();
+
+            std::exception_ptr exception;
+            try {
+                task();
+            } catch (const forced_unwind&) {
+                // The worker itself was cancelled, its stack is gone with the task.
+                finish_task(nullptr);
+                _lock.lock();
+                retire_worker();
+                throw;
+            } catch (...) {
+                exception = std::current_exception();
+            }
+            // Released before the next task, which may wait a long time, together with the arena and the fiber-local
+            // values of the task, which shares the record of the worker.
+            task = nullptr;
+            execution_record* record = execution_record::current();
+            record->memory.reset();
+            record->locals.clear();
+            *current_pool = this;
+            finish_task(std::move(exception));
+
+            _lock.lock();
+            continue;
+        }
+
+        if (_stopping || (_workers > _options.min_workers && _idle >= _options.max_idle)) {
+            retire_worker();
+            return;
+        }
+
+        ++_idle;
+        _idlers.wait(_lock);
+        _lock.lock();
+    }
+}
+
+void fiber_pool::retire_worker() noexcept {
+    --_workers;
+    const bool last = _workers == 0 && _stopping;
+    _lock.unlock();
+
+    if (last) {
+        const std::lock_guard lock(_done_mutex);
+        _drained = true;
+        _done_cv.notify_all();
+    }
+}
+
+void fiber_pool::finish_task(std::exception_ptr exception) noexcept {
+    if (exception != nullptr) {
+        const std::lock_guard lock(_done_mutex);
+        if (_exception == nullptr) {
+            _exception = std::move(exception);
+        }
+    }
+
+    if (_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        const std::lock_guard lock(_done_mutex);
+        _done_cv.notify_all();
+    }
+}
+
+bool fiber_pool::is_worker() const noexcept {
+    return current_pool.has_value() && current_pool.get() == this;
+}
+
+} // namespace cortex
@@ -0,0 +1,69 @@
+#include <cortex/fiber_semaphore.hpp>
+
+#include <algorithm>
+
+namespace cortex {
+
+fiber_semaphore::fiber_semaphore(std::ptrdiff_t initial)
+    : _count(initial) {}
+
+void fiber_semaphore::acquire() {
+    if (fiber::current() == nullptr) {
+        // A thread can not be queued, it may only take a token that is already there.
+        if (try_acquire()) {
+            return;
+        }
+        throw fiber::not_in_fiber("Unable to wait outside of a fiber.");
+    }
+
+    fiber::cancellation_point();
+    if (_count.fetch_sub(1, std::memory_order_acquire) > 0) {
+        return;
+    }
+
+    // We are registered as a waiter in `_count`, a release from now on is meant for us.
+    _lock.lock();
+    if (_pending > 0) {
+        --_pending;
+        _lock.unlock();
+        return;
+    }
+
+    _waiters.wait(_lock);
+}
+
+bool fiber_semaphore::try_acquire() noexcept {
+    std::ptrdiff_t count = _count.load(std::memory_order_relaxed);
+    while (count > 0) {
+        if (_count.compare_exchange_weak(count, count - 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void fiber_semaphore::release(std::ptrdiff_t update) {
+    const std::ptrdiff_t before = _count.fetch_add(update, std::memory_order_release);
+    if (before >= 0) {
+        return;
+    }
+
+    // `-before` fibers are (about to be) waiting, hand a token to each of the first `update` ones.
+    std::ptrdiff_t to_wake = std::min(update, -before);
+    while (to_wake > 0) {
+        _lock.lock();
+        fiber* next = _waiters.pop();
+        if (next == nullptr) {
+            // The waiters are between `fetch_sub` and the queue, they pick their tokens up from `_pending`.
+            _pending += to_wake;
+            _lock.unlock();
+            return;
+        }
+        _lock.unlock();
+
+        next->wake();
+        --to_wake;
+    }
+}
+
+} // namespace cortex
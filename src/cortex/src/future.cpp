@@ -0,0 +1,102 @@
+#include <cortex/future.hpp>
+
+#include <mutex>
+#include <utility>
+
+namespace cortex::detail {
+
+void future_state_base::retain() noexcept {
+    _refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+void future_state_base::release() noexcept {
+    if (_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete this;
+    }
+}
+
+bool future_state_base::is_ready() const noexcept {
+    return _ready.load(std::memory_order_acquire);
+}
+
+void future_state_base::wait() {
+    if (is_ready()) {
+        return;
+    }
+
+    fiber::cancellation_point();
+
+    _lock.lock();
+    if (_ready.load(std::memory_order_relaxed)) {
+        _lock.unlock();
+        return;
+    }
+    // Released once this fiber is switched out, so `publish` cannot miss it.
+    if (!_waiters.wait_cancellable(_lock)) {
+        fiber::cancellation_point();
+    }
+}
+
+bool future_state_base::observe(observer& o) {
+    std::lock_guard lock(_lock);
+    if (_ready.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    o.next = _observers;
+    _observers = &o;
+    return true;
+}
+
+void future_state_base::set_exception(std::exception_ptr exception) {
+    claim();
+    _exception = std::move(exception);
+    publish();
+}
+
+void future_state_base::retrieve() {
+    std::lock_guard lock(_lock);
+    if (_retrieved) {
+        throw future_already_retrieved("The future was retrieved already.");
+    }
+    _retrieved = true;
+}
+
+void future_state_base::rethrow_if_failed() const {
+    if (_exception != nullptr) {
+        std::rethrow_exception(_exception);
+    }
+}
+
+void future_state_base::claim() {
+    std::lock_guard lock(_lock);
+    if (_claimed) {
+        throw promise_already_satisfied("The promise was satisfied already.");
+    }
+    _claimed = true;
+}
+
+void future_state_base::unclaim() noexcept {
+    std::lock_guard lock(_lock);
+    _claimed = false;
+}
+
+void future_state_base::publish() noexcept {
+    wait_queue::node* waiters = nullptr;
+    observer* observers = nullptr;
+    {
+        std::lock_guard lock(_lock);
+        _ready.store(true, std::memory_order_release);
+        waiters = _waiters.take_all();
+        observers = std::exchange(_observers, nullptr);
+    }
+
+    // The state stays alive, every waiter and every observer holds a reference.
+    wait_queue::wake_all(waiters);
+    while (observers != nullptr) {
+        observer* next = observers->next;
+        observers->notify(*observers);
+        observers = next;
+    }
+}
+
+} // namespace cortex::detail
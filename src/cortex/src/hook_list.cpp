@@ -0,0 +1,70 @@
+#include <cortex/hook_list.hpp>
+
+#include <cassert>
+
+namespace cortex {
+
+void hook_list::push_back(execution_hook& hook) noexcept {
+    assert(hook.next == nullptr && hook.prev == nullptr && _head != &hook);
+    hook.prev = _tail;
+    if (_tail != nullptr) {
+        _tail->next = &hook;
+    } else {
+        _head = &hook;
+    }
+    _tail = &hook;
+    ++_size;
+}
+
+void hook_list::push_front(execution_hook& hook) noexcept {
+    assert(hook.next == nullptr && hook.prev == nullptr && _head != &hook);
+    hook.next = _head;
+    if (_head != nullptr) {
+        _head->prev = &hook;
+    } else {
+        _tail = &hook;
+    }
+    _head = &hook;
+    ++_size;
+}
+
+execution_hook* hook_list::pop_front() noexcept {
+    execution_hook* hook = _head;
+    if (hook != nullptr) {
+        remove(*hook);
+    }
+    return hook;
+}
+
+void hook_list::remove(execution_hook& hook) noexcept {
+    assert(_size != 0);
+    if (hook.prev != nullptr) {
+        hook.prev->next = hook.next;
+    } else {
+        assert(_head == &hook);
+        _head = hook.next;
+    }
+    if (hook.next != nullptr) {
+        hook.next->prev = hook.prev;
+    } else {
+        assert(_tail == &hook);
+        _tail = hook.prev;
+    }
+    hook.next = nullptr;
+    hook.prev = nullptr;
+    --_size;
+}
+
+execution_hook* hook_list::front() const noexcept {
+    return _head;
+}
+
+bool hook_list::empty() const noexcept {
+    return _head == nullptr;
+}
+
+std::size_t hook_list::size() const noexcept {
+    return _size;
+}
+
+} // namespace cortex
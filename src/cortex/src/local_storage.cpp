@@ -0,0 +1,49 @@
+#include <cortex/local_storage.hpp>
+
+#include <cortex/execution.hpp>
+#include <cortex/migration.hpp>
+
+#include <atomic>
+#include <utility>
+
+namespace cortex {
+
+namespace {
+
+std::atomic<std::size_t> next_slot {0};
+
+CORTEX_TLS_ACCESSOR local_storage& thread_storage() noexcept {
+    thread_local local_storage storage;
+    return storage;
+}
+
+} // namespace
+
+local_storage::~local_storage() noexcept {
+    clear();
+}
+
+void local_storage::clear() noexcept {
+    for (auto it = _slots.rbegin(); it != _slots.rend(); ++it) {
+        if (it->value != nullptr) {
+            it->destroy(std::exchange(it->value, nullptr));
+        }
+    }
+}
+
+local_storage& local_storage::current() noexcept {
+    execution_record* record = execution_record::current();
+    return record != nullptr ? record->locals : thread_storage();
+}
+
+std::size_t local_storage::allocate_slot() {
+    std::size_t slot = next_slot.load(std::memory_order_relaxed);
+    do {
+        if (slot == capacity) {
+            throw no_free_slot("Every fiber-local slot is taken.");
+        }
+    } while (!next_slot.compare_exchange_weak(slot, slot + 1, std::memory_order_relaxed));
+    return slot;
+}
+
+} // namespace cortex
@@ -0,0 +1,59 @@
+#include <cortex/migration.hpp>
+
+#include <cortex/execution.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+namespace cortex::migration {
+
+namespace {
+
+void abort_on_violation(const char* message) {
+    std::fputs(message, stderr);
+    std::fputc('\n', stderr);
+    std::abort();
+}
+
+std::atomic<violation_handler_t> violation_handler {&abort_on_violation};
+
+} // namespace
+
+violation_handler_t set_violation_handler(violation_handler_t handler) noexcept {
+    return violation_handler.exchange(handler != nullptr ? handler : &abort_on_violation);
+}
+
+CORTEX_TLS_ACCESSOR std::thread::id this_thread_id() noexcept {
+    return std::this_thread::get_id();
+}
+
+bool checks_enabled() noexcept {
+    return CORTEX_MIGRATION_CHECKS != 0;
+}
+
+thread_affinity_guard::thread_affinity_guard() noexcept
+    : _record(execution_record::current()) {
+    if (_record != nullptr && _record->pinned++ == 0) {
+        _record->pinned_thread = this_thread_id();
+    }
+}
+
+thread_affinity_guard::~thread_affinity_guard() noexcept {
+    if (_record != nullptr) {
+        --_record->pinned;
+    }
+}
+
+namespace detail {
+
+void check_resume(const execution_record& record) noexcept {
+    if (record.pinned != 0 && record.pinned_thread != this_thread_id()) {
+        violation_handler.load()("An execution holding thread-affine state was resumed on another thread.");
+    }
+}
+
+} // namespace detail
+
+} // namespace cortex::migration
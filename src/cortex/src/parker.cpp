@@ -0,0 +1,48 @@
+#include <cortex/parker.hpp>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace cortex {
+
+namespace {
+
+#if defined(__linux__)
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "The futex word must be a plain integer.");
+
+std::uint32_t* futex_word(std::atomic<std::uint32_t>& state) noexcept {
+    return reinterpret_cast<std::uint32_t*>(&state);
+}
+#endif
+
+} // namespace
+
+void parker::wait() noexcept {
+    // Futex waits return spuriously and on signals, only a claim by a waker ends the wait.
+    while (_state.load(std::memory_order_acquire) == parked) {
+#if defined(__linux__)
+        syscall(SYS_futex, futex_word(_state), FUTEX_WAIT_PRIVATE, parked, nullptr, nullptr, 0);
+#else
+        _state.wait(parked, std::memory_order_acquire);
+#endif
+    }
+}
+
+bool parker::unpark() noexcept {
+    if (_state.load(std::memory_order_seq_cst) != parked ||
+        _state.exchange(running, std::memory_order_seq_cst) != parked) {
+        return false;
+    }
+
+#if defined(__linux__)
+    syscall(SYS_futex, futex_word(_state), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+    _state.notify_one();
+#endif
+    return true;
+}
+
+} // namespace cortex
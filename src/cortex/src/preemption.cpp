@@ -0,0 +1,153 @@
+#include <cortex/preemption.hpp>
+
+#include <cortex/execution.hpp>
+#include <cortex/this_coroutine.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define CORTEX_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CORTEX_HAS_TSC 1
+#else
+#define CORTEX_HAS_TSC 0
+#endif
+
+namespace cortex {
+
+namespace {
+
+/// Number of timer ticks in a slice, the timer ticks twice per slice.
+constexpr std::uint64_t timer_ticks_per_slice = 3;
+
+std::atomic<std::int64_t> slice_ns {preemption::default_time_slice.count()};
+
+/// Length of a slice in clock ticks, zero until it is computed from `slice_ns`.
+std::atomic<std::uint64_t> slice_ticks {0};
+
+std::atomic<bool> timer_running {false};
+
+/// Counter of the running timer. Starts at one, zero means that the slice has not started.
+std::atomic<std::uint64_t> timer_ticks {1};
+
+std::uint64_t read_clock() noexcept {
+#if CORTEX_HAS_TSC
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+/// Clock ticks per nanosecond, measured once against the steady clock.
+double clock_frequency() noexcept {
+#if CORTEX_HAS_TSC
+    static const double frequency = [] {
+        const auto start = std::chrono::steady_clock::now();
+        const std::uint64_t start_ticks = __rdtsc();
+        auto now = start;
+        while (now - start < std::chrono::milliseconds(1)) {
+            now = std::chrono::steady_clock::now();
+        }
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count();
+        return static_cast<double>(__rdtsc() - start_ticks) / static_cast<double>(elapsed);
+    }();
+    return frequency;
+#else
+    using period = std::chrono::steady_clock::period;
+    return static_cast<double>(period::den) / (static_cast<double>(period::num) * 1e9);
+#endif
+}
+
+std::uint64_t clock_slice() noexcept {
+    std::uint64_t ticks = slice_ticks.load(std::memory_order_relaxed);
+    if (ticks == 0) {
+        ticks = static_cast<std::uint64_t>(static_cast<double>(slice_ns.load(std::memory_order_relaxed))
+                                           * clock_frequency());
+        slice_ticks.store(ticks, std::memory_order_relaxed);
+    }
+    return ticks;
+}
+
+} // namespace
+
+void maybe_yield() {
+    execution_record* record = execution_record::current();
+    if (record == nullptr || record->suspender == nullptr) {
+        return;
+    }
+
+    const bool timed = timer_running.load(std::memory_order_relaxed);
+    const std::uint64_t now = timed ? timer_ticks.load(std::memory_order_relaxed) : read_clock();
+    if (record->slice_start == 0) {
+        record->slice_start = now;
+        return;
+    }
+
+    // Unsigned, so a clock that went backwards, e.g. when the timer was started mid-slice, ends the slice early.
+    if (now - record->slice_start < (timed ? timer_ticks_per_slice : clock_slice())) {
+        return;
+    }
+
+    // The resume starts a new slice.
+    this_coroutine::suspend();
+}
+
+namespace preemption {
+
+void set_time_slice(std::chrono::nanoseconds slice) {
+    if (slice <= std::chrono::nanoseconds::zero()) {
+        throw invalid_argument_error("The time slice is not positive.");
+    }
+
+    slice_ns.store(slice.count(), std::memory_order_relaxed);
+    slice_ticks.store(0, std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds time_slice() noexcept {
+    return std::chrono::nanoseconds(slice_ns.load(std::memory_order_relaxed));
+}
+
+timer::timer()
+    : _thread([this] { run(); }) {}
+
+std::unique_ptr<timer> timer::create() {
+    if (timer_running.exchange(true)) {
+        throw already_running("A preemption timer is already running.");
+    }
+
+    try {
+        return std::unique_ptr<timer>(new timer());
+    } catch (...) {
+        timer_running.store(false);
+        throw;
+    }
+}
+
+timer::~timer() noexcept {
+    {
+        std::lock_guard lock(_mutex);
+        _stopping = true;
+    }
+    _stop_cv.notify_one();
+    _thread.join();
+
+    timer_running.store(false);
+}
+
+void timer::run() {
+    std::unique_lock lock(_mutex);
+    while (!_stopping) {
+        const auto period = time_slice() / static_cast<std::int64_t>(timer_ticks_per_slice - 1);
+        if (_stop_cv.wait_for(lock, period, [this] { return _stopping; })) {
+            break;
+        }
+        timer_ticks.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace preemption
+
+} // namespace cortex
@@ -0,0 +1,221 @@
+#include <cortex/migration.hpp>
+#include <cortex/priority_scheduler.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace cortex {
+
+namespace {
+
+thread_local priority_scheduler* current_scheduler = nullptr;
+
+/// Heap order of the run queues: the top is the earliest deadline, then the earliest to become runnable.
+struct later {
+    template <typename Entry>
+    bool operator()(const Entry& lhs, const Entry& rhs) const noexcept {
+        if (lhs.deadline != rhs.deadline) {
+            return lhs.deadline > rhs.deadline;
+        }
+        return lhs.sequence > rhs.sequence;
+    }
+};
+
+} // namespace
+
+priority_scheduler::priority_scheduler(std::size_t workers, const options& opts)
+    : _options(opts) {
+    _workers.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+        _workers.emplace_back([this] { run_worker(); });
+    }
+}
+
+std::unique_ptr<priority_scheduler> priority_scheduler::create(std::size_t workers, const options& opts) {
+    if (workers == 0) {
+        throw invalid_argument_error("The number of workers is zero.");
+    }
+    if (opts.starvation_limit <= clock::duration::zero()) {
+        throw invalid_argument_error("The starvation limit is not positive.");
+    }
+
+    return std::unique_ptr<priority_scheduler>(new priority_scheduler(workers, opts));
+}
+
+std::unique_ptr<priority_scheduler> priority_scheduler::create(std::size_t workers) {
+    return create(workers, options {});
+}
+
+CORTEX_TLS_ACCESSOR priority_scheduler* priority_scheduler::current() noexcept {
+    return current_scheduler;
+}
+
+void priority_scheduler::set_priority(priority_class cls) {
+    fiber* f = fiber::current();
+    if (f == nullptr || &f->scheduler() != current()) {
+        throw fiber::not_in_fiber("Unable to set the priority outside of a fiber of a priority scheduler.");
+    }
+
+    f->hook().priority = static_cast<std::uint32_t>(cls);
+}
+
+void priority_scheduler::set_deadline(clock::time_point deadline) {
+    fiber* f = fiber::current();
+    if (f == nullptr || &f->scheduler() != current()) {
+        throw fiber::not_in_fiber("Unable to set the deadline outside of a fiber of a priority scheduler.");
+    }
+
+    f->hook().key = deadline.time_since_epoch().count();
+}
+
+priority_scheduler::~priority_scheduler() noexcept {
+    {
+        std::unique_lock lock(_done_mutex);
+        _done_cv.wait(lock, [this] { return _live.load(std::memory_order_acquire) == 0; });
+    }
+
+    {
+        std::lock_guard lock(_mutex);
+        _stopping = true;
+    }
+    _ready.notify_all();
+
+    for (auto& t : _workers) {
+        t.join();
+    }
+}
+
+void priority_scheduler::spawn(fiber::routine_t routine) {
+    spawn(priority_class::normal, std::move(routine));
+}
+
+void priority_scheduler::spawn(priority_class cls, fiber::routine_t routine, clock::time_point deadline) {
+    auto f = fiber::make(*this, stack_allocator::create(_options.stack_size), std::move(routine));
+    // Kept in the scheduler fields of the hook in the fiber's frame for its whole life, so the fiber is the only
+    // allocation.
+    f->hook().priority = static_cast<std::uint32_t>(cls);
+    f->hook().key = deadline.time_since_epoch().count();
+    _live.fetch_add(1, std::memory_order_relaxed);
+    schedule(*f.release());
+}
+
+void priority_scheduler::wait() {
+    if (current() == this) {
+        throw wait_from_worker("Unable to wait for the scheduler from its own worker.");
+    }
+
+    std::unique_lock lock(_done_mutex);
+    _done_cv.wait(lock, [this] { return _live.load(std::memory_order_acquire) == 0; });
+    if (_exception != nullptr) {
+        std::rethrow_exception(std::exchange(_exception, nullptr));
+    }
+}
+
+std::size_t priority_scheduler::workers() const noexcept {
+    return _workers.size();
+}
+
+std::size_t priority_scheduler::promotions() const noexcept {
+    return _promotions.load(std::memory_order_relaxed);
+}
+
+void priority_scheduler::schedule(fiber& f) {
+    const auto cls = static_cast<std::size_t>(class_of(f));
+    const clock::time_point deadline = deadline_of(f);
+    {
+        std::lock_guard lock(_mutex);
+        run_queue& queue = _queues[cls];
+        if (queue.heap.empty()) {
+            // Starvation is measured from the moment the class has something to run.
+            queue.served = clock::now();
+        }
+        queue.heap.push_back({deadline, _sequence++, &f});
+        std::push_heap(queue.heap.begin(), queue.heap.end(), later {});
+        ++_runnable;
+    }
+    _ready.notify_one();
+}
+
+void priority_scheduler::reschedule(fiber& f) {
+    // A fresh sequence number puts the fiber behind its peers of the same deadline.
+    schedule(f);
+}
+
+void priority_scheduler::run_worker() {
+    current_scheduler = this;
+
+    while (fiber* f = take()) {
+        if (f->resume()) {
+            complete(f);
+        }
+    }
+
+    current_scheduler = nullptr;
+}
+
+fiber* priority_scheduler::take() {
+    std::unique_lock lock(_mutex);
+    _ready.wait(lock, [this] { return _runnable != 0 || _stopping; });
+    if (_runnable == 0) {
+        return nullptr;
+    }
+
+    const clock::time_point now = clock::now();
+    run_queue& queue = _queues[pick(now)];
+    std::pop_heap(queue.heap.begin(), queue.heap.end(), later {});
+    fiber* f = queue.heap.back().f;
+    queue.heap.pop_back();
+    queue.served = now;
+    --_runnable;
+    return f;
+}
+
+std::size_t priority_scheduler::pick(clock::time_point now) noexcept {
+    std::size_t urgent = 0;
+    while (_queues[urgent].heap.empty()) {
+        ++urgent;
+    }
+
+    // Among the less urgent classes, the one that has waited the longest past the limit, if any.
+    std::size_t chosen = urgent;
+    clock::time_point oldest = now - _options.starvation_limit;
+    for (std::size_t cls = urgent + 1; cls < classes; ++cls) {
+        const run_queue& queue = _queues[cls];
+        if (!queue.heap.empty() && queue.served <= oldest) {
+            oldest = queue.served;
+            chosen = cls;
+        }
+    }
+
+    if (chosen != urgent) {
+        _promotions.fetch_add(1, std::memory_order_relaxed);
+    }
+    return chosen;
+}
+
+void priority_scheduler::complete(fiber* f) noexcept {
+    std::exception_ptr exception = f->exception();
+    delete f;
+
+    if (exception != nullptr) {
+        std::lock_guard lock(_done_mutex);
+        if (_exception == nullptr) {
+            _exception = std::move(exception);
+        }
+    }
+
+    if (_live.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard lock(_done_mutex);
+        _done_cv.notify_all();
+    }
+}
+
+priority_class priority_scheduler::class_of(fiber& f) noexcept {
+    return static_cast<priority_class>(f.hook().priority);
+}
+
+priority_scheduler::clock::time_point priority_scheduler::deadline_of(fiber& f) noexcept {
+    return clock::time_point(clock::duration(f.hook().key));
+}
+
+} // namespace cortex
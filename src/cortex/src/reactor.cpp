@@ -0,0 +1,318 @@
+#include <cortex/reactor.hpp>
+
+#include <cerrno>
+#include <cstdint>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cortex {
+
+namespace {
+
+bool would_block(int code) noexcept {
+#if EAGAIN != EWOULDBLOCK
+    return code == EAGAIN || code == EWOULDBLOCK;
+#else
+    return code == EAGAIN;
+#endif
+}
+
+void release(void* lock) {
+    static_cast<spinlock*>(lock)->unlock();
+}
+
+/// A fiber parked on a descriptor, for a cancellation to unlink.
+struct descriptor_wait {
+    spinlock& lock;
+    fiber*& waiter;
+    fiber* self;
+};
+
+bool unlink(void* arg) noexcept {
+    auto* w = static_cast<descriptor_wait*>(arg);
+    const std::lock_guard guard(w->lock);
+    if (w->waiter != w->self) {
+        return false;
+    }
+    w->waiter = nullptr;
+    return true;
+}
+
+/// Parks the current fiber in `waiter` unless an edge arrived since the last wait.
+void wait_for(spinlock& lock, fiber*& waiter, bool& ready) {
+    fiber* self = fiber::current();
+    if (self == nullptr) {
+        throw fiber::not_in_fiber("Unable to wait for a descriptor outside of a fiber.");
+    }
+
+    fiber::cancellation_point();
+
+    lock.lock();
+    if (std::exchange(ready, false)) {
+        lock.unlock();
+        return;
+    }
+
+    waiter = self;
+    descriptor_wait w {lock, waiter, self};
+    fiber::interruption wait {&unlink, &w};
+    self->park(&release, &lock, wait);
+    if (wait.interrupted) {
+        fiber::cancellation_point();
+    }
+}
+
+} // namespace
+
+reactor::descriptor::descriptor(reactor& r, int fd, bool socket, std::unique_ptr<registration> state)
+    : _reactor(r)
+    , _fd(fd)
+    , _socket(socket)
+    , _state(std::move(state)) {}
+
+reactor::descriptor::~descriptor() noexcept {
+    ::epoll_ctl(_reactor._epoll, EPOLL_CTL_DEL, _fd, nullptr);
+    ::close(_fd);
+    // The event loop may still be looking at the registration in its current batch.
+    _reactor.retire(std::move(_state));
+}
+
+int reactor::descriptor::fd() const noexcept {
+    return _fd;
+}
+
+std::size_t reactor::descriptor::async_read(void* buffer, std::size_t size) {
+    while (true) {
+        const ssize_t res = ::read(_fd, buffer, size);
+        if (res >= 0) {
+            return static_cast<std::size_t>(res);
+        }
+
+        if (would_block(errno)) {
+            wait_readable();
+        } else if (errno != EINTR) {
+            throw system_error(errno, "read");
+        }
+    }
+}
+
+void reactor::descriptor::async_write(const void* buffer, std::size_t size) {
+    const auto* data = static_cast<const char*>(buffer);
+    while (size != 0) {
+        const ssize_t res = _socket ? ::send(_fd, data, size, MSG_NOSIGNAL) : ::write(_fd, data, size);
+        if (res >= 0) {
+            data += res;
+            size -= static_cast<std::size_t>(res);
+            continue;
+        }
+
+        if (would_block(errno)) {
+            wait_writable();
+        } else if (errno != EINTR) {
+            throw system_error(errno, "write");
+        }
+    }
+}
+
+std::unique_ptr<reactor::descriptor> reactor::descriptor::async_accept() {
+    while (true) {
+        const int fd = ::accept4(_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd >= 0) {
+            try {
+                return _reactor.attach(fd);
+            } catch (...) {
+                ::close(fd);
+                throw;
+            }
+        }
+
+        if (would_block(errno)) {
+            wait_readable();
+        } else if (errno != EINTR && errno != ECONNABORTED) {
+            throw system_error(errno, "accept");
+        }
+    }
+}
+
+void reactor::descriptor::async_connect(const sockaddr* address, socklen_t length) {
+    int res = ::connect(_fd, address, length);
+    while (res != 0 && errno == EINTR) {
+        res = ::connect(_fd, address, length);
+    }
+
+    if (res == 0) {
+        return;
+    }
+
+    if (errno != EINPROGRESS) {
+        throw system_error(errno, "connect");
+    }
+
+    wait_writable();
+
+    int error = 0;
+    socklen_t error_length = sizeof(error);
+    if (::getsockopt(_fd, SOL_SOCKET, SO_ERROR, &error, &error_length) != 0) {
+        throw system_error(errno, "getsockopt");
+    }
+
+    if (error != 0) {
+        throw system_error(error, "connect");
+    }
+}
+
+void reactor::descriptor::wait_readable() {
+    wait_for(_state->lock, _state->reader, _state->readable);
+}
+
+void reactor::descriptor::wait_writable() {
+    wait_for(_state->lock, _state->writer, _state->writable);
+}
+
+reactor::reactor(std::size_t max_events)
+    : _max_events(max_events) {
+    _epoll = ::epoll_create1(EPOLL_CLOEXEC);
+    if (_epoll < 0) {
+        throw system_error(errno, "epoll_create1");
+    }
+
+    _wakeup = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_wakeup < 0) {
+        const int code = errno;
+        ::close(_epoll);
+        throw system_error(code, "eventfd");
+    }
+
+    // The wakeup descriptor is the only one registered with a null pointer.
+    epoll_event event {};
+    event.events = EPOLLIN;
+    event.data.ptr = nullptr;
+    if (::epoll_ctl(_epoll, EPOLL_CTL_ADD, _wakeup, &event) != 0) {
+        const int code = errno;
+        ::close(_wakeup);
+        ::close(_epoll);
+        throw system_error(code, "epoll_ctl");
+    }
+
+    _thread = std::thread([this] { run(); });
+}
+
+std::unique_ptr<reactor> reactor::create(std::size_t max_events) {
+    if (max_events == 0) {
+        throw invalid_argument_error("The maximum number of events is zero.");
+    }
+
+    return std::unique_ptr<reactor>(new reactor(max_events));
+}
+
+reactor::~reactor() noexcept {
+    _stopping.store(true, std::memory_order_release);
+
+    const std::uint64_t one = 1;
+    [[maybe_unused]] const ssize_t res = ::write(_wakeup, &one, sizeof(one));
+    _thread.join();
+
+    release_retired();
+    ::close(_wakeup);
+    ::close(_epoll);
+}
+
+std::unique_ptr<reactor::descriptor> reactor::attach(int fd) {
+    const int flags = ::fcntl(fd, F_GETFL);
+    if (flags < 0 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0) {
+        throw system_error(errno, "fcntl");
+    }
+
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+        throw system_error(errno, "fstat");
+    }
+
+    auto state = std::make_unique<registration>();
+
+    epoll_event event {};
+    event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    event.data.ptr = state.get();
+    if (::epoll_ctl(_epoll, EPOLL_CTL_ADD, fd, &event) != 0) {
+        throw system_error(errno, "epoll_ctl");
+    }
+
+    return std::unique_ptr<descriptor>(new descriptor(*this, fd, S_ISSOCK(info.st_mode), std::move(state)));
+}
+
+void reactor::run() {
+    std::vector<epoll_event> events(_max_events);
+    std::vector<fiber*> ready;
+    ready.reserve(2 * _max_events);
+
+    while (true) {
+        // Every batch that could refer to the retired registrations has been processed.
+        release_retired();
+
+        const int count = ::epoll_wait(_epoll, events.data(), static_cast<int>(events.size()), -1);
+        if (count < 0) {
+            continue;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            const epoll_event& event = events[static_cast<std::size_t>(i)];
+            if (event.data.ptr != nullptr) {
+                dispatch(*static_cast<registration*>(event.data.ptr), event.events, ready);
+            }
+        }
+
+        // Waking is left to the end of the batch, so the registrations are only locked for a few instructions.
+        for (fiber* f : ready) {
+            f->wake();
+        }
+        ready.clear();
+
+        if (_stopping.load(std::memory_order_acquire)) {
+            break;
+        }
+    }
+}
+
+void reactor::dispatch(registration& state, std::uint32_t events, std::vector<fiber*>& ready) noexcept {
+    // Errors and hang-ups wake both sides, the next system call reports them.
+    const bool failed = (events & (EPOLLERR | EPOLLHUP)) != 0;
+    const bool readable = failed || (events & (EPOLLIN | EPOLLRDHUP)) != 0;
+    const bool writable = failed || (events & EPOLLOUT) != 0;
+
+    std::lock_guard guard(state.lock);
+    if (readable) {
+        if (fiber* f = std::exchange(state.reader, nullptr); f != nullptr) {
+            ready.push_back(f);
+        } else {
+            state.readable = true;
+        }
+    }
+
+    if (writable) {
+        if (fiber* f = std::exchange(state.writer, nullptr); f != nullptr) {
+            ready.push_back(f);
+        } else {
+            state.writable = true;
+        }
+    }
+}
+
+void reactor::retire(std::unique_ptr<registration> state) {
+    std::lock_guard lock(_retired_mutex);
+    _retired.push_back(std::move(state));
+}
+
+void reactor::release_retired() noexcept {
+    std::vector<std::unique_ptr<registration>> retired;
+    {
+        std::lock_guard lock(_retired_mutex);
+        retired.swap(_retired);
+    }
+}
+
+} // namespace cortex
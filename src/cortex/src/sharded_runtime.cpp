@@ -0,0 +1,341 @@
+#include <cortex/migration.hpp>
+#include <cortex/sharded_runtime.hpp>
+
+#include <cassert>
+#include <utility>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace cortex {
+
+namespace {
+
+struct shard_binding {
+    sharded_runtime* runtime = nullptr;
+    std::size_t index = 0;
+};
+
+thread_local shard_binding binding;
+
+void pin_current_thread(std::size_t index) noexcept {
+#if defined(__linux__)
+    const unsigned cores = std::thread::hardware_concurrency();
+    if (cores == 0) {
+        return;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(index % cores, &set);
+    // Pinning is best effort, e.g. the affinity mask of the process may not contain the core.
+    [[maybe_unused]] const int res = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)index;
+#endif
+}
+
+} // namespace
+
+sharded_runtime::shard::shard(sharded_runtime& rt, std::size_t idx, std::size_t shards)
+    : runtime(rt)
+    , index(idx)
+    , outboxes(shards) {}
+
+void sharded_runtime::shard::spawn(task_t routine) {
+    runtime.submit(index, std::move(routine));
+}
+
+void sharded_runtime::shard::schedule(fiber& f) {
+    if (binding.runtime == &runtime && binding.index == index) {
+        run_queue.push_back(&f);
+    } else {
+        runtime.push_remote(*this, f);
+    }
+}
+
+void sharded_runtime::shard::reschedule(fiber& f) {
+    schedule(f);
+}
+
+void sharded_runtime::shard::schedule_next(fiber& f) {
+    if (binding.runtime == &runtime && binding.index == index) {
+        run_queue.push_front(&f);
+    } else {
+        runtime.push_remote(*this, f);
+    }
+}
+
+sharded_runtime::sharded_runtime(std::size_t shards, const options& opts)
+    : _options(opts) {
+    _shards.reserve(shards);
+    for (std::size_t i = 0; i < shards; ++i) {
+        _shards.push_back(std::make_unique<shard>(*this, i, shards));
+    }
+
+    _channels.resize(shards * shards);
+    for (std::size_t from = 0; from < shards; ++from) {
+        for (std::size_t to = 0; to < shards; ++to) {
+            if (from != to) {
+                _channels[from * shards + to] = std::make_unique<spsc_queue<task_t>>(opts.queue_capacity);
+            }
+        }
+    }
+
+    for (auto& s : _shards) {
+        s->thread = std::thread([this, raw = s.get()] { run_shard(*raw); });
+    }
+}
+
+std::unique_ptr<sharded_runtime> sharded_runtime::create(std::size_t shards, const options& opts) {
+    if (shards == 0) {
+        throw invalid_argument_error("The number of shards is zero.");
+    }
+
+    if (opts.queue_capacity == 0) {
+        throw invalid_argument_error("The queue capacity is zero.");
+    }
+
+    return std::unique_ptr<sharded_runtime>(new sharded_runtime(shards, opts));
+}
+
+std::unique_ptr<sharded_runtime> sharded_runtime::create(std::size_t shards) {
+    return create(shards, options {});
+}
+
+CORTEX_TLS_ACCESSOR sharded_runtime* sharded_runtime::current() noexcept {
+    return binding.runtime;
+}
+
+CORTEX_TLS_ACCESSOR std::size_t sharded_runtime::current_shard() {
+    if (binding.runtime == nullptr) {
+        throw not_on_shard("The calling thread is not a shard.");
+    }
+    return binding.index;
+}
+
+sharded_runtime::~sharded_runtime() noexcept {
+    {
+        std::unique_lock lock(_done_mutex);
+        _done_cv.wait(lock, [this] { return _live.load(std::memory_order_acquire) == 0; });
+    }
+
+    _stopping.store(true, std::memory_order_seq_cst);
+    for (auto& s : _shards) {
+        wake(*s);
+    }
+
+    for (auto& s : _shards) {
+        s->thread.join();
+    }
+}
+
+std::size_t sharded_runtime::shards() const noexcept {
+    return _shards.size();
+}
+
+void sharded_runtime::submit(std::size_t target, task_t task) {
+    if (target >= _shards.size()) {
+        throw invalid_argument_error("The target shard is out of range.");
+    }
+
+    if (task == nullptr) {
+        throw invalid_argument_error("The input task is nullptr.");
+    }
+
+    _live.fetch_add(1, std::memory_order_relaxed);
+
+    if (binding.runtime != this) {
+        push_remote(*_shards[target], std::move(task));
+        return;
+    }
+
+    shard& self = *_shards[binding.index];
+    if (target == self.index) {
+        spawn_local(self, std::move(task));
+    } else {
+        self.outboxes[target].push_back(std::move(task));
+    }
+}
+
+void sharded_runtime::wait() {
+    if (binding.runtime == this) {
+        throw wait_from_shard("Unable to wait for the runtime from its own shard.");
+    }
+
+    std::unique_lock lock(_done_mutex);
+    _done_cv.wait(lock, [this] { return _live.load(std::memory_order_acquire) == 0; });
+    if (_exception != nullptr) {
+        std::rethrow_exception(std::exchange(_exception, nullptr));
+    }
+}
+
+void sharded_runtime::run_shard(shard& s) {
+    binding = {this, s.index};
+    if (_options.pin_threads) {
+        pin_current_thread(s.index);
+    }
+
+    while (true) {
+        const bool received = receive(s);
+        run_ready(s);
+        const bool flushed = flush(s);
+
+        if (received || !s.run_queue.empty()) {
+            continue;
+        }
+
+        if (!flushed) {
+            // A peer queue is full, its consumer is busy draining it.
+            std::this_thread::yield();
+            continue;
+        }
+
+        if (!park(s)) {
+            break;
+        }
+    }
+
+    binding = {};
+}
+
+bool sharded_runtime::receive(shard& s) {
+    std::size_t received = 0;
+    for (std::size_t from = 0; from < _shards.size(); ++from) {
+        if (from != s.index) {
+            received += channel(from, s.index).consume_all([&](task_t&& task) { spawn_local(s, std::move(task)); });
+        }
+    }
+
+    while (fiber* f = s.remote_fibers.pop()) {
+        s.run_queue.push_back(f);
+        ++received;
+    }
+
+    if (s.remote_pending.load(std::memory_order_acquire)) {
+        std::vector<task_t> tasks;
+        {
+            std::lock_guard lock(s.remote_mutex);
+            tasks.swap(s.remote_tasks);
+            s.remote_pending.store(false, std::memory_order_relaxed);
+        }
+
+        for (auto& task : tasks) {
+            spawn_local(s, std::move(task));
+        }
+        received += tasks.size();
+    }
+
+    return received != 0;
+}
+
+void sharded_runtime::run_ready(shard& s) {
+    // Only the fibers that are runnable now, the ones they make runnable wait for the next iteration.
+    for (std::size_t ready = s.run_queue.size(); ready != 0 && !s.run_queue.empty(); --ready) {
+        fiber* f = s.run_queue.front();
+        s.run_queue.pop_front();
+        if (!s.run_queue.empty()) {
+            // Loaded while this one runs, the next switch does not wait for the memory.
+            s.run_queue.front()->prefetch();
+        }
+
+        if (f->resume()) {
+            complete(f);
+        }
+    }
+}
+
+bool sharded_runtime::flush(shard& s) {
+    bool flushed = true;
+    for (std::size_t to = 0; to < _shards.size(); ++to) {
+        auto& outbox = s.outboxes[to];
+        if (outbox.empty()) {
+            continue;
+        }
+
+        auto rest = channel(s.index, to).try_push_bulk(outbox.begin(), outbox.end());
+        if (rest != outbox.begin()) {
+            wake(*_shards[to]);
+        }
+
+        outbox.erase(outbox.begin(), rest);
+        flushed = flushed && outbox.empty();
+    }
+    return flushed;
+}
+
+bool sharded_runtime::has_incoming(shard& s) {
+    for (std::size_t from = 0; from < _shards.size(); ++from) {
+        if (from != s.index && !channel(from, s.index).empty()) {
+            return true;
+        }
+    }
+    return !s.remote_fibers.empty() || s.remote_pending.load(std::memory_order_acquire);
+}
+
+bool sharded_runtime::park(shard& s) {
+    if (spin_until([&] { return has_incoming(s) || _stopping.load(std::memory_order_relaxed); })) {
+        return !_stopping.load(std::memory_order_acquire);
+    }
+
+    s.parking.prepare();
+
+    // Pairs with the fence in `wake`: either the producer sees the shard parked or this check sees its message.
+    if (!has_incoming(s) && !_stopping.load(std::memory_order_seq_cst)) {
+        s.parking.wait();
+    }
+
+    s.parking.cancel();
+    return !_stopping.load(std::memory_order_acquire);
+}
+
+void sharded_runtime::wake(shard& s) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    // Only a sleeping shard pays for the wakeup, a busy one only has its state read.
+    s.parking.unpark();
+}
+
+void sharded_runtime::push_remote(shard& s, task_t task) {
+    {
+        std::lock_guard lock(s.remote_mutex);
+        s.remote_tasks.push_back(std::move(task));
+        s.remote_pending.store(true, std::memory_order_release);
+    }
+    wake(s);
+}
+
+void sharded_runtime::push_remote(shard& s, fiber& f) {
+    // A non-empty inbox has not been drained yet, so the shard cannot be asleep on it.
+    if (s.remote_fibers.push(f)) {
+        wake(s);
+    }
+}
+
+void sharded_runtime::spawn_local(shard& s, task_t task) {
+    s.run_queue.push_back(fiber::make(s, stack_allocator::create(_options.stack_size), std::move(task)).release());
+}
+
+void sharded_runtime::complete(fiber* f) noexcept {
+    std::exception_ptr exception = f->exception();
+    delete f;
+
+    if (exception != nullptr) {
+        std::lock_guard lock(_done_mutex);
+        if (_exception == nullptr) {
+            _exception = std::move(exception);
+        }
+    }
+
+    if (_live.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard lock(_done_mutex);
+        _done_cv.notify_all();
+    }
+}
+
+spsc_queue<sharded_runtime::task_t>& sharded_runtime::channel(std::size_t from, std::size_t to) noexcept {
+    return *_channels[from * _shards.size() + to];
+}
+
+} // namespace cortex
@@ -0,0 +1,225 @@
+#include <cortex/shared_stack.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define CORTEX_SHARED_STACK_ASAN 1
+#endif
+#endif
+#if defined(__SANITIZE_ADDRESS__)
+#define CORTEX_SHARED_STACK_ASAN 1
+#endif
+
+#if defined(CORTEX_SHARED_STACK_ASAN)
+#include <sanitizer/asan_interface.h>
+#endif
+
+namespace cortex {
+
+namespace {
+namespace aux {
+
+machine::transfer_t unwind(machine::transfer_t transfer) {
+    throw forced_unwind(transfer.fctx);
+}
+
+/**
+ * Copies frames between the shared stack and a buffer. The redzones AddressSanitizer poisons around the locals of a
+ * frame are part of the copied range, and the poisoning belongs to whichever execution last ran there, not to the
+ * frames being copied, so the stack range is unpoisoned first and copied as plain bytes.
+ */
+void copy_frames(void* to, const void* from, std::size_t size, [[maybe_unused]] const void* stack_range) noexcept {
+#if defined(CORTEX_SHARED_STACK_ASAN)
+    __asan_unpoison_memory_region(stack_range, size);
+#endif
+    std::memcpy(to, from, size);
+}
+
+} // namespace aux
+} // namespace
+
+shared_stack::shared_stack(stack_allocator alloc, stack st)
+    : _allocator(std::move(alloc))
+    , _stack(st)
+    // 64 bytes below the top, 16-byte aligned as the machine context requires.
+    , _base(reinterpret_cast<std::byte*>((reinterpret_cast<std::uintptr_t>(st.top()) - 64) &
+                                         ~static_cast<std::uintptr_t>(0xf))) {}
+
+std::unique_ptr<shared_stack> shared_stack::create(stack_allocator alloc) {
+    auto st = alloc.allocate();
+
+    static constexpr std::size_t min_stack_size = 128000; // 128 KB
+    if (st.size() < min_stack_size) {
+        alloc.deallocate(st);
+        throw execution::invalid_stack_size("The allocated stack size is small, must be 128 KB min.");
+    }
+    return std::unique_ptr<shared_stack>(new shared_stack(std::move(alloc), st));
+}
+
+shared_stack::~shared_stack() noexcept {
+    assert(_occupant == nullptr);
+    _allocator.deallocate(_stack);
+}
+
+std::size_t shared_stack::size() const noexcept {
+    return _stack.size();
+}
+
+std::size_t shared_stack::usable_size() const noexcept {
+    const std::byte* bottom = static_cast<std::byte*>(_stack.top()) - _stack.size();
+    return static_cast<std::size_t>(_base - bottom);
+}
+
+bool shared_stack::contains(const void* address) const noexcept {
+    const auto addr = reinterpret_cast<std::uintptr_t>(address);
+    const auto top = reinterpret_cast<std::uintptr_t>(_stack.top());
+    return addr < top && addr >= top - _stack.size();
+}
+
+shared_execution::shared_execution(shared_stack& st, std::unique_ptr<api::flow> owned, api::flow* flow)
+    : _stack(st)
+    , _owned_flow(std::move(owned)) {
+    _record.flow = flow;
+    _record.hook.owner = flow;
+}
+
+shared_execution shared_execution::create(shared_stack& st, std::unique_ptr<api::flow> flow) {
+    if (flow == nullptr) {
+        throw execution::invalid_flow("The input flow is nullptr.");
+    }
+
+    api::flow* raw = flow.get();
+    return shared_execution(st, std::move(flow), raw);
+}
+
+shared_execution shared_execution::create_with_raw_flow(shared_stack& st, api::flow* flow) {
+    if (flow == nullptr) {
+        throw execution::invalid_flow("The input flow is nullptr.");
+    }
+
+    return shared_execution(st, nullptr, flow);
+}
+
+shared_execution::~shared_execution() noexcept {
+    if (_context != nullptr) {
+        [[maybe_unused]] const char marker = 0;
+        assert(!_stack.contains(&marker));
+        // Unwound on the stack like any other resume, a failure to save the occupant terminates.
+        occupy();
+        execution_record* prev = execution_record::exchange_current(&_record);
+        [[maybe_unused]] auto res = machine::ontop_context(std::exchange(_context, nullptr), nullptr, aux::unwind);
+        execution_record::exchange_current(prev);
+    }
+    release();
+}
+
+void shared_execution::resume() {
+    assert(!_completed);
+    const char marker = 0;
+    if (_stack.contains(&marker)) {
+        throw resume_on_shared_stack("Unable to resume an execution from its own shared stack.");
+    }
+
+    occupy();
+    void* data = nullptr;
+    if (_context == nullptr) {
+        // The first resume starts the flow right at the base, the entry gets the execution with the first switch.
+        _context = machine::make_context(_stack._base, _stack.usable_size(), &shared_execution::entry);
+        data = this;
+    }
+
+    const machine::transfer_t transfer = detail::resume_context(_context, data, _record);
+    if (!_completed) {
+        _context = transfer.fctx;
+        return;
+    }
+
+    _context = nullptr;
+    release();
+    if (_exception != nullptr) {
+        std::rethrow_exception(std::exchange(_exception, nullptr));
+    }
+}
+
+bool shared_execution::is_completed() const noexcept {
+    return _completed;
+}
+
+std::size_t shared_execution::saved_size() const noexcept {
+    return _saved_size;
+}
+
+execution_hook& shared_execution::hook() noexcept {
+    return _record.hook;
+}
+
+void shared_execution::entry(machine::transfer_t transfer) noexcept {
+    auto* self = static_cast<shared_execution*>(transfer.data);
+    assert(nullptr != transfer.fctx);
+    assert(nullptr != self);
+
+    try {
+        suspender s(transfer);
+        self->_record.suspender = &s;
+        self->_record.flow->run(s);
+    } catch (const forced_unwind& ex) {
+        transfer = {ex.context, nullptr};
+    } catch (const std::exception&) {
+        self->_exception = std::current_exception();
+    }
+    assert(nullptr != transfer.fctx);
+
+    // Nothing is left to destroy on the frames, the next execution to run simply overwrites them.
+    self->_record.suspender = nullptr;
+    self->_completed = true;
+    [[maybe_unused]] auto res = machine::jump_to_context(transfer.fctx, nullptr);
+    assert(false); // context already terminated
+}
+
+void shared_execution::occupy() {
+    shared_execution* occupant = _stack._occupant;
+    if (occupant == this) {
+        return;
+    }
+    if (occupant != nullptr) {
+        occupant->evacuate();
+    }
+
+    if (_saved_size != 0) {
+        std::byte* sp = _stack._base - _saved_size;
+        aux::copy_frames(sp, _saved.get(), _saved_size, sp);
+        _saved_size = 0;
+    }
+    _stack._occupant = this;
+}
+
+void shared_execution::evacuate() {
+    assert(_stack._occupant == this);
+    assert(_context != nullptr);
+
+    auto* sp = static_cast<std::byte*>(_context);
+    const auto used = static_cast<std::size_t>(_stack._base - sp);
+    // Right-sized: grown to fit, shrunk once the frames take less than a quarter of the buffer.
+    if (used > _saved_capacity || used < _saved_capacity / 4) {
+        _saved = std::make_unique_for_overwrite<std::byte[]>(used);
+        _saved_capacity = used;
+    }
+    aux::copy_frames(_saved.get(), sp, used, sp);
+    _saved_size = used;
+    _stack._occupant = nullptr;
+}
+
+void shared_execution::release() noexcept {
+    if (_stack._occupant == this) {
+        _stack._occupant = nullptr;
+    }
+    _saved.reset();
+    _saved_size = 0;
+    _saved_capacity = 0;
+}
+
+} // namespace cortex
@@ -0,0 +1,174 @@
+#include <cortex/task_group.hpp>
+
+#include <cassert>
+#include <mutex>
+#include <utility>
+
+namespace cortex {
+
+namespace {
+
+api::scheduler& current_scheduler() {
+    fiber* self = fiber::current();
+    if (self == nullptr) {
+        throw fiber::not_in_fiber("Unable to create a task group outside of a fiber.");
+    }
+    return self->scheduler();
+}
+
+} // namespace
+
+class task_group::membership {
+public:
+    explicit membership(task_group& group)
+        : _group(group) {
+        _node.self = fiber::current();
+
+        std::lock_guard lock(_group._lock);
+        _node.next = _group._children;
+        if (_node.next != nullptr) {
+            _node.next->prev = &_node;
+        }
+        _group._children = &_node;
+
+        if (_group._cancelled) {
+            _node.self->cancel();
+        }
+    }
+
+    membership(const membership&) = delete;
+    membership(membership&&) = delete;
+    membership& operator=(const membership&) = delete;
+    membership& operator=(membership&&) = delete;
+
+    ~membership() noexcept {
+        wait_queue::node* joiners = nullptr;
+        {
+            std::lock_guard lock(_group._lock);
+            (_node.prev != nullptr ? _node.prev->next : _group._children) = _node.next;
+            if (_node.next != nullptr) {
+                _node.next->prev = _node.prev;
+            }
+
+            if (--_group._running == 0) {
+                joiners = _group._joiners.take_all();
+            }
+        }
+        // The group may be gone as soon as the lock is released, only the parked joiners are touched from here on.
+        wait_queue::wake_all(joiners);
+    }
+
+private:
+    task_group& _group;
+    child _node;
+};
+
+task_group::task_group(api::scheduler& sched)
+    : _scheduler(sched) {}
+
+task_group::task_group()
+    : task_group(current_scheduler()) {}
+
+task_group::~task_group() noexcept {
+    cancel();
+    // Children that failed while being cancelled have nobody left to report to. Not cut short even if the fiber
+    // is cancelled, the children refer to the group.
+    wait_children(false);
+    assert(_running == 0);
+}
+
+void task_group::spawn(routine_t routine) {
+    if (routine == nullptr) {
+        throw invalid_argument_error("The input routine is nullptr.");
+    }
+
+    {
+        std::lock_guard lock(_lock);
+        ++_running;
+    }
+
+    try {
+        _scheduler.spawn([this, routine = std::move(routine)] { run_child(routine); });
+    } catch (...) {
+        wait_queue::node* joiners = nullptr;
+        {
+            std::lock_guard lock(_lock);
+            if (--_running == 0) {
+                joiners = _joiners.take_all();
+            }
+        }
+        wait_queue::wake_all(joiners);
+        throw;
+    }
+}
+
+void task_group::join() {
+    fiber::cancellation_point();
+
+    if (std::exception_ptr exception = wait_children(true); exception != nullptr) {
+        std::rethrow_exception(exception);
+    }
+}
+
+void task_group::cancel() noexcept {
+    std::lock_guard lock(_lock);
+    _cancelled = true;
+    cancel_children();
+}
+
+bool task_group::is_cancelled() const noexcept {
+    std::lock_guard lock(_lock);
+    return _cancelled;
+}
+
+std::size_t task_group::size() const noexcept {
+    std::lock_guard lock(_lock);
+    return _running;
+}
+
+std::exception_ptr task_group::wait_children(bool cancellable) {
+    _lock.lock();
+    while (_running != 0) {
+        // Released once this fiber is switched out, so the last child cannot finish unnoticed.
+        if (!cancellable) {
+            _joiners.wait(_lock);
+        } else if (!_joiners.wait_cancellable(_lock)) {
+            fiber::cancellation_point();
+        }
+        _lock.lock();
+    }
+
+    std::exception_ptr exception = std::exchange(_exception, nullptr);
+    _cancelled = false;
+    _lock.unlock();
+    return exception;
+}
+
+void task_group::run_child(const routine_t& routine) {
+    const membership m(*this);
+    try {
+        fiber::cancellation_point();
+        routine();
+    } catch (const forced_unwind&) {
+        throw;
+    } catch (...) {
+        fail(std::current_exception());
+    }
+}
+
+void task_group::fail(std::exception_ptr exception) noexcept {
+    std::lock_guard lock(_lock);
+    if (_exception == nullptr) {
+        _exception = std::move(exception);
+    }
+    _cancelled = true;
+    cancel_children();
+}
+
+void task_group::cancel_children() noexcept {
+    for (child* c = _children; c != nullptr; c = c->next) {
+        c->self->cancel();
+    }
+}
+
+} // namespace cortex
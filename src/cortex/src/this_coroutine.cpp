@@ -0,0 +1,36 @@
+#include <cortex/this_coroutine.hpp>
+
+#include <cortex/execution.hpp>
+
+namespace cortex::this_coroutine {
+
+api::suspendable* get() noexcept {
+    const execution_record* record = execution_record::current();
+    return record != nullptr ? record->suspender : nullptr;
+}
+
+bool is_inside() noexcept {
+    return get() != nullptr;
+}
+
+std::pmr::memory_resource* memory_resource() noexcept {
+    execution_record* record = execution_record::current();
+    if (record == nullptr) {
+        return std::pmr::get_default_resource();
+    }
+    if (!record->memory) {
+        record->memory.emplace();
+    }
+    return &*record->memory;
+}
+
+void suspend() {
+    const execution_record* record = execution_record::current();
+    if (record == nullptr || record->suspender == nullptr) {
+        throw not_in_coroutine("Unable to suspend outside of a coroutine.");
+    }
+
+    record->flow->suspend_self(*record->suspender);
+}
+
+} // namespace cortex::this_coroutine
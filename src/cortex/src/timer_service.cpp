@@ -0,0 +1,151 @@
+#include <cortex/timer_service.hpp>
+
+namespace cortex {
+
+timer_service::timeout::timeout(timer_service& service, clock::time_point deadline, callback_t callback, void* arg)
+    : _service(&service) {
+    _node.callback = callback;
+    _node.arg = arg;
+    _node.deadline = service.to_tick(deadline);
+    service.schedule(*this);
+}
+
+timer_service::timeout::~timeout() noexcept {
+    if (_service != nullptr) {
+        _service->cancel(*this);
+    }
+}
+
+timer_service::timer_service(clock::duration resolution)
+    : _resolution(resolution)
+    , _epoch(clock::now()) {
+    _thread = std::thread([this] { run(); });
+}
+
+std::unique_ptr<timer_service> timer_service::create(clock::duration resolution) {
+    if (resolution <= clock::duration::zero()) {
+        throw invalid_argument_error("The resolution is not positive.");
+    }
+
+    return std::unique_ptr<timer_service>(new timer_service(resolution));
+}
+
+timer_service::~timer_service() noexcept {
+    {
+        std::lock_guard lock(_mutex);
+        _stopping = true;
+    }
+    _wakeup.notify_one();
+    _thread.join();
+}
+
+void timer_service::sleep_for(clock::duration duration) {
+    sleep_until(clock::now() + duration);
+}
+
+void timer_service::sleep_until(clock::time_point deadline) {
+    fiber* self = fiber::current();
+    if (self == nullptr) {
+        throw fiber::not_in_fiber("Unable to sleep outside of a fiber.");
+    }
+
+    fiber::cancellation_point();
+
+    timeout t;
+    t._service = this;
+    t._node.callback = &wake;
+    t._node.arg = self;
+    t._node.deadline = to_tick(deadline);
+    // Armed once the fiber is switched out, the timer may fire right away.
+    fiber::interruption wait {&unlink, &t};
+    self->park(&arm, &t, wait);
+
+    // The only ways back are the timer firing, which does not touch it once the fiber is woken, and the cancellation,
+    // which takes it off the wheel.
+    t._service = nullptr;
+    // Cancelled while asleep, no need to run until the next wait.
+    fiber::cancellation_point();
+}
+
+std::size_t timer_service::pending() const {
+    std::lock_guard lock(_mutex);
+    return _wheel.size();
+}
+
+void timer_service::arm(void* t) {
+    auto* self = static_cast<timeout*>(t);
+    self->_service->schedule(*self);
+}
+
+void timer_service::wake(void* f) {
+    static_cast<fiber*>(f)->wake();
+}
+
+bool timer_service::unlink(void* t) noexcept {
+    auto* self = static_cast<timeout*>(t);
+    std::lock_guard lock(self->_service->_mutex);
+    if (self->_service->_wheel.cancel(self->_node)) {
+        return true;
+    }
+
+    // Not armed yet, the park hook arms it once the fiber is switched out, or already fired.
+    self->_node.deadline = 0;
+    return false;
+}
+
+void timer_service::schedule(timeout& t) {
+    bool earlier = false;
+    {
+        std::lock_guard lock(_mutex);
+        _wheel.schedule(t._node, t._node.deadline);
+        earlier = t._node.deadline < _sleeping_until;
+        if (earlier) {
+            _sleeping_until = t._node.deadline;
+        }
+    }
+
+    if (earlier) {
+        _wakeup.notify_one();
+    }
+}
+
+void timer_service::cancel(timeout& t) noexcept {
+    // Serialized with the thread of the service, a callback in flight has returned once the lock is acquired.
+    std::lock_guard lock(_mutex);
+    _wheel.cancel(t._node);
+}
+
+void timer_service::run() {
+    std::unique_lock lock(_mutex);
+    while (!_stopping) {
+        const auto elapsed = (clock::now() - _epoch) / _resolution;
+        timer_wheel::entry* expired = _wheel.advance(static_cast<timer_wheel::tick_t>(elapsed));
+
+        // The whole batch fires under the lock, so a timer can not be cancelled while its callback runs.
+        while (expired != nullptr) {
+            auto* t = static_cast<timeout::node*>(expired);
+            expired = expired->next;
+            t->callback(t->arg);
+        }
+
+        if (const auto next = _wheel.next_deadline()) {
+            _sleeping_until = *next;
+            _wakeup.wait_until(lock, _epoch + static_cast<clock::rep>(*next) * _resolution);
+        } else {
+            _sleeping_until = std::numeric_limits<timer_wheel::tick_t>::max();
+            _wakeup.wait(lock);
+        }
+    }
+}
+
+timer_wheel::tick_t timer_service::to_tick(clock::time_point deadline) const noexcept {
+    if (deadline <= _epoch) {
+        return 0;
+    }
+
+    // Rounded up, a timer never fires before its deadline.
+    const clock::duration since = deadline - _epoch;
+    return static_cast<timer_wheel::tick_t>((since + _resolution - clock::duration(1)) / _resolution);
+}
+
+} // namespace cortex
@@ -0,0 +1,167 @@
+#include <cortex/timer_wheel.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+namespace cortex {
+
+namespace {
+
+constexpr timer_wheel::tick_t slot_span(unsigned level) noexcept {
+    return timer_wheel::tick_t {1} << (level * timer_wheel::slot_bits);
+}
+
+} // namespace
+
+timer_wheel::timer_wheel(tick_t now) noexcept
+    : _now(now) {}
+
+void timer_wheel::schedule(entry& e, tick_t deadline) noexcept {
+    e.deadline = deadline;
+    ++_size;
+
+    if (deadline <= _now) {
+        push(_overdue, e);
+        return;
+    }
+    insert(e);
+}
+
+bool timer_wheel::cancel(entry& e) noexcept {
+    if (e.list == nullptr) {
+        return false;
+    }
+
+    if (e.prev != nullptr) {
+        e.prev->next = e.next;
+    } else {
+        *e.list = e.next;
+        if (e.next == nullptr && e.list != &_overdue) {
+            _levels[e.level].occupied &= ~(std::uint64_t {1} << e.slot);
+        }
+    }
+    if (e.next != nullptr) {
+        e.next->prev = e.prev;
+    }
+
+    e.prev = e.next = nullptr;
+    e.list = nullptr;
+    --_size;
+    return true;
+}
+
+timer_wheel::entry* timer_wheel::advance(tick_t now) noexcept {
+    entry* expired = nullptr;
+    auto expire = [&](entry& e) {
+        e.list = nullptr;
+        e.prev = nullptr;
+        e.next = expired;
+        expired = &e;
+        --_size;
+    };
+
+    for (entry* e = std::exchange(_overdue, nullptr); e != nullptr;) {
+        entry* next = e->next;
+        expire(*e);
+        e = next;
+    }
+
+    while (const auto found = next_slot()) {
+        if (found->start > now) {
+            break;
+        }
+
+        // The slot is due: its entries either expire or move down to a finer level.
+        _now = found->start;
+        level& l = _levels[found->level_index];
+        l.occupied &= ~(std::uint64_t {1} << found->slot);
+        entry* e = std::exchange(l.heads[found->slot], nullptr);
+        while (e != nullptr) {
+            entry* next = e->next;
+            if (e->deadline <= now) {
+                expire(*e);
+            } else {
+                e->prev = e->next = nullptr;
+                insert(*e);
+            }
+            e = next;
+        }
+    }
+
+    _now = std::max(_now, now);
+    return expired;
+}
+
+std::optional<timer_wheel::tick_t> timer_wheel::next_deadline() const noexcept {
+    if (_overdue != nullptr) {
+        return _now;
+    }
+
+    if (const auto found = next_slot()) {
+        return found->start;
+    }
+    return std::nullopt;
+}
+
+timer_wheel::tick_t timer_wheel::now() const noexcept {
+    return _now;
+}
+
+std::size_t timer_wheel::size() const noexcept {
+    return _size;
+}
+
+bool timer_wheel::empty() const noexcept {
+    return _size == 0;
+}
+
+void timer_wheel::insert(entry& e) noexcept {
+    // Far deadlines are filed at the end of the wheel and cascaded again once their slot is reached.
+    const tick_t target = std::min(e.deadline, _now + span - 1);
+    // Past the span, the digits wrap around within the last level.
+    const tick_t differing = std::min((_now ^ target) | (slots - 1), span - 1);
+    const auto lvl = static_cast<unsigned>((std::bit_width(differing) - 1) / slot_bits);
+    const auto slot = static_cast<unsigned>((target >> (lvl * slot_bits)) & (slots - 1));
+
+    e.level = static_cast<std::uint8_t>(lvl);
+    e.slot = static_cast<std::uint8_t>(slot);
+    _levels[lvl].occupied |= std::uint64_t {1} << slot;
+    push(_levels[lvl].heads[slot], e);
+}
+
+void timer_wheel::push(entry*& head, entry& e) noexcept {
+    e.prev = nullptr;
+    e.next = head;
+    if (head != nullptr) {
+        head->prev = &e;
+    }
+    head = &e;
+    e.list = &head;
+}
+
+std::optional<timer_wheel::due_slot> timer_wheel::next_slot() const noexcept {
+    // Entries of a level are always due before those of the levels above it.
+    for (unsigned lvl = 0; lvl < levels; ++lvl) {
+        const std::uint64_t occupied = _levels[lvl].occupied;
+        if (occupied == 0) {
+            continue;
+        }
+
+        const tick_t width = slot_span(lvl);
+        const auto current = static_cast<unsigned>((_now / width) & (slots - 1));
+        const auto distance = static_cast<unsigned>(std::countr_zero(std::rotr(occupied, static_cast<int>(current))));
+        const unsigned slot = (current + distance) & (slots - 1);
+
+        const tick_t level_width = width * slots;
+        tick_t start = (_now & ~(level_width - 1)) + slot * width;
+        // Only far deadlines filed in the last level can land behind the current slot.
+        if (start < _now) {
+            start += level_width;
+        }
+        return due_slot {lvl, slot, start};
+    }
+    return std::nullopt;
+}
+
+} // namespace cortex
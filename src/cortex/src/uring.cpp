@@ -0,0 +1,321 @@
+#include <cortex/uring.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace cortex {
+
+namespace {
+
+/// `user_data` of the eventfd read, operations are never at address zero.
+constexpr std::uint64_t wakeup_data = 0;
+
+int io_uring_setup(unsigned entries, io_uring_params* params) noexcept {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int io_uring_enter(int ring, unsigned to_submit, unsigned min_complete, unsigned flags) noexcept {
+    return static_cast<int>(::syscall(__NR_io_uring_enter, ring, to_submit, min_complete, flags, nullptr, 0));
+}
+
+unsigned load_acquire(const unsigned* p) noexcept {
+    return std::atomic_ref<const unsigned>(*p).load(std::memory_order_acquire);
+}
+
+void store_release(unsigned* p, unsigned value) noexcept {
+    std::atomic_ref<unsigned>(*p).store(value, std::memory_order_release);
+}
+
+void* map(std::size_t size, int ring, off_t offset) {
+    void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, offset);
+    if (p == MAP_FAILED) {
+        throw system_error(errno, "mmap");
+    }
+    return p;
+}
+
+} // namespace
+
+uring::uring(unsigned entries) {
+    io_uring_params params {};
+    _ring = io_uring_setup(entries, &params);
+    if (_ring < 0) {
+        throw system_error(errno, "io_uring_setup");
+    }
+
+    try {
+        _sq_map_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        _cq_map_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0) {
+            _sq_map_size = _cq_map_size = std::max(_sq_map_size, _cq_map_size);
+        }
+
+        _sq_map = map(_sq_map_size, _ring, IORING_OFF_SQ_RING);
+        if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0) {
+            _cq_map = _sq_map;
+        } else {
+            _cq_map = map(_cq_map_size, _ring, IORING_OFF_CQ_RING);
+        }
+
+        _sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        _sqes = static_cast<io_uring_sqe*>(map(_sqes_size, _ring, IORING_OFF_SQES));
+
+        auto* sq = static_cast<char*>(_sq_map);
+        _sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        _sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        _sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        _sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        _sq_entries = params.sq_entries;
+
+        auto* cq = static_cast<char*>(_cq_map);
+        _cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        _cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        _cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        _cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+
+        _wakeup = ::eventfd(0, EFD_CLOEXEC);
+        if (_wakeup < 0) {
+            throw system_error(errno, "eventfd");
+        }
+    } catch (...) {
+        unmap();
+        ::close(_ring);
+        throw;
+    }
+
+    _thread = std::thread([this] { run(); });
+}
+
+std::unique_ptr<uring> uring::create(unsigned entries) {
+    if (entries == 0) {
+        throw invalid_argument_error("The number of entries is zero.");
+    }
+
+    return std::unique_ptr<uring>(new uring(entries));
+}
+
+uring::~uring() noexcept {
+    _stopping.store(true, std::memory_order_release);
+
+    const std::uint64_t one = 1;
+    [[maybe_unused]] const ssize_t res = ::write(_wakeup, &one, sizeof(one));
+    _thread.join();
+
+    // Closing the ring cancels the eventfd read still in flight.
+    unmap();
+    ::close(_ring);
+    ::close(_wakeup);
+}
+
+std::size_t uring::async_read(int fd, void* buffer, std::size_t size, std::uint64_t offset) {
+    operation op;
+    op.opcode = IORING_OP_READ;
+    op.fd = fd;
+    op.addr = reinterpret_cast<std::uintptr_t>(buffer);
+    op.len = static_cast<std::uint32_t>(std::min<std::size_t>(size, UINT32_MAX));
+    op.offset = offset;
+    return static_cast<std::size_t>(submit(op, "read"));
+}
+
+std::size_t uring::async_write(int fd, const void* buffer, std::size_t size, std::uint64_t offset) {
+    operation op;
+    op.opcode = IORING_OP_WRITE;
+    op.fd = fd;
+    op.addr = reinterpret_cast<std::uintptr_t>(buffer);
+    op.len = static_cast<std::uint32_t>(std::min<std::size_t>(size, UINT32_MAX));
+    op.offset = offset;
+    return static_cast<std::size_t>(submit(op, "write"));
+}
+
+int uring::async_accept(int fd) {
+    operation op;
+    op.opcode = IORING_OP_ACCEPT;
+    op.fd = fd;
+    return submit(op, "accept");
+}
+
+void uring::async_connect(int fd, const sockaddr* address, socklen_t length) {
+    operation op;
+    op.opcode = IORING_OP_CONNECT;
+    op.fd = fd;
+    op.addr = reinterpret_cast<std::uintptr_t>(address);
+    // The address length goes in the offset field.
+    op.offset = length;
+    submit(op, "connect");
+}
+
+void uring::async_fsync(int fd) {
+    operation op;
+    op.opcode = IORING_OP_FSYNC;
+    op.fd = fd;
+    submit(op, "fsync");
+}
+
+void uring::publish(void* op) noexcept {
+    auto* self = static_cast<operation*>(op);
+    self->ring->enqueue(*self);
+}
+
+std::int32_t uring::submit(operation& op, const char* what) {
+    fiber* self = fiber::current();
+    if (self == nullptr) {
+        throw fiber::not_in_fiber("Unable to submit an operation outside of a fiber.");
+    }
+
+    fiber::cancellation_point();
+
+    op.ring = this;
+    op.owner = self;
+    // Published once the fiber is off its stack, the completion may wake it right away.
+    self->park(&publish, &op);
+
+    if (op.result < 0) {
+        throw system_error(-op.result, what);
+    }
+    return op.result;
+}
+
+void uring::enqueue(operation& op) noexcept {
+    {
+        std::lock_guard guard(_pending_lock);
+        if (_pending_tail != nullptr) {
+            _pending_tail->next = &op;
+        } else {
+            _pending_head = &op;
+        }
+        _pending_tail = &op;
+    }
+
+    // Pairs with the fence of the event loop, either it sees the operation or it is woken.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_sleeping.load(std::memory_order_relaxed)) {
+        const std::uint64_t one = 1;
+        [[maybe_unused]] const ssize_t res = ::write(_wakeup, &one, sizeof(one));
+    }
+}
+
+bool uring::prepare(std::uint8_t opcode, int fd, std::uint64_t addr, std::uint32_t len, std::uint64_t offset,
+                    std::uint64_t user_data) noexcept {
+    const unsigned tail = *_sq_tail;
+    if (tail - load_acquire(_sq_head) == _sq_entries) {
+        return false;
+    }
+
+    const unsigned index = tail & _sq_mask;
+    io_uring_sqe& sqe = _sqes[index];
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = opcode;
+    sqe.fd = fd;
+    sqe.addr = addr;
+    sqe.len = len;
+    sqe.off = offset;
+    sqe.user_data = user_data;
+    if (opcode == IORING_OP_ACCEPT) {
+        sqe.accept_flags = SOCK_CLOEXEC;
+    }
+
+    _sq_array[index] = index;
+    // The kernel reads the entry once it sees the new tail.
+    store_release(_sq_tail, tail + 1);
+    return true;
+}
+
+void uring::run() {
+    std::vector<fiber*> ready;
+    operation* backlog = nullptr;
+    operation* backlog_tail = nullptr;
+    unsigned to_submit = 0;
+    bool armed = false;
+    bool stopped = false;
+
+    while (!stopped) {
+        if (!armed) {
+            armed = prepare(IORING_OP_READ, _wakeup, reinterpret_cast<std::uintptr_t>(&_wakeup_value),
+                            sizeof(_wakeup_value), 0, wakeup_data);
+            to_submit += armed ? 1 : 0;
+        }
+
+        {
+            std::lock_guard guard(_pending_lock);
+            if (_pending_head != nullptr) {
+                if (backlog_tail != nullptr) {
+                    backlog_tail->next = _pending_head;
+                } else {
+                    backlog = _pending_head;
+                }
+                backlog_tail = _pending_tail;
+                _pending_head = _pending_tail = nullptr;
+            }
+        }
+
+        // Everything published since the last iteration goes out with a single system call.
+        while (backlog != nullptr && prepare(backlog->opcode, backlog->fd, backlog->addr, backlog->len,
+                                             backlog->offset, reinterpret_cast<std::uintptr_t>(backlog))) {
+            backlog = backlog->next;
+            ++to_submit;
+        }
+        if (backlog == nullptr) {
+            backlog_tail = nullptr;
+        }
+
+        // Block only when nothing is left to submit and the wakeup read can report new operations.
+        _sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool wait = armed && backlog == nullptr;
+        if (wait) {
+            std::lock_guard guard(_pending_lock);
+            wait = _pending_head == nullptr;
+        }
+
+        const int res = io_uring_enter(_ring, to_submit, wait ? 1 : 0, wait ? IORING_ENTER_GETEVENTS : 0);
+        _sleeping.store(false, std::memory_order_relaxed);
+        if (res >= 0) {
+            to_submit -= std::min(static_cast<unsigned>(res), to_submit);
+        }
+
+        unsigned head = *_cq_head;
+        const unsigned tail = load_acquire(_cq_tail);
+        for (; head != tail; ++head) {
+            const io_uring_cqe& cqe = _cqes[head & _cq_mask];
+            if (cqe.user_data == wakeup_data) {
+                armed = false;
+                stopped = _stopping.load(std::memory_order_acquire);
+                continue;
+            }
+
+            auto* op = reinterpret_cast<operation*>(static_cast<std::uintptr_t>(cqe.user_data));
+            op->result = cqe.res;
+            ready.push_back(op->owner);
+        }
+        store_release(_cq_head, head);
+
+        // The operations live on the stacks of the fibers, they are gone once woken.
+        for (fiber* f : ready) {
+            f->wake();
+        }
+        ready.clear();
+    }
+}
+
+void uring::unmap() noexcept {
+    if (_sqes != nullptr) {
+        ::munmap(_sqes, _sqes_size);
+    }
+    if (_cq_map != nullptr && _cq_map != _sq_map) {
+        ::munmap(_cq_map, _cq_map_size);
+    }
+    if (_sq_map != nullptr) {
+        ::munmap(_sq_map, _sq_map_size);
+    }
+}
+
+} // namespace cortex
@@ -0,0 +1,53 @@
+#include <cortex/wait_group.hpp>
+
+namespace cortex {
+
+wait_group::wait_group(std::ptrdiff_t count)
+    : _count(count) {
+    if (count < 0) {
+        throw negative_counter("The initial count is negative.");
+    }
+}
+
+void wait_group::add(std::ptrdiff_t delta) {
+    const std::ptrdiff_t count = _count.fetch_add(delta, std::memory_order_acq_rel) + delta;
+    if (count < 0) {
+        throw negative_counter("The wait group counter is negative.");
+    }
+
+    if (count == 0 && delta != 0) {
+        _lock.lock();
+        wait_queue::node* waiters = _waiters.take_all();
+        _lock.unlock();
+
+        wait_queue::wake_all(waiters);
+    }
+}
+
+void wait_group::done() {
+    add(-1);
+}
+
+void wait_group::wait() {
+    fiber::cancellation_point();
+    if (try_wait()) {
+        return;
+    }
+
+    _lock.lock();
+    // `add` takes the lock after the counter drops, so either we see zero here or it sees us in the queue.
+    if (try_wait()) {
+        _lock.unlock();
+        return;
+    }
+
+    if (!_waiters.wait_cancellable(_lock)) {
+        fiber::cancellation_point();
+    }
+}
+
+bool wait_group::try_wait() const noexcept {
+    return _count.load(std::memory_order_acquire) == 0;
+}
+
+} // namespace cortex
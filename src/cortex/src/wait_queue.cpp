@@ -0,0 +1,123 @@
+#include <cortex/wait_queue.hpp>
+
+#include <mutex>
+#include <utility>
+
+namespace cortex {
+
+namespace {
+
+void release(void* lock) {
+    static_cast<spinlock*>(lock)->unlock();
+}
+
+/// A queued node, for a cancellation to unlink.
+struct queued_wait {
+    wait_queue& queue;
+    spinlock& lock;
+    wait_queue::node& n;
+};
+
+bool unlink(void* arg) noexcept {
+    auto* w = static_cast<queued_wait*>(arg);
+    const std::lock_guard guard(w->lock);
+    return w->queue.remove(w->n);
+}
+
+} // namespace
+
+void wait_queue::wait(spinlock& lock) {
+    fiber* self = fiber::current();
+    if (self == nullptr) {
+        lock.unlock();
+        throw fiber::not_in_fiber("Unable to wait outside of a fiber.");
+    }
+
+    node n {self, nullptr};
+    wait(lock, n);
+}
+
+void wait_queue::wait(spinlock& lock, node& n) {
+    push(n);
+    n.owner->park(&release, &lock);
+}
+
+bool wait_queue::wait_cancellable(spinlock& lock) {
+    fiber* self = fiber::current();
+    if (self == nullptr) {
+        lock.unlock();
+        throw fiber::not_in_fiber("Unable to wait outside of a fiber.");
+    }
+
+    node n {self, nullptr};
+    return wait_cancellable(lock, n);
+}
+
+bool wait_queue::wait_cancellable(spinlock& lock, node& n) {
+    push(n);
+    queued_wait w {*this, lock, n};
+    fiber::interruption wait {&unlink, &w};
+    n.owner->park(&release, &lock, wait);
+    return !wait.interrupted;
+}
+
+void wait_queue::push(node& n) noexcept {
+    n.next = nullptr;
+    if (_tail == nullptr) {
+        _head = &n;
+    } else {
+        _tail->next = &n;
+    }
+    _tail = &n;
+}
+
+fiber* wait_queue::pop() noexcept {
+    node* n = _head;
+    if (n == nullptr) {
+        return nullptr;
+    }
+
+    _head = n->next;
+    if (_head == nullptr) {
+        _tail = nullptr;
+    }
+
+    // `n` lives on the stack of its fiber and dies as soon as the fiber is woken up.
+    return n->owner;
+}
+
+wait_queue::node* wait_queue::take_all() noexcept {
+    _tail = nullptr;
+    return std::exchange(_head, nullptr);
+}
+
+void wait_queue::wake_all(node* head) {
+    while (head != nullptr) {
+        // Read the link before waking, the node dies with the fiber's wait.
+        node* next = head->next;
+        head->owner->wake();
+        head = next;
+    }
+}
+
+bool wait_queue::remove(node& n) noexcept {
+    node* prev = nullptr;
+    for (node* it = _head; it != nullptr; prev = it, it = it->next) {
+        if (it != &n) {
+            continue;
+        }
+
+        (prev != nullptr ? prev->next : _head) = n.next;
+        if (_tail == &n) {
+            _tail = prev;
+        }
+        return true;
+    }
+    return false;
+}
+
+bool wait_queue::empty() const noexcept {
+    return _head == nullptr;
+}
+
+} // namespace cortex
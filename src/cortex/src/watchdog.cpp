@@ -0,0 +1,261 @@
+#include <cortex/watchdog.hpp>
+
+#include <cortex/migration.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <utility>
+
+#if defined(__linux__)
+#include <csignal>
+#include <execinfo.h>
+#include <pthread.h>
+#endif
+
+namespace cortex {
+
+namespace detail {
+
+std::atomic<bool> watchdog_enabled {false};
+
+} // namespace detail
+
+namespace {
+
+/// Heartbeats of the threads alive, the lock keeps them alive while the watchdog thread inspects them.
+struct heartbeat_registry {
+    std::mutex mutex;
+    std::vector<detail::heartbeat*> heartbeats;
+};
+
+heartbeat_registry& registry() {
+    static heartbeat_registry instance;
+    return instance;
+}
+
+std::atomic<bool> watchdog_running {false};
+
+/// Longest time the watchdog thread waits for a signaled thread to take its backtrace.
+constexpr auto backtrace_timeout = std::chrono::milliseconds(50);
+
+std::int64_t now_ns() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(watchdog::clock::now().time_since_epoch()).count();
+}
+
+#if defined(__linux__)
+thread_local detail::heartbeat* signal_heartbeat = nullptr;
+
+struct sigaction previous_action {};
+
+void take_backtrace(int /*signal*/) {
+    const int saved_errno = errno;
+    if (detail::heartbeat* hb = signal_heartbeat; hb != nullptr && !hb->backtrace_ready.load()) {
+        hb->backtrace_of = hb->state.record.load(std::memory_order_relaxed);
+        hb->depth = static_cast<std::size_t>(backtrace(hb->frames.data(), static_cast<int>(hb->frames.size())));
+        hb->backtrace_ready.store(true, std::memory_order_release);
+    }
+    errno = saved_errno;
+}
+#endif
+
+void print_report(const watchdog::report& r) {
+    std::fputs(r.to_string().c_str(), stderr);
+}
+
+} // namespace
+
+namespace detail {
+
+heartbeat::heartbeat(const switch_state& st)
+    : state(st)
+    , thread(std::this_thread::get_id())
+#if defined(__linux__)
+    , native_handle(pthread_self())
+#endif
+{
+    const std::lock_guard lock(registry().mutex);
+    registry().heartbeats.push_back(this);
+#if defined(__linux__)
+    signal_heartbeat = this;
+#endif
+}
+
+heartbeat::~heartbeat() noexcept {
+    const std::lock_guard lock(registry().mutex);
+    auto& heartbeats = registry().heartbeats;
+    heartbeats.erase(std::find(heartbeats.begin(), heartbeats.end(), this));
+#if defined(__linux__)
+    signal_heartbeat = nullptr;
+#endif
+}
+
+CORTEX_TLS_ACCESSOR bool register_thread(const switch_state& state) noexcept {
+    try {
+        thread_local heartbeat instance(state);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+} // namespace detail
+
+std::string watchdog::report::to_string() const {
+    std::ostringstream out;
+    out << "cortex watchdog: execution " << execution << " has run for "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(running).count() << " ms without a switch on thread "
+        << thread << '\n';
+
+#if defined(__linux__)
+    if (!frames.empty()) {
+        char** symbols = backtrace_symbols(frames.data(), static_cast<int>(frames.size()));
+        for (std::size_t i = 0; i < frames.size(); ++i) {
+            out << "  #" << i << ' ' << (symbols != nullptr ? symbols[i] : "?") << '\n';
+        }
+        std::free(static_cast<void*>(symbols));
+    }
+#endif
+    return out.str();
+}
+
+watchdog::watchdog(options opts)
+    : _options(std::move(opts)) {
+#if defined(__linux__)
+    if (_options.signal != 0) {
+        // The first call loads the unwinder, which must not happen in the signal handler.
+        std::array<void*, 1> warm_up {};
+        backtrace(warm_up.data(), 1);
+
+        struct sigaction action {};
+        action.sa_handler = &take_backtrace;
+        action.sa_flags = SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        sigaction(_options.signal, &action, &previous_action);
+    }
+#endif
+
+    {
+        // The threads registered with an earlier watchdog are timed from now, their counts did not move meanwhile.
+        const std::int64_t now = now_ns();
+        const std::lock_guard lock(registry().mutex);
+        for (detail::heartbeat* hb : registry().heartbeats) {
+            hb->seen_switches = hb->state.switches.load(std::memory_order_acquire);
+            hb->seen_at = now;
+        }
+    }
+    detail::watchdog_enabled.store(true, std::memory_order_release);
+    _thread = std::thread([this] { run(); });
+}
+
+std::unique_ptr<watchdog> watchdog::create(options opts) {
+    if (opts.threshold <= clock::duration::zero() || opts.interval <= clock::duration::zero()) {
+        throw invalid_argument_error("The threshold or the interval is not positive.");
+    }
+    if (watchdog_running.exchange(true)) {
+        throw already_running("A watchdog is already running.");
+    }
+
+    try {
+        return std::unique_ptr<watchdog>(new watchdog(std::move(opts)));
+    } catch (...) {
+        watchdog_running.store(false);
+        throw;
+    }
+}
+
+watchdog::~watchdog() noexcept {
+    {
+        std::lock_guard lock(_mutex);
+        _stopping = true;
+    }
+    _stop_cv.notify_one();
+    _thread.join();
+
+    detail::watchdog_enabled.store(false, std::memory_order_relaxed);
+#if defined(__linux__)
+    if (_options.signal != 0) {
+        sigaction(_options.signal, &previous_action, nullptr);
+    }
+#endif
+    watchdog_running.store(false);
+}
+
+std::size_t watchdog::reports() const noexcept {
+    return _reports.load(std::memory_order_relaxed);
+}
+
+int watchdog::default_signal() noexcept {
+#if defined(__linux__)
+    // Rarely used, and a thread interrupted by it just resumes what it was doing.
+    return SIGURG;
+#else
+    return 0;
+#endif
+}
+
+void watchdog::run() {
+    std::vector<report> found;
+    std::unique_lock lock(_mutex);
+    while (!_stop_cv.wait_for(lock, _options.interval, [this] { return _stopping; })) {
+        const std::int64_t now = now_ns();
+
+        lock.unlock();
+        check(now, found);
+        for (const report& r : found) {
+            _reports.fetch_add(1, std::memory_order_relaxed);
+            if (_options.handler) {
+                _options.handler(r);
+            } else {
+                print_report(r);
+            }
+        }
+        found.clear();
+        lock.lock();
+    }
+}
+
+void watchdog::check(std::int64_t now, std::vector<report>& found) {
+    const auto threshold = std::chrono::duration_cast<std::chrono::nanoseconds>(_options.threshold).count();
+
+    const std::lock_guard lock(registry().mutex);
+    for (detail::heartbeat* hb : registry().heartbeats) {
+        // Pairs with the release store of the switch: the execution is at least as recent as the count.
+        const std::uint64_t switches = hb->state.switches.load(std::memory_order_acquire);
+        const execution_record* running = hb->state.record.load(std::memory_order_relaxed);
+        if (switches != hb->seen_switches) {
+            // Switched since the last check, what runs now is timed from here.
+            hb->seen_switches = switches;
+            hb->seen_at = now;
+            continue;
+        }
+        if (running == nullptr || now - hb->seen_at < threshold || hb->reported_switches == switches) {
+            continue;
+        }
+        hb->reported_switches = switches;
+
+        report r {hb->thread, running, std::chrono::nanoseconds(now - hb->seen_at), {}};
+
+#if defined(__linux__)
+        if (_options.signal != 0) {
+            hb->backtrace_ready.store(false, std::memory_order_relaxed);
+            if (pthread_kill(hb->native_handle, _options.signal) == 0) {
+                const auto deadline = clock::now() + backtrace_timeout;
+                while (!hb->backtrace_ready.load(std::memory_order_acquire) && clock::now() < deadline) {
+                    std::this_thread::yield();
+                }
+                // A backtrace of whatever runs by now would be misleading.
+                if (hb->backtrace_ready.load(std::memory_order_acquire) && hb->backtrace_of == running) {
+                    r.frames.assign(hb->frames.begin(), hb->frames.begin() + static_cast<std::ptrdiff_t>(hb->depth));
+                }
+            }
+        }
+#endif
+
+        found.push_back(std::move(r));
+    }
+}
+
+} // namespace cortex
@@ -0,0 +1,324 @@
+#include <cortex/migration.hpp>
+#include <cortex/random.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace cortex {
+
+namespace {
+
+struct worker_binding {
+    work_stealing_scheduler* scheduler = nullptr;
+    void* worker = nullptr;
+};
+
+thread_local worker_binding binding;
+
+/// Number of sweeps over the victims before a worker goes idle.
+constexpr std::size_t steal_rounds = 4;
+
+/// Maximum number of fibers moved from the injection queue to a local deque at once.
+constexpr std::size_t inject_batch = 32;
+
+} // namespace
+
+work_stealing_scheduler::work_stealing_scheduler(std::size_t workers, std::size_t stack_size)
+    : _stack_size(stack_size) {
+    _workers.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+        _workers.push_back(std::make_unique<worker>(i));
+    }
+
+    for (auto& w : _workers) {
+        w->thread = std::thread([this, raw = w.get()] { run_worker(*raw); });
+    }
+}
+
+std::unique_ptr<work_stealing_scheduler> work_stealing_scheduler::create(std::size_t workers, std::size_t stack_size) {
+    if (workers == 0) {
+        throw invalid_argument_error("The number of workers is zero.");
+    }
+
+    return std::unique_ptr<work_stealing_scheduler>(new work_stealing_scheduler(workers, stack_size));
+}
+
+CORTEX_TLS_ACCESSOR work_stealing_scheduler* work_stealing_scheduler::current() noexcept {
+    return binding.scheduler;
+}
+
+work_stealing_scheduler::~work_stealing_scheduler() noexcept {
+    {
+        std::unique_lock lock(_done_mutex);
+        _done_cv.wait(lock, [this] { return _live.load(std::memory_order_acquire) == 0; });
+    }
+
+    _stopping.store(true, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (auto& w : _workers) {
+        wake(*w);
+    }
+
+    for (auto& w : _workers) {
+        w->thread.join();
+    }
+}
+
+void work_stealing_scheduler::spawn(fiber::routine_t routine) {
+    auto f = fiber::make(*this, stack_allocator::create(_stack_size), std::move(routine));
+    _live.fetch_add(1, std::memory_order_relaxed);
+    schedule(*f.release());
+}
+
+void work_stealing_scheduler::wait() {
+    if (current() == this) {
+        throw wait_from_worker("Unable to wait for the scheduler from its own worker.");
+    }
+
+    std::unique_lock lock(_done_mutex);
+    _done_cv.wait(lock, [this] { return _live.load(std::memory_order_acquire) == 0; });
+    if (_exception != nullptr) {
+        std::rethrow_exception(std::exchange(_exception, nullptr));
+    }
+}
+
+std::size_t work_stealing_scheduler::workers() const noexcept {
+    return _workers.size();
+}
+
+void work_stealing_scheduler::schedule(fiber& f) {
+    if (worker* w = local_worker(); w != nullptr) {
+        w->deque.push(&f);
+        notify();
+    } else {
+        inject(f);
+    }
+}
+
+void work_stealing_scheduler::reschedule(fiber& f) {
+    // The injection queue is FIFO, so the yielding fiber runs after the work that is already queued.
+    inject(f);
+}
+
+void work_stealing_scheduler::schedule_next(fiber& f) {
+    worker* w = local_worker();
+    if (w == nullptr) {
+        schedule(f);
+        return;
+    }
+
+    // The displaced fiber goes back to the deque, where it can be stolen again.
+    if (fiber* prev = std::exchange(w->next, &f); prev != nullptr) {
+        w->deque.push(prev);
+        notify();
+    }
+}
+
+void* work_stealing_scheduler::home() noexcept {
+    return local_worker();
+}
+
+void work_stealing_scheduler::schedule_home(fiber& f, void* home) {
+    if (home == nullptr) {
+        schedule(f);
+        return;
+    }
+
+    auto* w = static_cast<worker*>(home);
+    // A non-empty inbox has not been drained yet, so the worker cannot be asleep on it.
+    if (w->inbox.push(f) && w != local_worker()) {
+        // Pairs with the fence of `parker::prepare`.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        wake(*w);
+    }
+}
+
+void work_stealing_scheduler::run_worker(worker& w) {
+    binding = {this, &w};
+
+    while (true) {
+        fiber* f = take(w);
+        if (f == nullptr) {
+            if (!idle(w)) {
+                break;
+            }
+            continue;
+        }
+
+        if (f->resume()) {
+            complete(f);
+        }
+    }
+
+    binding = {};
+}
+
+fiber* work_stealing_scheduler::take(worker& w) {
+    if (fiber* f = std::exchange(w.next, nullptr); f != nullptr) {
+        return f;
+    }
+
+    if (fiber* f = take_inbox(w); f != nullptr) {
+        return f;
+    }
+
+    if (fiber* f = w.deque.pop(); f != nullptr) {
+        return f;
+    }
+
+    if (fiber* f = take_injected(); f != nullptr) {
+        return f;
+    }
+
+    return steal(w);
+}
+
+fiber* work_stealing_scheduler::take_injected() {
+    if (_injected_size.load(std::memory_order_relaxed) == 0) {
+        return nullptr;
+    }
+
+    std::lock_guard lock(_inject_mutex);
+    if (_injected.empty()) {
+        return nullptr;
+    }
+
+    fiber* f = _injected.front();
+    _injected.pop_front();
+
+    // Move a share of the backlog to the local deque, so that other workers can steal it from there.
+    if (worker* w = local_worker(); w != nullptr) {
+        const std::size_t share = std::min(inject_batch, _injected.size() / _workers.size());
+        for (std::size_t i = 0; i < share; ++i) {
+            w->deque.push(_injected.front());
+            _injected.pop_front();
+        }
+    }
+
+    _injected_size.store(_injected.size(), std::memory_order_relaxed);
+    return f;
+}
+
+fiber* work_stealing_scheduler::take_inbox(worker& w) {
+    return w.inbox.pop();
+}
+
+fiber* work_stealing_scheduler::steal(worker& w) {
+    const std::size_t count = _workers.size();
+    if (count == 1) {
+        return nullptr;
+    }
+
+    for (std::size_t round = 0; round < steal_rounds; ++round) {
+        const std::size_t start = detail::next_random(w.seed) % count;
+        for (std::size_t i = 0; i < count; ++i) {
+            worker& victim = *_workers[(start + i) % count];
+            if (&victim == &w) {
+                continue;
+            }
+
+            if (fiber* f = victim.deque.steal(); f != nullptr) {
+                return f;
+            }
+        }
+
+        if (fiber* f = take_injected(); f != nullptr) {
+            return f;
+        }
+        std::this_thread::yield();
+    }
+    return nullptr;
+}
+
+bool work_stealing_scheduler::has_work(const worker& self) const noexcept {
+    if (_injected_size.load(std::memory_order_seq_cst) != 0 || !self.inbox.empty()) {
+        return true;
+    }
+
+    for (const auto& w : _workers) {
+        if (!w->deque.empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool work_stealing_scheduler::idle(worker& w) {
+    if (spin_until([&] { return _stopping.load(std::memory_order_acquire) || has_work(w); })) {
+        return !_stopping.load(std::memory_order_acquire);
+    }
+
+    _sleepers.fetch_add(1, std::memory_order_seq_cst);
+    w.parking.prepare();
+
+    // Either the producer sees this worker parked or this check sees its work.
+    if (!has_work(w) && !_stopping.load(std::memory_order_seq_cst)) {
+        w.parking.wait();
+    }
+
+    // A waker that claimed the worker has already taken it off the sleepers.
+    if (w.parking.cancel()) {
+        _sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return !_stopping.load(std::memory_order_acquire);
+}
+
+void work_stealing_scheduler::inject(fiber& f) {
+    {
+        std::lock_guard lock(_inject_mutex);
+        _injected.push_back(&f);
+        _injected_size.store(_injected.size(), std::memory_order_relaxed);
+    }
+    notify();
+}
+
+void work_stealing_scheduler::notify() {
+    // Pairs with the fence of `parker::prepare`: either this load sees the sleeper or the sleeper sees the work.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_sleepers.load(std::memory_order_seq_cst) == 0) {
+        return;
+    }
+
+    for (auto& w : _workers) {
+        if (wake(*w)) {
+            return;
+        }
+    }
+}
+
+bool work_stealing_scheduler::wake(worker& w) {
+    if (!w.parking.unpark()) {
+        return false;
+    }
+
+    _sleepers.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+void work_stealing_scheduler::complete(fiber* f) noexcept {
+    std::exception_ptr exception = f->exception();
+    delete f;
+
+    if (exception != nullptr) {
+        std::lock_guard lock(_done_mutex);
+        if (_exception == nullptr) {
+            _exception = std::move(exception);
+        }
+    }
+
+    if (_live.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard lock(_done_mutex);
+        _done_cv.notify_all();
+    }
+}
+
+CORTEX_TLS_ACCESSOR work_stealing_scheduler::worker* work_stealing_scheduler::local_worker() const noexcept {
+    if (binding.scheduler != this) {
+        return nullptr;
+    }
+    return static_cast<worker*>(binding.worker);
+}
+
+} // namespace cortex
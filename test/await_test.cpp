@@ -0,0 +1,270 @@
+#include <cortex/await.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/future.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace cortex;
+
+namespace {
+
+struct MyException : std::exception {};
+
+/// Eagerly started C++20 coroutine nobody waits for.
+struct detached {
+    struct promise_type {
+        detached get_return_object() const noexcept {
+            return {};
+        }
+
+        std::suspend_never initial_suspend() const noexcept {
+            return {};
+        }
+
+        std::suspend_never final_suspend() const noexcept {
+            return {};
+        }
+
+        void return_void() const noexcept {}
+
+        [[noreturn]] void unhandled_exception() const noexcept {
+            std::terminate();
+        }
+    };
+};
+
+/// Awaitable whose handles are resumed later by a thread of the test.
+class remote_event {
+public:
+    struct awaiter {
+        remote_event& event;
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) {
+            const std::lock_guard lock(event._mutex);
+            event._handles.push_back(handle);
+        }
+
+        int await_resume() const noexcept {
+            return 7;
+        }
+    };
+
+    awaiter operator co_await() noexcept {
+        return awaiter {*this};
+    }
+
+    /// Resumes the registered handles, returns how many.
+    std::size_t fire() {
+        std::vector<std::coroutine_handle<>> handles;
+        {
+            const std::lock_guard lock(_mutex);
+            handles.swap(_handles);
+        }
+        for (auto handle : handles) {
+            handle.resume();
+        }
+        return handles.size();
+    }
+
+private:
+    std::mutex _mutex;
+    std::vector<std::coroutine_handle<>> _handles;
+};
+
+/// Awaiter resuming its handle from within `await_suspend`.
+struct inline_resume {
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) const {
+        handle.resume();
+    }
+
+    int await_resume() const noexcept {
+        return 1;
+    }
+};
+
+/// Awaiter declining to suspend.
+struct declined {
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> /*handle*/) const noexcept {
+        return false;
+    }
+
+    int await_resume() const noexcept {
+        return 2;
+    }
+};
+
+/// Awaiter failing to suspend.
+struct failing {
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> /*handle*/) const {
+        throw MyException();
+    }
+
+    void await_resume() const noexcept {}
+};
+
+detached await_into(future<int> f, std::optional<int>& result) {
+    result = co_await std::move(f);
+}
+
+detached await_failure(future<int> f, bool& caught) {
+    try {
+        co_await std::move(f);
+    } catch (const MyException&) {
+        caught = true;
+    }
+}
+
+} // namespace
+
+TEST(CortexAwaitTest, CoAwaitReadyFuture) {
+    promise<int> p;
+    p.set_value(5);
+    std::optional<int> result;
+
+    await_into(p.get_future(), result);
+
+    EXPECT_EQ(result, 5);
+}
+
+TEST(CortexAwaitTest, CoAwaitResumedBySetter) {
+    promise<int> p;
+    std::optional<int> result;
+
+    await_into(p.get_future(), result);
+    EXPECT_FALSE(result.has_value());
+
+    p.set_value(9);
+    EXPECT_EQ(result, 9);
+}
+
+TEST(CortexAwaitTest, CoAwaitFailure) {
+    promise<int> p;
+    bool caught = false;
+
+    await_failure(p.get_future(), caught);
+    p.set_exception(std::make_exception_ptr(MyException()));
+
+    EXPECT_TRUE(caught);
+}
+
+TEST(CortexAwaitTest, CoAwaitFiber) {
+    auto sched = work_stealing_scheduler::create(2);
+    std::optional<int> result;
+    std::atomic<bool> done {false};
+
+    [](api::scheduler& s, std::optional<int>& out, std::atomic<bool>& finished) -> detached {
+        // The deep-stack code runs on a fiber and may park, the stackless caller is suspended meanwhile.
+        out = co_await async(s, [] {
+            fiber::yield();
+            return 42;
+        });
+        finished = true;
+    }(*sched, result, done);
+
+    sched->wait();
+    EXPECT_TRUE(done.load());
+    EXPECT_EQ(result, 42);
+}
+
+TEST(CortexAwaitTest, AsyncPropagatesException) {
+    auto sched = work_stealing_scheduler::create(1);
+    auto f = async(*sched, [] { throw MyException(); });
+    sched->wait();
+
+    EXPECT_THROW(f.get(), MyException);
+}
+
+TEST(CortexAwaitTest, AwaitOutsideOfFiber) {
+    EXPECT_THROW(await(declined {}), fiber::not_in_fiber);
+}
+
+TEST(CortexAwaitTest, FiberAwaitsRemoteEvent) {
+    static constexpr int kFibers = 100;
+    auto sched = work_stealing_scheduler::create(4);
+    remote_event event;
+    std::atomic<int> sum {0};
+
+    for (int i = 0; i < kFibers; ++i) {
+        sched->spawn([&] { sum += await(event); });
+    }
+
+    std::thread resumer([&] {
+        std::size_t resumed = 0;
+        while (resumed != kFibers) {
+            resumed += event.fire();
+            std::this_thread::yield();
+        }
+    });
+    resumer.join();
+    sched->wait();
+
+    EXPECT_EQ(sum.load(), 7 * kFibers);
+}
+
+TEST(CortexAwaitTest, FiberAwaitsSynchronousAwaiters) {
+    auto sched = work_stealing_scheduler::create(1);
+    int total = 0;
+    bool caught = false;
+
+    sched->spawn([&] {
+        total += await(inline_resume {});
+        total += await(declined {});
+        await(std::suspend_never {});
+        try {
+            await(failing {});
+        } catch (const MyException&) {
+            caught = true;
+        }
+    });
+    sched->wait();
+
+    EXPECT_EQ(total, 3);
+    EXPECT_TRUE(caught);
+}
+
+TEST(CortexAwaitTest, FiberAwaitsFuture) {
+    auto sched = work_stealing_scheduler::create(2);
+    promise<int> p;
+    auto f = p.get_future();
+    int result = 0;
+
+    sched->spawn([&] { result = await(std::move(f)); });
+    sched->spawn([&] {
+        fiber::yield();
+        p.set_value(11);
+    });
+    sched->wait();
+
+    EXPECT_EQ(result, 11);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
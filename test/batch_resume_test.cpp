@@ -0,0 +1,86 @@
+#include <cortex/basic_flow.hpp>
+#include <cortex/execution.hpp>
+#include <cortex/stack_allocator.hpp>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace cortex;
+
+namespace {
+
+struct MyException : std::exception {};
+
+/// Owns an execution, which is neither copyable nor movable.
+struct holder {
+    explicit holder(std::function<void(api::suspendable&)> body)
+        : exec(execution::create(stack_allocator::create(256 * 1024), basic_flow::make(std::move(body)))) {}
+
+    execution exec;
+};
+
+} // namespace
+
+TEST(CortexBatchResumeTest, ResumeFieldsAreOnThePrefetchedLines) {
+    execution_record record;
+    const auto offset = [&record](const void* field) {
+        return static_cast<std::size_t>(static_cast<const std::byte*>(field) -
+                                        reinterpret_cast<const std::byte*>(&record));
+    };
+
+    // `prefetch` covers the first two lines of the record.
+    EXPECT_EQ(offset(&record.hook), 0);
+    EXPECT_LT(offset(&record.flow), 2 * cache_line_size);
+    EXPECT_LT(offset(&record.suspender), 2 * cache_line_size);
+    EXPECT_LT(offset(&record.slice_start), 2 * cache_line_size);
+    EXPECT_LT(offset(&record.pinned), 2 * cache_line_size);
+    EXPECT_LE(offset(&record.pinned_thread) + sizeof(record.pinned_thread), 2 * cache_line_size);
+}
+
+TEST(CortexBatchResumeTest, EmptyBatch) {
+    EXPECT_NO_THROW(execution::resume_batch({}));
+}
+
+TEST(CortexBatchResumeTest, ResumesInTurn) {
+    std::vector<int> trace;
+    std::vector<std::unique_ptr<holder>> holders;
+    std::vector<execution*> batch;
+    for (int i = 0; i < 4; ++i) {
+        holders.push_back(std::make_unique<holder>([&trace, i](api::suspendable& suspender) {
+            trace.push_back(i);
+            suspender.suspend();
+            trace.push_back(i + 10);
+        }));
+        batch.push_back(&holders.back()->exec);
+    }
+
+    execution::resume_batch(batch);
+    EXPECT_EQ(trace, (std::vector<int> {0, 1, 2, 3}));
+
+    // Any order, any subset.
+    execution::resume_batch(std::vector<execution*> {batch[3], batch[1]});
+    EXPECT_EQ(trace, (std::vector<int> {0, 1, 2, 3, 13, 11}));
+}
+
+TEST(CortexBatchResumeTest, RethrowsAndStops) {
+    std::vector<int> trace;
+    holder first([&](api::suspendable&) { trace.push_back(1); });
+    holder failing([](api::suspendable&) { throw MyException(); });
+    holder last([&](api::suspendable&) { trace.push_back(3); });
+    const std::vector<execution*> batch {&first.exec, &failing.exec, &last.exec};
+
+    EXPECT_THROW(execution::resume_batch(batch), MyException);
+    EXPECT_EQ(trace, (std::vector<int> {1}));
+
+    last.exec.resume();
+    EXPECT_EQ(trace, (std::vector<int> {1, 3}));
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,128 @@
+#include <cortex/blocking_pool.hpp>
+#include <cortex/error.hpp>
+#include <cortex/sharded_runtime.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace cortex;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct MyException : std::exception {};
+
+} // namespace
+
+TEST(CortexBlockingPoolTest, ZeroThreads) {
+    EXPECT_THROW(blocking_pool::create(0), invalid_argument_error);
+}
+
+TEST(CortexBlockingPoolTest, OffloadOutsideOfFiberRunsInline) {
+    auto pool = blocking_pool::create(1);
+    const auto caller = std::this_thread::get_id();
+
+    EXPECT_EQ(pool->offload([] { return std::this_thread::get_id(); }), caller);
+}
+
+TEST(CortexBlockingPoolTest, ReturnsResult) {
+    auto pool = blocking_pool::create(2);
+    auto sched = work_stealing_scheduler::create(1);
+    std::string result;
+    std::thread::id ran_on;
+
+    sched->spawn([&] {
+        result = pool->offload([&] {
+            ran_on = std::this_thread::get_id();
+            return std::string("done");
+        });
+    });
+    sched->wait();
+
+    EXPECT_EQ(result, "done");
+    EXPECT_NE(ran_on, std::this_thread::get_id());
+}
+
+TEST(CortexBlockingPoolTest, RethrowsException) {
+    auto pool = blocking_pool::create(2);
+    auto sched = work_stealing_scheduler::create(1);
+    bool caught = false;
+
+    sched->spawn([&] {
+        try {
+            pool->offload([] { throw MyException(); });
+        } catch (const MyException&) {
+            caught = true;
+        }
+    });
+    sched->wait();
+
+    EXPECT_TRUE(caught);
+}
+
+TEST(CortexBlockingPoolTest, WorkerKeepsRunningFibers) {
+    auto pool = blocking_pool::create(1);
+    auto sched = work_stealing_scheduler::create(1);
+    std::atomic<bool> blocked {true};
+    bool other_ran = false;
+
+    sched->spawn([&] {
+        pool->offload([&] {
+            std::this_thread::sleep_for(50ms);
+            blocked = false;
+        });
+    });
+    sched->spawn([&] { other_ran = blocked.load(); });
+    sched->wait();
+
+    EXPECT_TRUE(other_ran);
+}
+
+TEST(CortexBlockingPoolTest, ResumesOnOriginalThread) {
+    static constexpr int kFibers = 200;
+    auto pool = blocking_pool::create(4);
+    auto sched = work_stealing_scheduler::create(4);
+    std::atomic<int> same_thread {0};
+
+    for (int i = 0; i < kFibers; ++i) {
+        sched->spawn([&] {
+            const auto before = std::this_thread::get_id();
+            pool->offload([] { std::this_thread::sleep_for(1ms); });
+            if (std::this_thread::get_id() == before) {
+                ++same_thread;
+            }
+        });
+    }
+    sched->wait();
+
+    EXPECT_EQ(same_thread.load(), kFibers);
+}
+
+TEST(CortexBlockingPoolTest, ResumesOnOriginalShard) {
+    sharded_runtime::options opts;
+    opts.pin_threads = false;
+    auto rt = sharded_runtime::create(2, opts);
+    std::atomic<int> same_shard {0};
+
+    for (std::size_t i = 0; i < 20; ++i) {
+        rt->submit(i % 2, [&, shard = i % 2] {
+            offload([] { std::this_thread::sleep_for(1ms); });
+            if (sharded_runtime::current_shard() == shard) {
+                ++same_shard;
+            }
+        });
+    }
+    rt->wait();
+
+    EXPECT_EQ(same_shard.load(), 20);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,306 @@
+#include <cortex/channel.hpp>
+#include <cortex/coroutine.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/fiber_semaphore.hpp>
+#include <cortex/reactor.hpp>
+#include <cortex/timer_service.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <stop_token>
+#include <thread>
+
+#include <unistd.h>
+
+using namespace cortex;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// Counts the destructors run by unwound stacks.
+struct unwind_probe {
+    explicit unwind_probe(std::atomic<int>& counter)
+        : destroyed(counter) {}
+
+    unwind_probe(const unwind_probe&) = delete;
+    unwind_probe(unwind_probe&&) = delete;
+    unwind_probe& operator=(const unwind_probe&) = delete;
+    unwind_probe& operator=(unwind_probe&&) = delete;
+
+    ~unwind_probe() {
+        ++destroyed;
+    }
+
+    std::atomic<int>& destroyed;
+};
+
+/// Spawns a fiber that parks in `wait` for good, cancels it from this thread once it is parked, or about to, and
+/// checks that it unwinds.
+template <typename Wait>
+void expect_cancel_wakes(Wait wait) {
+    auto sched = work_stealing_scheduler::create(1);
+    std::atomic<int> destroyed {0};
+    std::atomic<fiber*> waiter {nullptr};
+
+    sched->spawn([&] {
+        const unwind_probe probe(destroyed);
+        waiter = fiber::current();
+        wait();
+        ADD_FAILURE() << "The wait returned.";
+    });
+
+    while (waiter.load() == nullptr) {
+        std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(10ms);
+    waiter.load()->cancel();
+    sched->wait();
+
+    EXPECT_EQ(destroyed.load(), 1);
+}
+
+} // namespace
+
+TEST(CortexCancellationTest, CoroutineUnwindsOnResume) {
+    std::atomic<int> destroyed {0};
+    int steps = 0;
+    coroutine* self = nullptr;
+
+    auto routine = coroutine::make_routine([&] {
+        const unwind_probe probe(destroyed);
+        while (true) {
+            ++steps;
+            self->suspend();
+        }
+    });
+    auto co = coroutine::create(routine.get());
+    self = &co;
+
+    co.resume();
+    co.resume();
+    EXPECT_EQ(steps, 2);
+    EXPECT_FALSE(co.is_completed());
+
+    co.cancel();
+    EXPECT_TRUE(co.is_cancelled());
+    EXPECT_NO_THROW(co.resume());
+
+    EXPECT_EQ(steps, 2);
+    EXPECT_TRUE(co.is_completed());
+    EXPECT_EQ(destroyed.load(), 1);
+}
+
+TEST(CortexCancellationTest, CoroutineUnwindsInsteadOfSuspending) {
+    std::atomic<int> destroyed {0};
+    bool after_suspend = false;
+    coroutine* self = nullptr;
+
+    auto routine = coroutine::make_routine([&] {
+        const unwind_probe probe(destroyed);
+        self->cancel();
+        self->suspend();
+        after_suspend = true;
+    });
+    auto co = coroutine::create(routine.get());
+    self = &co;
+
+    EXPECT_NO_THROW(co.resume());
+
+    EXPECT_FALSE(after_suspend);
+    EXPECT_TRUE(co.is_completed());
+    EXPECT_EQ(destroyed.load(), 1);
+}
+
+TEST(CortexCancellationTest, CoroutineStopToken) {
+    std::stop_source source;
+    coroutine* self = nullptr;
+    int steps = 0;
+
+    auto routine = coroutine::make_routine([&] {
+        while (true) {
+            ++steps;
+            self->suspend();
+        }
+    });
+    auto co = coroutine::create(routine.get());
+    self = &co;
+    co.cancel_on(source.get_token());
+
+    co.resume();
+    EXPECT_FALSE(co.is_cancelled());
+
+    source.request_stop();
+    EXPECT_TRUE(co.is_cancelled());
+    co.resume();
+
+    EXPECT_EQ(steps, 1);
+    EXPECT_TRUE(co.is_completed());
+}
+
+TEST(CortexCancellationTest, AlreadyStoppedToken) {
+    std::stop_source source;
+    source.request_stop();
+
+    auto routine = coroutine::make_routine([] {});
+    auto co = coroutine::create(routine.get());
+    co.cancel_on(source.get_token());
+
+    EXPECT_TRUE(co.is_cancelled());
+}
+
+TEST(CortexCancellationTest, FiberStopTokenFromAnotherThread) {
+    auto sched = work_stealing_scheduler::create(2);
+    std::stop_source source;
+    std::atomic<int> destroyed {0};
+    std::atomic<bool> running {false};
+
+    sched->spawn([&] {
+        fiber::current()->cancel_on(source.get_token());
+        const unwind_probe probe(destroyed);
+        running = true;
+        while (true) {
+            fiber::yield();
+        }
+    });
+
+    while (!running.load()) {
+        std::this_thread::yield();
+    }
+    source.request_stop();
+    EXPECT_NO_THROW(sched->wait());
+
+    EXPECT_EQ(destroyed.load(), 1);
+}
+
+TEST(CortexCancellationTest, SemaphoreAcquireIsCancellationPoint) {
+    auto sched = work_stealing_scheduler::create(1);
+    fiber_semaphore semaphore(1);
+    bool acquired = false;
+
+    sched->spawn([&] {
+        fiber::current()->cancel();
+        semaphore.acquire();
+        acquired = true;
+    });
+    sched->wait();
+
+    EXPECT_FALSE(acquired);
+    // The permit was left alone.
+    EXPECT_TRUE(semaphore.try_acquire());
+}
+
+TEST(CortexCancellationTest, ChannelReceiveIsCancellationPoint) {
+    auto sched = work_stealing_scheduler::create(1);
+    channel<int> ch(1);
+    std::atomic<int> destroyed {0};
+    std::atomic<fiber*> receiver {nullptr};
+
+    sched->spawn([&] {
+        const unwind_probe probe(destroyed);
+        receiver = fiber::current();
+        while (true) {
+            [[maybe_unused]] const std::optional<int> value = ch.receive();
+        }
+    });
+    sched->spawn([&] {
+        while (receiver.load() == nullptr) {
+            fiber::yield();
+        }
+        receiver.load()->cancel();
+        // Wakes the receiver, whose next receive unwinds.
+        ch.send(1);
+    });
+    sched->wait();
+
+    EXPECT_EQ(destroyed.load(), 1);
+}
+
+TEST(CortexCancellationTest, SleepUnwindsOnWakeUp) {
+    auto timers = timer_service::create();
+    auto sched = work_stealing_scheduler::create(1);
+    std::stop_source source;
+    int naps = 0;
+
+    sched->spawn([&] {
+        fiber::current()->cancel_on(source.get_token());
+        while (true) {
+            timers->sleep_for(1ms);
+            ++naps;
+            if (naps == 3) {
+                source.request_stop();
+            }
+        }
+    });
+    sched->wait();
+
+    EXPECT_EQ(naps, 3);
+}
+
+TEST(CortexCancellationTest, CancelWakesFiberParkedInReceive) {
+    channel<int> buffered(1);
+    expect_cancel_wakes([&] { [[maybe_unused]] const std::optional<int> value = buffered.receive(); });
+
+    channel<int> rendezvous;
+    expect_cancel_wakes([&] { [[maybe_unused]] const std::optional<int> value = rendezvous.receive(); });
+    // The cancelled receiver left the channel.
+    int one = 1;
+    EXPECT_FALSE(rendezvous.try_send(one));
+}
+
+TEST(CortexCancellationTest, CancelWakesSleepingFiber) {
+    auto timers = timer_service::create();
+    const auto start = std::chrono::steady_clock::now();
+    expect_cancel_wakes([&] { timers->sleep_for(1h); });
+
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 10s);
+    EXPECT_EQ(timers->pending(), 0);
+}
+
+TEST(CortexCancellationTest, CancelWakesFiberWaitingForDescriptor) {
+    auto r = reactor::create();
+    std::array<int, 2> fds {};
+    ASSERT_EQ(::pipe(fds.data()), 0);
+    auto reader = r->attach(fds[0]);
+    auto writer = r->attach(fds[1]);
+
+    expect_cancel_wakes([&] {
+        std::array<char, 16> buffer {};
+        [[maybe_unused]] const std::size_t size = reader->async_read(buffer.data(), buffer.size());
+    });
+
+    // The descriptor is free for the next reader.
+    auto sched = work_stealing_scheduler::create(1);
+    char received = 0;
+    sched->spawn([&] { [[maybe_unused]] const std::size_t size = reader->async_read(&received, 1); });
+    sched->spawn([&] { writer->async_write("x", 1); });
+    sched->wait();
+    EXPECT_EQ(received, 'x');
+}
+
+TEST(CortexCancellationTest, StopTokenWakesParkedFiber) {
+    auto sched = work_stealing_scheduler::create(1);
+    auto timers = timer_service::create();
+    std::stop_source source;
+    std::atomic<bool> sleeping {false};
+
+    sched->spawn([&] {
+        fiber::current()->cancel_on(source.get_token());
+        sleeping = true;
+        timers->sleep_for(1h);
+    });
+
+    while (!sleeping.load()) {
+        std::this_thread::yield();
+    }
+    source.request_stop();
+    EXPECT_NO_THROW(sched->wait());
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
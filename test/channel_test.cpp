@@ -0,0 +1,322 @@
+#include <cortex/channel.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/wait_group.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace cortex;
+
+TEST(CortexChannelTest, Capacity) {
+    EXPECT_EQ(channel<int>().capacity(), 0);
+    EXPECT_EQ(channel<int>(3).capacity(), 4);
+    EXPECT_EQ(spsc_channel<int>(16).capacity(), 16);
+    EXPECT_EQ(unbounded_channel<int>().capacity(), std::numeric_limits<std::size_t>::max());
+}
+
+TEST(CortexChannelTest, TrySendTryReceive) {
+    channel<std::string> ch(2);
+    std::string a = "a";
+    std::string b = "b";
+    std::string c = "c";
+
+    EXPECT_TRUE(ch.try_send(a));
+    EXPECT_TRUE(ch.try_send(b));
+    EXPECT_FALSE(ch.try_send(c));
+    EXPECT_EQ(c, "c");
+
+    EXPECT_EQ(ch.try_receive(), "a");
+    EXPECT_EQ(ch.try_receive(), "b");
+    EXPECT_FALSE(ch.try_receive().has_value());
+}
+
+TEST(CortexChannelTest, RendezvousNeedsReceiver) {
+    channel<int> ch;
+    int value = 1;
+
+    EXPECT_FALSE(ch.try_send(value));
+    EXPECT_FALSE(ch.try_receive().has_value());
+}
+
+TEST(CortexChannelTest, Close) {
+    channel<int> ch(4);
+    ch.send(1);
+    ch.send(2);
+    ch.close();
+    ch.close();
+
+    EXPECT_TRUE(ch.is_closed());
+    EXPECT_THROW(ch.send(3), channel_closed);
+    EXPECT_EQ(ch.receive(), 1);
+    EXPECT_EQ(ch.receive(), 2);
+    EXPECT_FALSE(ch.receive().has_value());
+}
+
+TEST(CortexChannelTest, WaitOutsideOfFiber) {
+    channel<int> ch(1);
+    EXPECT_THROW((void)ch.receive(), fiber::not_in_fiber);
+
+    ch.send(1);
+    EXPECT_THROW(ch.send(2), fiber::not_in_fiber);
+}
+
+TEST(CortexChannelTest, Rendezvous) {
+    auto sched = work_stealing_scheduler::create(1);
+    channel<int> ch;
+    bool sent = false;
+
+    sched->spawn([&] {
+        work_stealing_scheduler::current()->spawn([&] {
+            ch.send(1);
+            sent = true;
+        });
+
+        // The sender runs and parks, nobody has taken its value yet.
+        fiber::yield();
+        EXPECT_FALSE(sent);
+
+        EXPECT_EQ(ch.receive(), 1);
+        fiber::yield();
+        EXPECT_TRUE(sent);
+    });
+    sched->wait();
+}
+
+TEST(CortexChannelTest, ProducersConsumers) {
+    static constexpr int kProducers = 4;
+    static constexpr int kItems = 10000;
+
+    for (std::size_t capacity : {0U, 1U, 64U}) {
+        auto sched = work_stealing_scheduler::create(4);
+        channel<int> ch(capacity);
+        wait_group producers(kProducers);
+        std::atomic<std::int64_t> sum {0};
+        std::atomic<int> received {0};
+
+        for (int p = 0; p < kProducers; ++p) {
+            sched->spawn([&] {
+                for (int i = 1; i <= kItems; ++i) {
+                    ch.send(i);
+                }
+                producers.done();
+            });
+            sched->spawn([&] {
+                while (auto value = ch.receive()) {
+                    sum += *value;
+                    ++received;
+                }
+            });
+        }
+        sched->spawn([&] {
+            producers.wait();
+            ch.close();
+        });
+        sched->wait();
+
+        EXPECT_EQ(received.load(), kProducers * kItems) << "capacity " << capacity;
+        EXPECT_EQ(sum.load(), static_cast<std::int64_t>(kProducers) * kItems * (kItems + 1) / 2);
+    }
+}
+
+TEST(CortexChannelTest, SpscChannelKeepsOrder) {
+    static constexpr int kItems = 100000;
+    auto sched = work_stealing_scheduler::create(2);
+    spsc_channel<int> ch(16);
+    int expected = 0;
+
+    sched->spawn([&] {
+        for (int i = 0; i < kItems; ++i) {
+            ch.send(i);
+        }
+        ch.close();
+    });
+    sched->spawn([&] {
+        while (auto value = ch.receive()) {
+            EXPECT_EQ(*value, expected++);
+        }
+    });
+    sched->wait();
+
+    EXPECT_EQ(expected, kItems);
+}
+
+TEST(CortexChannelTest, UnboundedChannelNeverFills) {
+    static constexpr int kItems = 1000;
+    unbounded_channel<int> ch(4);
+
+    // Outside of a fiber: a send that had to wait would throw.
+    for (int i = 0; i < kItems; ++i) {
+        ch.send(i);
+    }
+    ch.close();
+
+    for (int i = 0; i < kItems; ++i) {
+        EXPECT_EQ(ch.receive(), i);
+    }
+    EXPECT_FALSE(ch.receive().has_value());
+}
+
+TEST(CortexChannelTest, UnboundedChannelWakesReceiver) {
+    static constexpr int kProducers = 4;
+    static constexpr int kItems = 10000;
+    auto sched = work_stealing_scheduler::create(4);
+    unbounded_channel<int> ch;
+    wait_group producers(kProducers);
+    std::atomic<std::int64_t> sum {0};
+
+    for (int p = 0; p < kProducers; ++p) {
+        sched->spawn([&] {
+            for (int i = 1; i <= kItems; ++i) {
+                ch.send(i);
+            }
+            producers.done();
+        });
+    }
+    sched->spawn([&] {
+        while (auto value = ch.receive()) {
+            sum += *value;
+        }
+    });
+    sched->spawn([&] {
+        producers.wait();
+        ch.close();
+    });
+    sched->wait();
+
+    EXPECT_EQ(sum.load(), static_cast<std::int64_t>(kProducers) * kItems * (kItems + 1) / 2);
+}
+
+TEST(CortexChannelTest, TrySelect) {
+    channel<int> a(1);
+    channel<int> b(1);
+    std::optional<int> from_a;
+    std::optional<int> from_b;
+
+    EXPECT_EQ(try_select(a.on_receive(from_a), b.on_receive(from_b)), select_none);
+
+    b.send(7);
+    EXPECT_EQ(try_select(a.on_receive(from_a), b.on_receive(from_b)), 1);
+    EXPECT_FALSE(from_a.has_value());
+    EXPECT_EQ(from_b, 7);
+
+    int value = 8;
+    EXPECT_EQ(try_select(a.on_send(value), b.on_receive(from_b)), 0);
+    EXPECT_EQ(a.receive(), 8);
+}
+
+TEST(CortexChannelTest, SelectWaitsForAnyChannel) {
+    auto sched = work_stealing_scheduler::create(2);
+    channel<int> numbers;
+    channel<std::string> words;
+    channel<int> done;
+    std::vector<std::string> trace;
+
+    sched->spawn([&] {
+        std::optional<int> number;
+        std::optional<std::string> word;
+        std::optional<int> stop;
+        while (true) {
+            const std::size_t fired = select(numbers.on_receive(number), words.on_receive(word), done.on_receive(stop));
+            if (fired == 0) {
+                trace.push_back(std::to_string(*number));
+            } else if (fired == 1) {
+                trace.push_back(*word);
+            } else {
+                // Woken by `close`.
+                EXPECT_FALSE(stop.has_value());
+                break;
+            }
+        }
+    });
+    sched->spawn([&] {
+        numbers.send(1);
+        words.send("two");
+        numbers.send(3);
+        numbers.send(4);
+        done.close();
+    });
+    sched->wait();
+
+    EXPECT_EQ(trace, (std::vector<std::string> {"1", "two", "3", "4"}));
+}
+
+TEST(CortexChannelTest, SelectSendAndReceive) {
+    auto sched = work_stealing_scheduler::create(2);
+    channel<int> in;
+    channel<int> out;
+    std::vector<int> results;
+
+    // Forwards every value of `in` to `out`, accepting a new value only while the previous one is not taken.
+    sched->spawn([&] {
+        std::optional<int> pending;
+        while (true) {
+            if (!pending.has_value()) {
+                pending = in.receive();
+                if (!pending.has_value()) {
+                    out.close();
+                    return;
+                }
+            }
+
+            std::optional<int> next;
+            if (select(out.on_send(*pending), in.on_receive(next)) == 0) {
+                pending.reset();
+            } else if (next.has_value()) {
+                *pending += *next;
+            } else {
+                out.send(*pending);
+                out.close();
+                return;
+            }
+        }
+    });
+    sched->spawn([&] {
+        for (int i = 1; i <= 100; ++i) {
+            in.send(i);
+        }
+        in.close();
+    });
+    sched->spawn([&] {
+        while (auto value = out.receive()) {
+            results.push_back(*value);
+        }
+    });
+    sched->wait();
+
+    // Values are merged while the consumer is busy, none of them is lost.
+    std::int64_t sum = 0;
+    for (int value : results) {
+        sum += value;
+    }
+    EXPECT_EQ(sum, 5050);
+}
+
+TEST(CortexChannelTest, SendToClosedChannelWakesSender) {
+    auto sched = work_stealing_scheduler::create(1);
+    channel<int> ch(1);
+    bool thrown = false;
+
+    sched->spawn([&] {
+        ch.send(1);
+        try {
+            ch.send(2);
+        } catch (const channel_closed&) {
+            thrown = true;
+        }
+    });
+    sched->spawn([&] { ch.close(); });
+    sched->wait();
+
+    EXPECT_TRUE(thrown);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,55 @@
+#include <cortex/error.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/fiber_barrier.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+using namespace cortex;
+
+TEST(CortexFiberBarrierTest, ZeroParties) {
+    EXPECT_THROW(fiber_barrier(0), invalid_argument_error);
+}
+
+TEST(CortexFiberBarrierTest, SingleParty) {
+    fiber_barrier barrier(1);
+    EXPECT_TRUE(barrier.arrive_and_wait());
+    EXPECT_TRUE(barrier.arrive_and_wait());
+}
+
+TEST(CortexFiberBarrierTest, WaitOutsideOfFiber) {
+    fiber_barrier barrier(2);
+    EXPECT_THROW(barrier.arrive_and_wait(), fiber::not_in_fiber);
+}
+
+TEST(CortexFiberBarrierTest, Phases) {
+    static constexpr int kParties = 8;
+    static constexpr int kPhases = 50;
+
+    auto sched = work_stealing_scheduler::create(4);
+    fiber_barrier barrier(kParties);
+    std::atomic<int> arrivals[kPhases] = {};
+    std::atomic<int> serial {0};
+
+    for (int i = 0; i < kParties; ++i) {
+        sched->spawn([&] {
+            for (int phase = 0; phase < kPhases; ++phase) {
+                ++arrivals[phase];
+                if (barrier.arrive_and_wait()) {
+                    ++serial;
+                }
+                // Nobody leaves a phase before everybody arrived.
+                EXPECT_EQ(arrivals[phase].load(), kParties);
+            }
+        });
+    }
+    sched->wait();
+
+    EXPECT_EQ(serial.load(), kPhases);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,210 @@
+#include <cortex/fiber.hpp>
+#include <cortex/fiber_condition_variable.hpp>
+#include <cortex/fiber_mutex.hpp>
+#include <cortex/timer_service.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+using namespace cortex;
+using namespace std::chrono_literals;
+
+TEST(CortexFiberConditionVariableTest, WaitOutsideOfFiber) {
+    fiber_mutex mutex;
+    fiber_condition_variable cv;
+    std::unique_lock lock(mutex);
+
+    EXPECT_THROW(cv.wait(lock), fiber::not_in_fiber);
+    EXPECT_TRUE(lock.owns_lock());
+}
+
+TEST(CortexFiberConditionVariableTest, NotifyOne) {
+    auto sched = work_stealing_scheduler::create(1);
+    fiber_mutex mutex;
+    fiber_condition_variable cv;
+    bool ready = false;
+    bool woken = false;
+
+    sched->spawn([&] {
+        std::unique_lock lock(mutex);
+        cv.wait(lock, [&] { return ready; });
+        woken = true;
+    });
+    sched->spawn([&] {
+        std::lock_guard guard(mutex);
+        EXPECT_FALSE(woken);
+        ready = true;
+        cv.notify_one();
+    });
+    sched->wait();
+
+    EXPECT_TRUE(woken);
+}
+
+TEST(CortexFiberConditionVariableTest, ProducerConsumers) {
+    static constexpr int kItems = 10000;
+    static constexpr int kConsumers = 8;
+
+    auto sched = work_stealing_scheduler::create(4);
+    fiber_mutex mutex;
+    fiber_condition_variable cv;
+    std::deque<int> queue;
+    bool closed = false;
+    long long sum = 0;
+
+    for (int c = 0; c < kConsumers; ++c) {
+        sched->spawn([&] {
+            while (true) {
+                std::unique_lock lock(mutex);
+                cv.wait(lock, [&] { return closed || !queue.empty(); });
+                if (queue.empty()) {
+                    return;
+                }
+                sum += queue.front();
+                queue.pop_front();
+            }
+        });
+    }
+
+    sched->spawn([&] {
+        for (int i = 1; i <= kItems; ++i) {
+            std::lock_guard guard(mutex);
+            queue.push_back(i);
+            cv.notify_one();
+        }
+
+        std::lock_guard guard(mutex);
+        closed = true;
+        cv.notify_all();
+    });
+    sched->wait();
+
+    EXPECT_EQ(sum, 1LL * kItems * (kItems + 1) / 2);
+}
+
+TEST(CortexFiberConditionVariableTest, WaitForTimesOut) {
+    auto timers = timer_service::create();
+    auto sched = work_stealing_scheduler::create(1);
+    fiber_mutex mutex;
+    fiber_condition_variable cv;
+    std::cv_status status = std::cv_status::no_timeout;
+    bool owns_lock = false;
+
+    sched->spawn([&] {
+        std::unique_lock lock(mutex);
+        status = cv.wait_for(lock, *timers, 10ms);
+        owns_lock = lock.owns_lock();
+    });
+    sched->wait();
+
+    EXPECT_EQ(status, std::cv_status::timeout);
+    EXPECT_TRUE(owns_lock);
+    EXPECT_EQ(timers->pending(), 0);
+}
+
+TEST(CortexFiberConditionVariableTest, WaitForNotifiedBeforeDeadline) {
+    auto timers = timer_service::create();
+    auto sched = work_stealing_scheduler::create(2);
+    fiber_mutex mutex;
+    fiber_condition_variable cv;
+    bool ready = false;
+    bool satisfied = false;
+
+    sched->spawn([&] {
+        std::unique_lock lock(mutex);
+        satisfied = cv.wait_for(lock, *timers, 10s, [&] { return ready; });
+    });
+    sched->spawn([&] {
+        timers->sleep_for(5ms);
+        std::lock_guard guard(mutex);
+        ready = true;
+        cv.notify_one();
+    });
+    sched->wait();
+
+    EXPECT_TRUE(satisfied);
+    // The timer of the notified waiter was cancelled.
+    EXPECT_EQ(timers->pending(), 0);
+}
+
+TEST(CortexFiberConditionVariableTest, TimedOutWaiterLeavesQueue) {
+    auto timers = timer_service::create();
+    auto sched = work_stealing_scheduler::create(2);
+    fiber_mutex mutex;
+    fiber_condition_variable cv;
+    std::atomic<int> timed_out {0};
+    bool ready = false;
+    bool woken = false;
+
+    // The impatient waiters leave the queue, so the notification reaches the patient one.
+    for (int i = 0; i < 4; ++i) {
+        sched->spawn([&] {
+            std::unique_lock lock(mutex);
+            if (cv.wait_for(lock, *timers, 5ms) == std::cv_status::timeout) {
+                ++timed_out;
+            }
+        });
+    }
+    sched->spawn([&] {
+        std::unique_lock lock(mutex);
+        cv.wait(lock, [&] { return ready; });
+        woken = true;
+    });
+    sched->spawn([&] {
+        timers->sleep_for(30ms);
+        std::lock_guard guard(mutex);
+        ready = true;
+        cv.notify_one();
+    });
+    sched->wait();
+
+    EXPECT_EQ(timed_out.load(), 4);
+    EXPECT_TRUE(woken);
+}
+
+TEST(CortexFiberConditionVariableTest, TimedWaitRace) {
+    static constexpr int kRounds = 2000;
+    auto timers = timer_service::create();
+    auto sched = work_stealing_scheduler::create(4);
+    fiber_mutex mutex;
+    fiber_condition_variable cv;
+    int produced = 0;
+    int consumed = 0;
+
+    // Notifications and expirations race, no item may be lost and no waiter may hang.
+    sched->spawn([&] {
+        while (true) {
+            std::unique_lock lock(mutex);
+            cv.wait_for(lock, *timers, 1ms, [&] { return consumed < produced; });
+            if (consumed < produced) {
+                ++consumed;
+            }
+            if (consumed == kRounds) {
+                return;
+            }
+        }
+    });
+    sched->spawn([&] {
+        for (int i = 0; i < kRounds; ++i) {
+            if (i % 64 == 0) {
+                timers->sleep_for(1ms);
+            }
+            std::lock_guard guard(mutex);
+            ++produced;
+            cv.notify_one();
+        }
+    });
+    sched->wait();
+
+    EXPECT_EQ(consumed, kRounds);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
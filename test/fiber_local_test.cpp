@@ -0,0 +1,147 @@
+#include <cortex/coroutine.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/fiber_local.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <optional>
+#include <string>
+#include <thread>
+
+using namespace cortex;
+
+namespace {
+
+/// Counts the live values.
+struct tracked {
+    tracked() {
+        ++alive;
+    }
+
+    tracked(const tracked&) = delete;
+    tracked(tracked&&) = delete;
+    tracked& operator=(const tracked&) = delete;
+    tracked& operator=(tracked&&) = delete;
+
+    ~tracked() {
+        --alive;
+    }
+
+    int value = 0;
+
+    static inline std::atomic<int> alive {0};
+};
+
+fiber_local<int> local_int;
+fiber_local<std::string> local_string;
+fiber_local<tracked> local_tracked;
+
+} // namespace
+
+TEST(CortexFiberLocalTest, ThreadValueOutsideOfExecutions) {
+    *local_int = 5;
+    EXPECT_EQ(local_int.get(), 5);
+
+    std::optional<int> other;
+    std::thread([&] { other = local_int.get(); }).join();
+
+    EXPECT_EQ(other, 0);
+    EXPECT_EQ(local_int.get(), 5);
+}
+
+TEST(CortexFiberLocalTest, CoroutinesHaveOwnValues) {
+    coroutine* first_self = nullptr;
+    auto first_routine = coroutine::make_routine([&] {
+        EXPECT_FALSE(local_string.has_value());
+        *local_string = "first";
+        first_self->suspend();
+        EXPECT_EQ(*local_string, "first");
+    });
+    auto second_routine = coroutine::make_routine([&] { *local_string = "second"; });
+
+    auto first = coroutine::create(first_routine.get());
+    first_self = &first;
+    auto second = coroutine::create(second_routine.get());
+
+    *local_string = "thread";
+    first.resume();
+    second.resume();
+    first.resume();
+
+    EXPECT_TRUE(first.is_completed());
+    EXPECT_EQ(*local_string, "thread");
+}
+
+TEST(CortexFiberLocalTest, NestedExecutions) {
+    coroutine* inner_self = nullptr;
+    auto inner_routine = coroutine::make_routine([&] {
+        *local_int = 2;
+        inner_self->suspend();
+        EXPECT_EQ(*local_int, 2);
+    });
+    auto inner = coroutine::create(inner_routine.get());
+    inner_self = &inner;
+
+    auto outer_routine = coroutine::make_routine([&] {
+        *local_int = 1;
+        inner.resume();
+        EXPECT_EQ(*local_int, 1);
+        inner.resume();
+        EXPECT_EQ(*local_int, 1);
+    });
+    auto outer = coroutine::create(outer_routine.get());
+    outer.resume();
+
+    EXPECT_TRUE(inner.is_completed());
+    EXPECT_TRUE(outer.is_completed());
+}
+
+TEST(CortexFiberLocalTest, ValuesDieWithTheirStacks) {
+    coroutine* self = nullptr;
+    auto routine = coroutine::make_routine([&] {
+        local_tracked->value = 1;
+        self->suspend();
+    });
+
+    {
+        auto short_routine = coroutine::make_routine([] { local_tracked->value = 1; });
+        auto completed = coroutine::create(short_routine.get());
+        completed.resume();
+        EXPECT_EQ(tracked::alive.load(), 0);
+    }
+
+    {
+        auto abandoned = coroutine::create(routine.get());
+        self = &abandoned;
+        abandoned.resume();
+        EXPECT_EQ(tracked::alive.load(), 1);
+    }
+    EXPECT_EQ(tracked::alive.load(), 0);
+}
+
+TEST(CortexFiberLocalTest, FibersKeepValuesAcrossThreads) {
+    static constexpr int kFibers = 200;
+    auto sched = work_stealing_scheduler::create(4);
+    std::atomic<int> mismatches {0};
+
+    for (int i = 0; i < kFibers; ++i) {
+        sched->spawn([&, i] {
+            *local_int = i;
+            for (int j = 0; j < 50; ++j) {
+                fiber::yield();
+                if (*local_int != i) {
+                    ++mismatches;
+                }
+            }
+        });
+    }
+    sched->wait();
+
+    EXPECT_EQ(mismatches.load(), 0);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
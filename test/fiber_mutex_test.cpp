@@ -0,0 +1,80 @@
+#include <cortex/fiber.hpp>
+#include <cortex/fiber_mutex.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <vector>
+
+using namespace cortex;
+
+TEST(CortexFiberMutexTest, TryLock) {
+    fiber_mutex mutex;
+
+    EXPECT_TRUE(mutex.try_lock());
+    EXPECT_FALSE(mutex.try_lock());
+    mutex.unlock();
+    EXPECT_TRUE(mutex.try_lock());
+    mutex.unlock();
+}
+
+TEST(CortexFiberMutexTest, ContendedLockOutsideOfFiber) {
+    fiber_mutex mutex;
+
+    // Uncontended locking does not need a fiber.
+    EXPECT_NO_THROW(mutex.lock());
+    EXPECT_THROW(mutex.lock(), fiber::not_in_fiber);
+    mutex.unlock();
+    EXPECT_TRUE(mutex.try_lock());
+    mutex.unlock();
+}
+
+TEST(CortexFiberMutexTest, HolderParksWithoutBlockingTheThread) {
+    auto sched = work_stealing_scheduler::create(1);
+    fiber_mutex mutex;
+    std::vector<int> trace;
+
+    sched->spawn([&] {
+        std::lock_guard guard(mutex);
+        trace.push_back(0);
+        work_stealing_scheduler::current()->spawn([&] {
+            trace.push_back(1);
+            std::lock_guard inner(mutex);
+            trace.push_back(3);
+        });
+        // With one worker the second fiber can only run if the first one does not block the thread.
+        while (trace.size() < 2) {
+            fiber::yield();
+        }
+        trace.push_back(2);
+    });
+    sched->wait();
+
+    EXPECT_EQ(trace, (std::vector<int> {0, 1, 2, 3}));
+}
+
+TEST(CortexFiberMutexTest, MutualExclusion) {
+    auto sched = work_stealing_scheduler::create(4);
+    fiber_mutex mutex;
+    std::size_t counter = 0;
+
+    for (int i = 0; i < 16; ++i) {
+        sched->spawn([&] {
+            for (int j = 0; j < 1000; ++j) {
+                std::lock_guard guard(mutex);
+                ++counter;
+                if (j % 100 == 0) {
+                    fiber::yield();
+                }
+            }
+        });
+    }
+    sched->wait();
+
+    EXPECT_EQ(counter, 16000);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
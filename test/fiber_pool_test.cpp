@@ -0,0 +1,276 @@
+#include <cortex/api/scheduler.hpp>
+#include <cortex/error.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/fiber_local.hpp>
+#include <cortex/fiber_pool.hpp>
+#include <cortex/this_coroutine.hpp>
+#include <cortex/wait_group.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory_resource>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace cortex;
+
+namespace {
+
+struct MyException : std::exception {};
+
+/// Counts the blocks taken from it and not given back.
+struct counting_resource : std::pmr::memory_resource {
+    std::atomic<std::size_t> outstanding {0};
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++outstanding;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        --outstanding;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+/// Forwards to another scheduler, spawning fails while `fail` is set.
+struct failing_scheduler final : api::scheduler {
+    explicit failing_scheduler(api::scheduler& target)
+        : inner(target) {}
+
+    void spawn(std::function<void()> routine) override {
+        if (fail.load()) {
+            throw MyException();
+        }
+        inner.spawn(std::move(routine));
+    }
+
+    void schedule(fiber& f) override {
+        inner.schedule(f);
+    }
+
+    void reschedule(fiber& f) override {
+        inner.reschedule(f);
+    }
+
+    api::scheduler& inner;
+    std::atomic<bool> fail {false};
+};
+
+} // namespace
+
+TEST(CortexFiberPoolTest, InvalidArguments) {
+    auto sched = work_stealing_scheduler::create(1);
+    EXPECT_THROW(fiber_pool::create(*sched, {.min_workers = 0, .max_workers = 0}), invalid_argument_error);
+    EXPECT_THROW(fiber_pool::create(*sched, {.min_workers = 4, .max_workers = 2}), invalid_argument_error);
+
+    auto pool = fiber_pool::create(*sched);
+    EXPECT_THROW(pool->spawn(nullptr), invalid_argument_error);
+}
+
+TEST(CortexFiberPoolTest, WorkersArePrewarmedAndReused) {
+    auto sched = work_stealing_scheduler::create(1);
+    auto pool = fiber_pool::create(*sched, {.min_workers = 2, .max_workers = 2, .max_idle = 2});
+    std::vector<fiber*> runners;
+
+    for (int i = 0; i < 100; ++i) {
+        pool->spawn([&] { runners.push_back(fiber::current()); });
+        pool->wait();
+    }
+
+    EXPECT_EQ(pool->workers(), 2);
+    EXPECT_EQ(runners.size(), 100);
+    // Every task ran on one of the two pre-warmed fibers.
+    EXPECT_LE(std::set<fiber*>(runners.begin(), runners.end()).size(), 2);
+}
+
+TEST(CortexFiberPoolTest, GrowsWithTheLoadAndShrinksWhenIdle) {
+    auto sched = work_stealing_scheduler::create(2);
+    auto pool = fiber_pool::create(*sched, {.min_workers = 1, .max_workers = 64, .max_idle = 4});
+    wait_group started;
+    wait_group release;
+    started.add(32);
+    release.add(1);
+
+    // Tasks that park until all of them run at once, so each one needs a worker of its own.
+    for (int i = 0; i < 32; ++i) {
+        pool->spawn([&] {
+            started.done();
+            release.wait();
+        });
+    }
+    pool->spawn([&] {
+        started.wait();
+        release.done();
+    });
+    pool->wait();
+
+    // Only the idle workers within the limit, or the minimum, stay around once they have all looked for more work.
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (pool->workers() > 4 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    EXPECT_LE(pool->workers(), 4);
+    EXPECT_GE(pool->workers(), 1);
+}
+
+TEST(CortexFiberPoolTest, CapsTheWorkers) {
+    auto sched = work_stealing_scheduler::create(2);
+    auto pool = fiber_pool::create(*sched, {.min_workers = 0, .max_workers = 3, .max_idle = 3});
+    std::atomic<int> running {0};
+    std::atomic<int> peak {0};
+
+    for (int i = 0; i < 100; ++i) {
+        pool->spawn([&] {
+            const int now = ++running;
+            int seen = peak.load();
+            while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+            }
+            fiber::yield();
+            --running;
+        });
+    }
+    pool->wait();
+
+    EXPECT_LE(peak.load(), 3);
+    EXPECT_LE(pool->workers(), 3);
+}
+
+TEST(CortexFiberPoolTest, FailedWorkerSpawnWithdrawsTheTask) {
+    auto sched = work_stealing_scheduler::create(1);
+    failing_scheduler failing(*sched);
+    auto pool = fiber_pool::create(failing, {.min_workers = 0, .max_workers = 2, .max_idle = 2});
+    std::atomic<int> ran {0};
+
+    // No worker is left to run the task, so it is not queued.
+    failing.fail = true;
+    EXPECT_THROW(pool->spawn([&] { ++ran; }), MyException);
+    EXPECT_EQ(pool->workers(), 0);
+    pool->wait();
+    EXPECT_EQ(ran.load(), 0);
+
+    failing.fail = false;
+    pool->spawn([&] { ++ran; });
+    pool->wait();
+    EXPECT_EQ(ran.load(), 1);
+}
+
+TEST(CortexFiberPoolTest, FailedWorkerSpawnLeavesTheTaskToARunningWorker) {
+    auto sched = work_stealing_scheduler::create(1);
+    failing_scheduler failing(*sched);
+    auto pool = fiber_pool::create(failing, {.min_workers = 0, .max_workers = 2, .max_idle = 2});
+    std::atomic<bool> started {false};
+    std::atomic<bool> release {false};
+    std::atomic<int> ran {0};
+
+    pool->spawn([&] {
+        started = true;
+        while (!release.load()) {
+            fiber::yield();
+        }
+        ++ran;
+    });
+    while (!started.load()) {
+        std::this_thread::yield();
+    }
+
+    // The busy worker takes the task once it is done, so the spawn succeeds.
+    failing.fail = true;
+    EXPECT_NO_THROW(pool->spawn([&] { ++ran; }));
+    release = true;
+    pool->wait();
+
+    EXPECT_EQ(ran.load(), 2);
+}
+
+TEST(CortexFiberPoolTest, WaitRethrows) {
+    auto sched = work_stealing_scheduler::create(1);
+    auto pool = fiber_pool::create(*sched);
+    std::atomic<int> counter {0};
+
+    pool->spawn([] { throw MyException(); });
+    pool->spawn([&] { ++counter; });
+
+    EXPECT_THROW(pool->wait(), MyException);
+    EXPECT_NO_THROW(pool->wait());
+    EXPECT_EQ(counter.load(), 1);
+}
+
+TEST(CortexFiberPoolTest, SpawnFromWorkers) {
+    auto sched = work_stealing_scheduler::create(2);
+    auto pool = fiber_pool::create(*sched);
+    std::atomic<int> counter {0};
+
+    for (int i = 0; i < 10; ++i) {
+        pool->spawn([&] {
+            EXPECT_THROW(pool->wait(), fiber_pool::wait_from_worker);
+            for (int j = 0; j < 100; ++j) {
+                pool->spawn([&] { ++counter; });
+            }
+        });
+    }
+    pool->wait();
+
+    EXPECT_EQ(counter.load(), 1000);
+}
+
+TEST(CortexFiberPoolTest, ArenaIsReleasedAfterEachTask) {
+    counting_resource upstream;
+    std::pmr::memory_resource* prev = std::pmr::set_default_resource(&upstream);
+    auto sched = work_stealing_scheduler::create(1);
+    auto pool = fiber_pool::create(*sched, {.min_workers = 1, .max_workers = 1, .max_idle = 1});
+    std::vector<fiber*> runners;
+
+    for (int i = 0; i < 10; ++i) {
+        pool->spawn([&] {
+            runners.push_back(fiber::current());
+            std::pmr::memory_resource* arena = this_coroutine::memory_resource();
+            for (int j = 0; j < 1000; ++j) {
+                [[maybe_unused]] void* p = arena->allocate(64, alignof(std::max_align_t));
+            }
+        });
+        pool->wait();
+        // The worker lives on, but the blocks of the task are gone.
+        EXPECT_EQ(upstream.outstanding.load(), 0);
+    }
+
+    EXPECT_EQ(std::set<fiber*>(runners.begin(), runners.end()).size(), 1);
+    pool.reset();
+    sched.reset();
+    std::pmr::set_default_resource(prev);
+}
+
+TEST(CortexFiberPoolTest, FiberLocalsAreResetBetweenTasks) {
+    static fiber_local<int> value;
+    auto sched = work_stealing_scheduler::create(1);
+    auto pool = fiber_pool::create(*sched, {.min_workers = 1, .max_workers = 1, .max_idle = 1});
+    std::vector<int> seen;
+
+    for (int i = 1; i <= 3; ++i) {
+        pool->spawn([&, i] {
+            seen.push_back(*value);
+            *value = i;
+            // Still a worker of the pool once its fiber-local values are gone.
+            EXPECT_THROW(pool->wait(), fiber_pool::wait_from_worker);
+        });
+        pool->wait();
+    }
+
+    EXPECT_EQ(seen, (std::vector<int> {0, 0, 0}));
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,81 @@
+#include <cortex/fiber.hpp>
+#include <cortex/fiber_semaphore.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+using namespace cortex;
+
+TEST(CortexFiberSemaphoreTest, TryAcquire) {
+    fiber_semaphore sem(2);
+
+    EXPECT_TRUE(sem.try_acquire());
+    EXPECT_TRUE(sem.try_acquire());
+    EXPECT_FALSE(sem.try_acquire());
+    sem.release();
+    EXPECT_TRUE(sem.try_acquire());
+}
+
+TEST(CortexFiberSemaphoreTest, AcquireOutsideOfFiber) {
+    fiber_semaphore sem(1);
+
+    EXPECT_NO_THROW(sem.acquire());
+    EXPECT_THROW(sem.acquire(), fiber::not_in_fiber);
+    sem.release();
+    EXPECT_TRUE(sem.try_acquire());
+}
+
+TEST(CortexFiberSemaphoreTest, BoundsConcurrency) {
+    static constexpr int kLimit = 3;
+
+    auto sched = work_stealing_scheduler::create(4);
+    fiber_semaphore sem(kLimit);
+    std::atomic<int> inside {0};
+    std::atomic<int> peak {0};
+    std::atomic<int> done {0};
+
+    for (int i = 0; i < 64; ++i) {
+        sched->spawn([&] {
+            for (int j = 0; j < 20; ++j) {
+                sem.acquire();
+                const int now = ++inside;
+                int seen = peak.load();
+                while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+                }
+                fiber::yield();
+                --inside;
+                sem.release();
+            }
+            ++done;
+        });
+    }
+    sched->wait();
+
+    EXPECT_EQ(done.load(), 64);
+    EXPECT_LE(peak.load(), kLimit);
+    EXPECT_GE(peak.load(), 1);
+}
+
+TEST(CortexFiberSemaphoreTest, ReleaseMany) {
+    auto sched = work_stealing_scheduler::create(2);
+    fiber_semaphore sem(0);
+    std::atomic<int> passed {0};
+
+    for (int i = 0; i < 10; ++i) {
+        sched->spawn([&] {
+            sem.acquire();
+            ++passed;
+        });
+    }
+    sched->spawn([&] { sem.release(10); });
+    sched->wait();
+
+    EXPECT_EQ(passed.load(), 10);
+    EXPECT_FALSE(sem.try_acquire());
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,275 @@
+#include <cortex/fiber.hpp>
+#include <cortex/future.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace cortex;
+
+namespace {
+
+struct MyException : std::exception {};
+
+} // namespace
+
+TEST(CortexFutureTest, ReadyFutureOutsideOfFiber) {
+    promise<int> p;
+    auto f = p.get_future();
+    EXPECT_TRUE(f.valid());
+    EXPECT_FALSE(f.is_ready());
+
+    p.set_value(42);
+    EXPECT_TRUE(f.is_ready());
+    EXPECT_EQ(f.get(), 42);
+    EXPECT_FALSE(f.valid());
+    EXPECT_THROW(f.get(), no_future_state);
+}
+
+TEST(CortexFutureTest, WaitOutsideOfFiber) {
+    promise<int> p;
+    auto f = p.get_future();
+    EXPECT_THROW(f.wait(), fiber::not_in_fiber);
+}
+
+TEST(CortexFutureTest, GetParksFiber) {
+    auto sched = work_stealing_scheduler::create(1);
+    promise<std::string> p;
+    auto f = p.get_future();
+    std::string result;
+
+    sched->spawn([&] { result = f.get(); });
+    // With a single worker the setter only runs because the getter parked.
+    sched->spawn([&] { p.set_value("done"); });
+    sched->wait();
+
+    EXPECT_EQ(result, "done");
+}
+
+TEST(CortexFutureTest, SetFromForeignThread) {
+    auto sched = work_stealing_scheduler::create(2);
+    promise<void> p;
+    auto f = p.get_future();
+    std::atomic<bool> got {false};
+
+    sched->spawn([&] {
+        f.get();
+        got = true;
+    });
+    std::thread setter([&] { p.set_value(); });
+    setter.join();
+    sched->wait();
+
+    EXPECT_TRUE(got.load());
+}
+
+TEST(CortexFutureTest, ExceptionAndBrokenPromise) {
+    promise<int> failed;
+    auto f1 = failed.get_future();
+    failed.set_exception(std::make_exception_ptr(MyException()));
+    EXPECT_THROW(f1.get(), MyException);
+
+    future<int> f2;
+    {
+        promise<int> abandoned;
+        f2 = abandoned.get_future();
+    }
+    EXPECT_THROW(f2.get(), broken_promise);
+}
+
+TEST(CortexFutureTest, MisuseIsReported) {
+    promise<int> p;
+    auto f = p.get_future();
+    EXPECT_THROW(static_cast<void>(p.get_future()), future_already_retrieved);
+
+    p.set_value(1);
+    EXPECT_THROW(p.set_value(2), promise_already_satisfied);
+    EXPECT_THROW(p.set_exception(std::make_exception_ptr(MyException())), promise_already_satisfied);
+    EXPECT_EQ(f.get(), 1);
+
+    promise<int> moved_from;
+    promise<int> target = std::move(moved_from);
+    EXPECT_THROW(moved_from.set_value(1), no_future_state); // NOLINT(bugprone-use-after-move)
+}
+
+TEST(CortexFutureTest, MoveOnlyValue) {
+    promise<std::unique_ptr<int>> p;
+    auto f = p.get_future();
+    p.set_value(std::make_unique<int>(7));
+    EXPECT_EQ(*f.get(), 7);
+}
+
+TEST(CortexFutureTest, WhenAllScatterGather) {
+    static constexpr std::size_t kBackends = 32;
+    auto sched = work_stealing_scheduler::create(4);
+    std::vector<promise<std::size_t>> promises(kBackends);
+    std::size_t sum = 0;
+
+    std::vector<future<std::size_t>> futures;
+    futures.reserve(kBackends);
+    for (auto& p : promises) {
+        futures.push_back(p.get_future());
+    }
+
+    sched->spawn([&] {
+        auto all = when_all(std::move(futures));
+        for (auto& f : all.get()) {
+            EXPECT_TRUE(f.is_ready());
+            sum += f.get();
+        }
+    });
+    for (std::size_t i = 0; i < kBackends; ++i) {
+        sched->spawn([&, i] {
+            fiber::yield();
+            promises[i].set_value(i);
+        });
+    }
+    sched->wait();
+
+    EXPECT_EQ(sum, kBackends * (kBackends - 1) / 2);
+}
+
+TEST(CortexFutureTest, WhenAllKeepsFailures) {
+    promise<int> ok;
+    promise<int> failed;
+    std::vector<future<int>> futures;
+    futures.push_back(ok.get_future());
+    futures.push_back(failed.get_future());
+
+    auto all = when_all(std::move(futures));
+    failed.set_exception(std::make_exception_ptr(MyException()));
+    EXPECT_FALSE(all.is_ready());
+    ok.set_value(1);
+    ASSERT_TRUE(all.is_ready());
+
+    auto results = all.get();
+    EXPECT_EQ(results[0].get(), 1);
+    EXPECT_THROW(results[1].get(), MyException);
+}
+
+TEST(CortexFutureTest, WhenAnyPicksFirst) {
+    auto sched = work_stealing_scheduler::create(2);
+    std::vector<promise<int>> promises(8);
+    std::vector<future<int>> futures;
+    for (auto& p : promises) {
+        futures.push_back(p.get_future());
+    }
+    when_any_result<int> result;
+
+    sched->spawn([&] { result = when_any(std::move(futures)).get(); });
+    sched->spawn([&] {
+        fiber::yield();
+        promises[5].set_value(5);
+        for (std::size_t i = 0; i < promises.size(); ++i) {
+            if (i != 5) {
+                promises[i].set_value(static_cast<int>(i));
+            }
+        }
+    });
+    sched->wait();
+
+    ASSERT_EQ(result.index, 5);
+    ASSERT_EQ(result.futures.size(), 8);
+    EXPECT_EQ(result.futures[5].get(), 5);
+}
+
+TEST(CortexFutureTest, WhenAnyCompletedWhileObserving) {
+    static constexpr int kRounds = 2000;
+    static constexpr std::size_t kInputs = 64;
+
+    for (int round = 0; round < kRounds; ++round) {
+        std::vector<promise<int>> promises(kInputs);
+        std::vector<future<int>> futures;
+        for (auto& p : promises) {
+            futures.push_back(p.get_future());
+        }
+        // The first input completes the combinator, and moves the inputs out, while the rest are being observed.
+        std::atomic<bool> go {false};
+        std::thread setter([&] {
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+            promises[0].set_value(round);
+        });
+
+        go = true;
+        auto any = when_any(std::move(futures));
+        setter.join();
+
+        ASSERT_TRUE(any.is_ready());
+        auto result = any.get();
+        ASSERT_EQ(result.index, 0);
+        ASSERT_EQ(result.futures.size(), kInputs);
+        EXPECT_EQ(result.futures[0].get(), round);
+    }
+}
+
+TEST(CortexFutureTest, CombinatorsOverReadyAndEmptyInputs) {
+    promise<int> p;
+    std::vector<future<int>> ready;
+    ready.push_back(p.get_future());
+    p.set_value(3);
+
+    auto any = when_any(std::move(ready));
+    ASSERT_TRUE(any.is_ready());
+    EXPECT_EQ(any.get().index, 0);
+
+    auto no_any = when_any(std::vector<future<int>> {});
+    ASSERT_TRUE(no_any.is_ready());
+    EXPECT_EQ(no_any.get().index, when_any_result<int>::npos);
+
+    auto no_all = when_all(std::vector<future<int>> {});
+    ASSERT_TRUE(no_all.is_ready());
+    EXPECT_TRUE(no_all.get().empty());
+
+    std::vector<future<int>> invalid(1);
+    EXPECT_THROW(static_cast<void>(when_all(std::move(invalid))), no_future_state);
+}
+
+TEST(CortexFutureTest, CombinatorOutlivesDroppedResult) {
+    promise<int> first;
+    promise<int> second;
+    std::vector<future<int>> futures;
+    futures.push_back(first.get_future());
+    futures.push_back(second.get_future());
+
+    // The combinator is kept alive by the observer registered on the pending input.
+    static_cast<void>(when_any(std::move(futures)));
+    first.set_value(1);
+    second.set_value(2);
+}
+
+TEST(CortexFutureTest, GetIsCancellationPoint) {
+    auto sched = work_stealing_scheduler::create(1);
+    promise<int> p;
+    auto f = p.get_future();
+    std::atomic<fiber*> waiter {nullptr};
+    bool returned = false;
+
+    sched->spawn([&] {
+        waiter = fiber::current();
+        static_cast<void>(f.get());
+        returned = true;
+    });
+    sched->spawn([&] {
+        while (waiter.load() == nullptr) {
+            fiber::yield();
+        }
+        waiter.load()->cancel();
+        p.set_value(1);
+    });
+    sched->wait();
+
+    EXPECT_FALSE(returned);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,87 @@
+#include <cortex/basic_flow.hpp>
+#include <cortex/execution.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/hook_list.hpp>
+#include <cortex/stack_allocator.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace cortex;
+
+namespace {
+
+/// Owns an execution, which is neither copyable nor movable.
+struct holder {
+    explicit holder(int id, std::vector<int>& trace)
+        : exec(execution::create(stack_allocator::create(256 * 1024),
+                                 basic_flow::make([id, &trace](api::suspendable&) { trace.push_back(id); }))) {}
+
+    execution exec;
+};
+
+} // namespace
+
+TEST(CortexHookListTest, HookHasACacheLineInTheFrame) {
+    std::vector<int> trace;
+    holder h(0, trace);
+    execution_hook& hook = h.exec.hook();
+
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&hook) % cache_line_size, 0);
+    EXPECT_NE(hook.owner, nullptr);
+    // In the frame at the top of the stack, not next to the handle.
+    EXPECT_NE(static_cast<void*>(&hook), static_cast<void*>(&h));
+}
+
+TEST(CortexHookListTest, LinksAndUnlinksExecutions) {
+    std::vector<int> trace;
+    std::vector<std::unique_ptr<holder>> holders;
+    hook_list list;
+    for (int i = 0; i < 5; ++i) {
+        holders.push_back(std::make_unique<holder>(i, trace));
+        list.push_back(holders.back()->exec.hook());
+    }
+    EXPECT_EQ(list.size(), 5);
+    EXPECT_EQ(list.front(), &holders[0]->exec.hook());
+
+    list.remove(holders[2]->exec.hook());
+    list.remove(holders[4]->exec.hook());
+    list.push_front(holders[4]->exec.hook());
+    EXPECT_EQ(list.size(), 4);
+
+    // A run loop over the list, finding the execution of each hook.
+    while (execution_hook* hook = list.pop_front()) {
+        EXPECT_EQ(hook->next, nullptr);
+        EXPECT_EQ(hook->prev, nullptr);
+        for (auto& h : holders) {
+            if (&h->exec.hook() == hook) {
+                h->exec.resume();
+            }
+        }
+    }
+
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.pop_front(), nullptr);
+    EXPECT_EQ(trace, (std::vector<int> {4, 0, 1, 3}));
+}
+
+TEST(CortexHookListTest, FiberHookIsOwnedByTheFiber) {
+    auto sched = work_stealing_scheduler::create(1);
+    bool owned = false;
+
+    sched->spawn([&] {
+        fiber* self = fiber::current();
+        owned = self->hook().owner == static_cast<api::flow*>(self);
+    });
+    sched->wait();
+
+    EXPECT_TRUE(owned);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
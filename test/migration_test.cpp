@@ -0,0 +1,182 @@
+#include <cortex/coroutine.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/fiber_local.hpp>
+#include <cortex/migration.hpp>
+#include <cortex/stack_allocator.hpp>
+#include <cortex/this_coroutine.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace cortex;
+
+namespace {
+
+constexpr std::size_t kThreads = 16;
+
+fiber_local<std::size_t> local_id;
+
+/// Coroutines waiting for a thread to resume them, in no particular affinity.
+class coroutine_pool {
+public:
+    void push(coroutine* co) {
+        const std::lock_guard lock(_mutex);
+        _queue.push_back(co);
+    }
+
+    coroutine* pop() {
+        const std::lock_guard lock(_mutex);
+        if (_queue.empty()) {
+            return nullptr;
+        }
+        coroutine* co = _queue.front();
+        _queue.pop_front();
+        return co;
+    }
+
+private:
+    std::mutex _mutex;
+    std::deque<coroutine*> _queue;
+};
+
+/// Gives a coroutine a stable address.
+struct coroutine_holder {
+    explicit coroutine_holder(coroutine::routine_i* routine)
+        : co(coroutine::create(stack_allocator::create(128 * 1024), routine)) {}
+
+    coroutine co;
+};
+
+std::atomic<int> violations {0};
+
+void count_violation(const char* /*message*/) {
+    ++violations;
+}
+
+} // namespace
+
+TEST(CortexMigrationTest, CoroutinesMigrateAcrossThreads) {
+    static constexpr std::size_t kCoroutines = 1000;
+    static constexpr std::size_t kSteps = 1000;
+    coroutine_pool pool;
+    std::atomic<std::size_t> errors {0};
+    std::atomic<std::size_t> migrations {0};
+    std::atomic<std::size_t> remaining {kCoroutines};
+
+    std::vector<std::unique_ptr<coroutine::basic_routine>> routines;
+    std::vector<std::unique_ptr<coroutine_holder>> coroutines;
+    for (std::size_t i = 0; i < kCoroutines; ++i) {
+        routines.push_back(coroutine::make_routine([&, i] {
+            *local_id = i;
+            api::suspendable* self = this_coroutine::get();
+            std::thread::id last = migration::this_thread_id();
+            for (std::size_t step = 0; step < kSteps; ++step) {
+                this_coroutine::suspend();
+                // Everything reached through thread-locals must follow the coroutine to its new thread.
+                if (*local_id != i || this_coroutine::get() != self) {
+                    ++errors;
+                }
+                if (const std::thread::id now = migration::this_thread_id(); now != last) {
+                    ++migrations;
+                    last = now;
+                }
+            }
+        }));
+        coroutines.push_back(std::make_unique<coroutine_holder>(routines.back().get()));
+        pool.push(&coroutines.back()->co);
+    }
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&] {
+            while (remaining.load() != 0) {
+                coroutine* co = pool.pop();
+                if (co == nullptr) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                co->resume();
+                if (co->is_completed()) {
+                    --remaining;
+                } else {
+                    pool.push(co);
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(errors.load(), 0);
+    EXPECT_GT(migrations.load(), 0);
+}
+
+TEST(CortexMigrationTest, FibersMigrateAcrossWorkers) {
+    static constexpr std::size_t kFibers = 10000;
+    static constexpr std::size_t kYields = 100;
+    auto sched = work_stealing_scheduler::create(kThreads);
+    std::atomic<std::size_t> errors {0};
+
+    for (std::size_t i = 0; i < kFibers; ++i) {
+        sched->spawn([&, i] {
+            *local_id = i;
+            fiber* self = fiber::current();
+            for (std::size_t y = 0; y < kYields; ++y) {
+                fiber::yield();
+                if (fiber::current() != self || *local_id != i || work_stealing_scheduler::current() != sched.get()) {
+                    ++errors;
+                }
+            }
+        });
+    }
+    sched->wait();
+
+    EXPECT_EQ(errors.load(), 0);
+}
+
+TEST(CortexMigrationTest, AffinityViolationIsReported) {
+    if (!migration::checks_enabled()) {
+        GTEST_SKIP() << "The library was built without CORTEX_MIGRATION_CHECKS.";
+    }
+
+    const migration::violation_handler_t previous = migration::set_violation_handler(&count_violation);
+    violations = 0;
+
+    auto routine = coroutine::make_routine([] {
+        {
+            const migration::thread_affinity_guard pinned;
+            this_coroutine::suspend();
+            this_coroutine::suspend();
+        }
+        // Free to move again.
+        this_coroutine::suspend();
+    });
+    auto co = coroutine::create(routine.get());
+
+    co.resume();
+    // Same thread, nothing to report.
+    co.resume();
+    EXPECT_EQ(violations.load(), 0);
+
+    std::thread([&] { co.resume(); }).join();
+    EXPECT_EQ(violations.load(), 1);
+
+    std::thread([&] { co.resume(); }).join();
+    EXPECT_TRUE(co.is_completed());
+    EXPECT_EQ(violations.load(), 1);
+
+    migration::set_violation_handler(previous);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
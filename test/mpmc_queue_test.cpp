@@ -0,0 +1,95 @@
+#include <cortex/error.hpp>
+#include <cortex/mpmc_queue.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cortex;
+
+TEST(CortexMpmcQueueTest, ZeroCapacity) {
+    EXPECT_THROW(mpmc_queue<int>(0), invalid_argument_error);
+}
+
+TEST(CortexMpmcQueueTest, CapacityIsRounded) {
+    mpmc_queue<int> queue(5);
+    EXPECT_EQ(queue.capacity(), 8);
+}
+
+TEST(CortexMpmcQueueTest, PushPop) {
+    mpmc_queue<std::string> queue(2);
+    std::string a = "a";
+    std::string b = "b";
+    std::string c = "c";
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_TRUE(queue.try_push(a));
+    EXPECT_TRUE(queue.try_push(b));
+    EXPECT_FALSE(queue.try_push(c));
+    EXPECT_EQ(c, "c");
+
+    EXPECT_EQ(queue.try_pop(), "a");
+    EXPECT_TRUE(queue.try_push(c));
+    EXPECT_EQ(queue.try_pop(), "b");
+    EXPECT_EQ(queue.try_pop(), "c");
+    EXPECT_FALSE(queue.try_pop().has_value());
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(CortexMpmcQueueTest, CapacityOne) {
+    mpmc_queue<int> queue(1);
+    int a = 1;
+    int b = 2;
+
+    EXPECT_TRUE(queue.try_push(a));
+    EXPECT_FALSE(queue.try_push(b));
+    EXPECT_EQ(queue.try_pop(), 1);
+    EXPECT_FALSE(queue.try_pop().has_value());
+    EXPECT_TRUE(queue.try_push(b));
+    EXPECT_EQ(queue.try_pop(), 2);
+}
+
+TEST(CortexMpmcQueueTest, ProducersConsumers) {
+    static constexpr int kThreads = 4;
+    static constexpr int kItems = 100000;
+    mpmc_queue<int> queue(64);
+    std::atomic<int> consumed {0};
+    std::atomic<std::int64_t> sum {0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 1; i <= kItems; ++i) {
+                int item = i;
+                while (!queue.try_push(item)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        threads.emplace_back([&] {
+            while (consumed.load() != kThreads * kItems) {
+                if (auto item = queue.try_pop(); item.has_value()) {
+                    sum += *item;
+                    ++consumed;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(sum.load(), static_cast<std::int64_t>(kThreads) * kItems * (kItems + 1) / 2);
+    EXPECT_TRUE(queue.empty());
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,150 @@
+#include <cortex/mpsc_inbox.hpp>
+#include <cortex/parker.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+using namespace cortex;
+
+namespace {
+
+struct item {
+    item*& link() noexcept {
+        return next;
+    }
+
+    int producer = 0;
+    int value = 0;
+    item* next = nullptr;
+};
+
+} // namespace
+
+TEST(CortexMpscInboxTest, PushPop) {
+    mpsc_inbox<item> inbox;
+    item a {0, 1};
+    item b {0, 2};
+    item c {0, 3};
+
+    EXPECT_TRUE(inbox.empty());
+    EXPECT_EQ(inbox.pop(), nullptr);
+
+    EXPECT_TRUE(inbox.push(a));
+    EXPECT_FALSE(inbox.push(b));
+    EXPECT_FALSE(inbox.empty());
+
+    EXPECT_EQ(inbox.pop(), &a);
+    // Pushed while older items are detached but not popped yet.
+    EXPECT_TRUE(inbox.push(c));
+    EXPECT_EQ(inbox.pop(), &b);
+    EXPECT_EQ(inbox.pop(), &c);
+    EXPECT_EQ(inbox.pop(), nullptr);
+    EXPECT_TRUE(inbox.empty());
+}
+
+TEST(CortexMpscInboxTest, ItemCanBePushedAgain) {
+    mpsc_inbox<item> inbox;
+    item a {0, 1};
+
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(inbox.push(a));
+        EXPECT_EQ(inbox.pop(), &a);
+        EXPECT_EQ(a.next, nullptr);
+    }
+}
+
+TEST(CortexMpscInboxTest, ProducersKeepTheirOrder) {
+    static constexpr int kProducers = 4;
+    static constexpr int kItems = 50000;
+    mpsc_inbox<item> inbox;
+    std::vector<std::vector<item>> items(kProducers, std::vector<item>(kItems));
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < kItems; ++i) {
+                auto& it = items[static_cast<std::size_t>(p)][static_cast<std::size_t>(i)];
+                it.producer = p;
+                it.value = i;
+                inbox.push(it);
+            }
+        });
+    }
+
+    std::vector<int> next(kProducers, 0);
+    for (int popped = 0; popped < kProducers * kItems;) {
+        item* it = inbox.pop();
+        if (it == nullptr) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        auto& expected = next[static_cast<std::size_t>(it->producer)];
+        ASSERT_EQ(it->value, expected);
+        ++expected;
+        ++popped;
+    }
+
+    for (auto& t : producers) {
+        t.join();
+    }
+    EXPECT_TRUE(inbox.empty());
+}
+
+TEST(CortexParkerTest, UnparkWithoutSleeperIsNoop) {
+    parker p;
+    EXPECT_FALSE(p.unpark());
+
+    p.prepare();
+    EXPECT_TRUE(p.cancel());
+    EXPECT_FALSE(p.unpark());
+}
+
+TEST(CortexParkerTest, UnparkClaimsPreparedOwner) {
+    parker p;
+    p.prepare();
+
+    EXPECT_TRUE(p.unpark());
+    EXPECT_FALSE(p.unpark());
+    // Already claimed, the wait returns right away.
+    p.wait();
+    EXPECT_FALSE(p.cancel());
+}
+
+TEST(CortexParkerTest, HandshakeNeverLosesWakeup) {
+    static constexpr int kRounds = 20000;
+    parker p;
+    mpsc_inbox<item> inbox;
+    std::vector<item> items(kRounds);
+
+    std::thread consumer([&] {
+        for (int received = 0; received < kRounds;) {
+            if (inbox.pop() != nullptr) {
+                ++received;
+                continue;
+            }
+
+            p.prepare();
+            if (inbox.empty()) {
+                p.wait();
+            }
+            p.cancel();
+        }
+    });
+
+    for (auto& it : items) {
+        if (inbox.push(it)) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            p.unpark();
+        }
+    }
+    consumer.join();
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,95 @@
+#include <cortex/coroutine.hpp>
+#include <cortex/error.hpp>
+#include <cortex/preemption.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+using namespace cortex;
+
+namespace {
+
+using namespace std::chrono_literals;
+
+/// Restores the default slice at the end of a test.
+struct slice_scope {
+    explicit slice_scope(std::chrono::nanoseconds slice) {
+        preemption::set_time_slice(slice);
+    }
+
+    ~slice_scope() {
+        preemption::set_time_slice(preemption::default_time_slice);
+    }
+
+    slice_scope(const slice_scope&) = delete;
+    slice_scope& operator=(const slice_scope&) = delete;
+};
+
+/// Runs a coroutine spinning on `maybe_yield` until it suspends, returns how long the slice lasted.
+std::chrono::steady_clock::duration measure_slice() {
+    auto routine = coroutine::make_routine([] {
+        while (true) {
+            maybe_yield();
+        }
+    });
+    auto co = coroutine::create(routine.get());
+
+    const auto start = std::chrono::steady_clock::now();
+    co.resume();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_FALSE(co.is_completed());
+
+    co.cancel();
+    co.resume();
+    EXPECT_TRUE(co.is_completed());
+    return elapsed;
+}
+
+} // namespace
+
+TEST(CortexPreemptionTest, OutsideOfExecutions) {
+    EXPECT_NO_THROW(maybe_yield());
+    EXPECT_THROW(preemption::set_time_slice(0ns), invalid_argument_error);
+    EXPECT_EQ(preemption::time_slice(), preemption::default_time_slice);
+}
+
+TEST(CortexPreemptionTest, CoroutineSuspendsOnceTheSliceIsUsedUp) {
+    const slice_scope scope(5ms);
+    EXPECT_GE(measure_slice(), 5ms);
+}
+
+TEST(CortexPreemptionTest, TimerEndsTheSlice) {
+    const slice_scope scope(5ms);
+    auto timer = preemption::timer::create();
+    EXPECT_THROW(preemption::timer::create(), preemption::timer::already_running);
+
+    EXPECT_GE(measure_slice(), 5ms);
+}
+
+TEST(CortexPreemptionTest, RunawayFiberDoesNotStarveOthers) {
+    const slice_scope scope(1ms);
+    auto sched = work_stealing_scheduler::create(1);
+    std::atomic<bool> done {false};
+    std::size_t yields = 0;
+
+    sched->spawn([&] {
+        // Queued behind this fiber on the only worker, it only runs if this one gives up the processor.
+        sched->spawn([&] { done = true; });
+        while (!done.load()) {
+            maybe_yield();
+            ++yields;
+        }
+    });
+    sched->wait();
+
+    EXPECT_TRUE(done.load());
+    EXPECT_GT(yields, 0);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
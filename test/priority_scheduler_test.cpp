@@ -0,0 +1,124 @@
+#include <cortex/error.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/priority_scheduler.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+using namespace cortex;
+
+namespace {
+
+struct MyException : std::exception {};
+
+using clock_type = priority_scheduler::clock;
+
+} // namespace
+
+TEST(CortexPrioritySchedulerTest, InvalidArguments) {
+    EXPECT_THROW(priority_scheduler::create(0), invalid_argument_error);
+    EXPECT_THROW(priority_scheduler::create(1, {.starvation_limit = clock_type::duration::zero()}),
+                 invalid_argument_error);
+    EXPECT_THROW(priority_scheduler::set_priority(priority_class::background), fiber::not_in_fiber);
+}
+
+TEST(CortexPrioritySchedulerTest, ClassesRunInPriorityOrder) {
+    auto sched = priority_scheduler::create(1);
+    std::vector<int> trace;
+
+    // Spawned from a fiber, so every one of them is queued before any of them runs.
+    sched->spawn([&] {
+        EXPECT_EQ(priority_scheduler::current(), sched.get());
+        sched->spawn(priority_class::background, [&] { trace.push_back(3); });
+        sched->spawn(priority_class::normal, [&] { trace.push_back(2); });
+        sched->spawn(priority_class::interactive, [&] { trace.push_back(1); });
+        sched->spawn(priority_class::background, [&] { trace.push_back(4); });
+    });
+    sched->wait();
+
+    EXPECT_EQ(trace, (std::vector<int> {1, 2, 3, 4}));
+}
+
+TEST(CortexPrioritySchedulerTest, EarliestDeadlineFirst) {
+    auto sched = priority_scheduler::create(1);
+    std::vector<int> trace;
+
+    sched->spawn([&] {
+        const auto now = clock_type::now();
+        sched->spawn(priority_class::normal, [&] { trace.push_back(4); });
+        sched->spawn(priority_class::normal, [&] { trace.push_back(3); }, now + std::chrono::seconds(3));
+        sched->spawn(priority_class::normal, [&] { trace.push_back(1); }, now + std::chrono::seconds(1));
+        sched->spawn(priority_class::normal, [&] { trace.push_back(2); }, now + std::chrono::seconds(2));
+    });
+    sched->wait();
+
+    EXPECT_EQ(trace, (std::vector<int> {1, 2, 3, 4}));
+}
+
+TEST(CortexPrioritySchedulerTest, AttributesApplyFromTheNextScheduling) {
+    auto sched = priority_scheduler::create(1);
+    std::vector<int> trace;
+
+    sched->spawn(priority_class::interactive, [&] {
+        sched->spawn(priority_class::normal, [&] { trace.push_back(2); });
+        trace.push_back(1);
+        // Demoted below the other fiber, which runs first once this one yields.
+        priority_scheduler::set_priority(priority_class::background);
+        fiber::yield();
+        trace.push_back(3);
+    });
+    sched->wait();
+
+    EXPECT_EQ(trace, (std::vector<int> {1, 2, 3}));
+}
+
+TEST(CortexPrioritySchedulerTest, StarvationIsBounded) {
+    auto sched = priority_scheduler::create(1, {.starvation_limit = std::chrono::milliseconds(1)});
+    std::atomic<bool> done {false};
+
+    sched->spawn(priority_class::interactive, [&] {
+        // Interactive fibers that never stop yielding to each other, only the background fiber ends them.
+        for (int i = 0; i < 2; ++i) {
+            sched->spawn(priority_class::interactive, [&] {
+                while (!done.load()) {
+                    fiber::yield();
+                }
+            });
+        }
+        sched->spawn(priority_class::background, [&] { done = true; });
+    });
+    sched->wait();
+
+    EXPECT_TRUE(done.load());
+    EXPECT_GE(sched->promotions(), 1);
+}
+
+TEST(CortexPrioritySchedulerTest, WaitRethrows) {
+    auto sched = priority_scheduler::create(2);
+    sched->spawn(priority_class::background, [] { throw MyException(); });
+
+    EXPECT_THROW(sched->wait(), MyException);
+    EXPECT_NO_THROW(sched->wait());
+}
+
+TEST(CortexPrioritySchedulerTest, ManyFibers) {
+    auto sched = priority_scheduler::create(4);
+    std::atomic<int> counter {0};
+
+    for (int i = 0; i < 3000; ++i) {
+        sched->spawn(static_cast<priority_class>(i % 3), [&] {
+            fiber::yield();
+            ++counter;
+        });
+    }
+    sched->wait();
+
+    EXPECT_EQ(counter.load(), 3000);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,220 @@
+#include <cortex/error.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/reactor.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace cortex;
+
+namespace {
+
+std::array<int, 2> make_pipe() {
+    std::array<int, 2> fds {};
+    EXPECT_EQ(::pipe(fds.data()), 0);
+    return fds;
+}
+
+/// Listening socket on an ephemeral loopback port.
+int make_listener(sockaddr_in& address) {
+    const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    EXPECT_GE(fd, 0);
+
+    address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    EXPECT_EQ(::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    EXPECT_EQ(::listen(fd, 128), 0);
+
+    socklen_t length = sizeof(address);
+    EXPECT_EQ(::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length), 0);
+    return fd;
+}
+
+} // namespace
+
+TEST(CortexReactorTest, ZeroMaxEvents) {
+    EXPECT_THROW(reactor::create(0), invalid_argument_error);
+}
+
+TEST(CortexReactorTest, AttachInvalidDescriptor) {
+    auto r = reactor::create();
+    EXPECT_THROW(r->attach(-1), system_error);
+}
+
+TEST(CortexReactorTest, ReadParksUntilWrite) {
+    auto r = reactor::create();
+    auto sched = work_stealing_scheduler::create(2);
+    auto [read_fd, write_fd] = make_pipe();
+    auto reader = r->attach(read_fd);
+    auto writer = r->attach(write_fd);
+    std::atomic<bool> received {false};
+    std::string message;
+
+    sched->spawn([&] {
+        std::array<char, 16> buffer {};
+        const std::size_t size = reader->async_read(buffer.data(), buffer.size());
+        message.assign(buffer.data(), size);
+        received = true;
+    });
+    sched->spawn([&] {
+        // Let the reader park first.
+        for (int i = 0; i < 100; ++i) {
+            fiber::yield();
+        }
+        EXPECT_FALSE(received.load());
+        writer->async_write("hello", 5);
+    });
+    sched->wait();
+
+    EXPECT_EQ(message, "hello");
+}
+
+TEST(CortexReactorTest, EndOfStream) {
+    auto r = reactor::create();
+    auto sched = work_stealing_scheduler::create(1);
+    auto [read_fd, write_fd] = make_pipe();
+    auto reader = r->attach(read_fd);
+    auto writer = r->attach(write_fd);
+    std::size_t size = 1;
+
+    sched->spawn([&] {
+        std::array<char, 16> buffer {};
+        size = reader->async_read(buffer.data(), buffer.size());
+    });
+    sched->spawn([&] { writer.reset(); });
+    sched->wait();
+
+    EXPECT_EQ(size, 0);
+}
+
+TEST(CortexReactorTest, WaitOutsideOfFiber) {
+    auto r = reactor::create();
+    auto [read_fd, write_fd] = make_pipe();
+    auto reader = r->attach(read_fd);
+    auto writer = r->attach(write_fd);
+    std::array<char, 16> buffer {};
+
+    EXPECT_THROW(reader->async_read(buffer.data(), buffer.size()), fiber::not_in_fiber);
+
+    // Nothing to wait for.
+    writer->async_write("x", 1);
+    EXPECT_EQ(reader->async_read(buffer.data(), buffer.size()), 1);
+}
+
+TEST(CortexReactorTest, LargeWriteWaitsForReader) {
+    static constexpr std::size_t kSize = 4 * 1024 * 1024;
+    auto r = reactor::create();
+    auto sched = work_stealing_scheduler::create(2);
+    auto [read_fd, write_fd] = make_pipe();
+    auto reader = r->attach(read_fd);
+    auto writer = r->attach(write_fd);
+    std::size_t total = 0;
+
+    sched->spawn([&] {
+        // Far more than the pipe buffer, the writer parks until the reader makes room.
+        std::vector<char> data(kSize, 'x');
+        writer->async_write(data.data(), data.size());
+        writer.reset();
+    });
+    sched->spawn([&] {
+        std::array<char, 4096> buffer {};
+        while (const std::size_t size = reader->async_read(buffer.data(), buffer.size())) {
+            total += size;
+        }
+    });
+    sched->wait();
+
+    EXPECT_EQ(total, kSize);
+}
+
+TEST(CortexReactorTest, EchoOverLoopback) {
+    static constexpr int kClients = 8;
+    static constexpr int kMessages = 100;
+    auto r = reactor::create();
+    auto sched = work_stealing_scheduler::create(2);
+
+    sockaddr_in address {};
+    auto listener = r->attach(make_listener(address));
+    std::atomic<int> echoed {0};
+
+    sched->spawn([&] {
+        for (int i = 0; i < kClients; ++i) {
+            std::shared_ptr<reactor::descriptor> connection = listener->async_accept();
+            work_stealing_scheduler::current()->spawn([connection] {
+                std::array<char, 256> buffer {};
+                while (const std::size_t size = connection->async_read(buffer.data(), buffer.size())) {
+                    connection->async_write(buffer.data(), size);
+                }
+            });
+        }
+    });
+
+    for (int i = 0; i < kClients; ++i) {
+        sched->spawn([&, i] {
+            auto client = r->attach(::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0));
+            client->async_connect(reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+
+            for (int m = 0; m < kMessages; ++m) {
+                const std::string message = std::to_string(i) + ":" + std::to_string(m);
+                client->async_write(message.data(), message.size());
+
+                std::string reply(message.size(), '\0');
+                std::size_t received = 0;
+                while (received != reply.size()) {
+                    const std::size_t size = client->async_read(reply.data() + received, reply.size() - received);
+                    ASSERT_NE(size, 0);
+                    received += size;
+                }
+                EXPECT_EQ(reply, message);
+                ++echoed;
+            }
+        });
+    }
+    sched->wait();
+
+    EXPECT_EQ(echoed.load(), kClients * kMessages);
+}
+
+TEST(CortexReactorTest, ConnectionRefused) {
+    auto r = reactor::create();
+    auto sched = work_stealing_scheduler::create(1);
+
+    // Bound but not listening.
+    sockaddr_in address {};
+    const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ASSERT_EQ(::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    socklen_t length = sizeof(address);
+    ASSERT_EQ(::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length), 0);
+
+    bool refused = false;
+    sched->spawn([&] {
+        auto client = r->attach(::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0));
+        try {
+            client->async_connect(reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+        } catch (const system_error& e) {
+            refused = e.code() == ECONNREFUSED;
+        }
+    });
+    sched->wait();
+    ::close(fd);
+
+    EXPECT_TRUE(refused);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,98 @@
+#include <cortex/error.hpp>
+#include <cortex/segmented_queue.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cortex;
+
+TEST(CortexSegmentedQueueTest, ZeroSegmentSize) {
+    EXPECT_THROW(segmented_queue<int>(0), invalid_argument_error);
+}
+
+TEST(CortexSegmentedQueueTest, Unbounded) {
+    segmented_queue<int> queue;
+    EXPECT_EQ(queue.capacity(), std::numeric_limits<std::size_t>::max());
+    EXPECT_EQ(queue.segment_size(), segmented_queue<int>::default_segment_size);
+}
+
+TEST(CortexSegmentedQueueTest, PushPopAcrossSegments) {
+    segmented_queue<std::string> queue(2);
+    EXPECT_TRUE(queue.empty());
+
+    for (int i = 0; i < 7; ++i) {
+        std::string item = std::to_string(i);
+        EXPECT_TRUE(queue.try_push(item));
+    }
+    EXPECT_FALSE(queue.empty());
+
+    for (int i = 0; i < 7; ++i) {
+        EXPECT_EQ(queue.try_pop(), std::to_string(i));
+    }
+    EXPECT_FALSE(queue.try_pop().has_value());
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(CortexSegmentedQueueTest, InterleavedKeepsOrder) {
+    segmented_queue<int> queue(3);
+    int next_push = 0;
+    int next_pop = 0;
+
+    // Pushes two for every pop, so that segments are linked and drained while others are still filling up.
+    for (int round = 0; round < 100; ++round) {
+        for (int i = 0; i < 2; ++i) {
+            int item = next_push++;
+            EXPECT_TRUE(queue.try_push(item));
+        }
+        EXPECT_EQ(queue.try_pop(), next_pop++);
+    }
+    while (auto item = queue.try_pop()) {
+        EXPECT_EQ(*item, next_pop++);
+    }
+    EXPECT_EQ(next_pop, next_push);
+}
+
+TEST(CortexSegmentedQueueTest, ProducersConsumers) {
+    static constexpr int kThreads = 4;
+    static constexpr int kItems = 100000;
+    segmented_queue<int> queue(16);
+    std::atomic<int> consumed {0};
+    std::atomic<std::int64_t> sum {0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 1; i <= kItems; ++i) {
+                int item = i;
+                EXPECT_TRUE(queue.try_push(item));
+            }
+        });
+        threads.emplace_back([&] {
+            while (consumed.load() != kThreads * kItems) {
+                if (auto item = queue.try_pop(); item.has_value()) {
+                    sum += *item;
+                    ++consumed;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(sum.load(), static_cast<std::int64_t>(kThreads) * kItems * (kItems + 1) / 2);
+    EXPECT_TRUE(queue.empty());
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
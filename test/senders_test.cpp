@@ -0,0 +1,114 @@
+#include <cortex/fiber.hpp>
+#include <cortex/fiber_mutex.hpp>
+#include <cortex/senders.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <variant>
+
+using namespace cortex;
+using namespace cortex::senders;
+
+namespace {
+
+struct MyException : std::exception {};
+
+} // namespace
+
+TEST(CortexSendersTest, JustOnCallingThread) {
+    EXPECT_EQ(sync_wait(just(20) | then([](int v) { return v + 1; })), 21);
+    EXPECT_EQ(sync_wait(then(just(), [] { return std::string("x"); })), "x");
+    EXPECT_EQ(sync_wait(just()), std::monostate {});
+}
+
+TEST(CortexSendersTest, ScheduleCompletesOnFiber) {
+    auto sched = work_stealing_scheduler::create(2);
+    const fiber_scheduler fs(*sched);
+    EXPECT_EQ(fs, fiber_scheduler(*sched));
+
+    auto result = sync_wait(fs.schedule() | then([] { return fiber::current() != nullptr; }) |
+                            then([](bool on_fiber) { return on_fiber ? 1 : 0; }));
+    sched->wait();
+
+    EXPECT_EQ(result, 1);
+}
+
+TEST(CortexSendersTest, WorkMayParkOnFiber) {
+    auto sched = work_stealing_scheduler::create(2);
+    const fiber_scheduler fs(*sched);
+    fiber_mutex mutex;
+    int counter = 0;
+
+    for (int i = 0; i < 4; ++i) {
+        sync_wait(fs.schedule() | then([&] {
+                      const std::lock_guard lock(mutex);
+                      fiber::yield();
+                      ++counter;
+                  }));
+    }
+    sched->wait();
+
+    EXPECT_EQ(counter, 4);
+}
+
+TEST(CortexSendersTest, ErrorIsRethrown) {
+    auto sched = work_stealing_scheduler::create(1);
+    const fiber_scheduler fs(*sched);
+    bool skipped = true;
+
+    auto failing = fs.schedule() | then([]() -> int { throw MyException(); }) | then([&](int) {
+                       skipped = false;
+                       return 0;
+                   });
+    EXPECT_THROW(sync_wait(std::move(failing)), MyException);
+    sched->wait();
+
+    EXPECT_TRUE(skipped);
+}
+
+TEST(CortexSendersTest, SyncWaitInFiberParksFiber) {
+    static constexpr int kWaiters = 100;
+    auto sched = work_stealing_scheduler::create(1);
+    const fiber_scheduler fs(*sched);
+    std::atomic<int> sum {0};
+
+    // With a single worker, each waiter has to park for the scheduled work to run at all.
+    for (int i = 0; i < kWaiters; ++i) {
+        sched->spawn([&, i] {
+            auto value = sync_wait(fs.schedule() | then([i] { return i; }));
+            sum += value.value_or(0);
+        });
+    }
+    sched->wait();
+
+    EXPECT_EQ(sum.load(), kWaiters * (kWaiters - 1) / 2);
+}
+
+TEST(CortexSendersTest, CancelledWorkCompletesStopped) {
+    auto sched = work_stealing_scheduler::create(1);
+    const fiber_scheduler fs(*sched);
+    std::optional<std::optional<int>> result;
+
+    sched->spawn([&] {
+        result = sync_wait(fs.schedule() | then([] {
+                               fiber::current()->cancel();
+                               fiber::yield();
+                               return 1;
+                           }));
+    });
+    sched->wait();
+
+    ASSERT_TRUE(result.has_value());
+    EXPECT_FALSE(result->has_value());
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,136 @@
+#include <cortex/error.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/sharded_runtime.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace cortex;
+
+namespace {
+
+struct MyException : std::exception {};
+
+sharded_runtime::options test_options() {
+    sharded_runtime::options opts;
+    opts.queue_capacity = 8;
+    opts.pin_threads = false;
+    return opts;
+}
+
+} // namespace
+
+TEST(CortexShardedRuntimeTest, InvalidArguments) {
+    EXPECT_THROW(sharded_runtime::create(0), invalid_argument_error);
+
+    sharded_runtime::options opts;
+    opts.queue_capacity = 0;
+    EXPECT_THROW(sharded_runtime::create(2, opts), invalid_argument_error);
+
+    auto rt = sharded_runtime::create(2, test_options());
+    EXPECT_THROW(rt->submit(2, [] {}), invalid_argument_error);
+    EXPECT_THROW(rt->submit(0, nullptr), invalid_argument_error);
+}
+
+TEST(CortexShardedRuntimeTest, TasksRunOnTheirShard) {
+    auto rt = sharded_runtime::create(3, test_options());
+    std::atomic<int> counter {0};
+
+    for (std::size_t i = 0; i < 30; ++i) {
+        rt->submit(i % 3, [&, target = i % 3] {
+            EXPECT_EQ(sharded_runtime::current(), rt.get());
+            EXPECT_EQ(sharded_runtime::current_shard(), target);
+            ++counter;
+        });
+    }
+    rt->wait();
+
+    EXPECT_EQ(counter.load(), 30);
+    EXPECT_THROW((void)sharded_runtime::current_shard(), sharded_runtime::not_on_shard);
+}
+
+TEST(CortexShardedRuntimeTest, PingPong) {
+    auto rt = sharded_runtime::create(2, test_options());
+    std::vector<std::size_t> trace;
+    std::atomic<int> remaining {100};
+
+    // Only one message is in flight at a time, so `trace` is never accessed concurrently.
+    std::function<void()> hop = [&] {
+        trace.push_back(sharded_runtime::current_shard());
+        if (--remaining > 0) {
+            sharded_runtime::current()->submit(1 - sharded_runtime::current_shard(), hop);
+        }
+    };
+
+    rt->submit(0, hop);
+    rt->wait();
+
+    ASSERT_EQ(trace.size(), 100);
+    for (std::size_t i = 0; i < trace.size(); ++i) {
+        EXPECT_EQ(trace[i], i % 2);
+    }
+}
+
+TEST(CortexShardedRuntimeTest, BurstLargerThanQueue) {
+    auto rt = sharded_runtime::create(2, test_options());
+    std::atomic<int> counter {0};
+
+    rt->submit(0, [&] {
+        for (int i = 0; i < 1000; ++i) {
+            sharded_runtime::current()->submit(1, [&] { ++counter; });
+        }
+    });
+    rt->wait();
+
+    EXPECT_EQ(counter.load(), 1000);
+}
+
+TEST(CortexShardedRuntimeTest, YieldStaysOnShard) {
+    auto rt = sharded_runtime::create(2, test_options());
+    std::atomic<int> steps {0};
+
+    for (std::size_t i = 0; i < 10; ++i) {
+        rt->submit(i % 2, [&, target = i % 2] {
+            for (int j = 0; j < 10; ++j) {
+                fiber::yield();
+                EXPECT_EQ(sharded_runtime::current_shard(), target);
+                ++steps;
+            }
+        });
+    }
+    rt->wait();
+
+    EXPECT_EQ(steps.load(), 100);
+}
+
+TEST(CortexShardedRuntimeTest, Exception) {
+    auto rt = sharded_runtime::create(2, test_options());
+
+    rt->submit(1, [] { throw MyException {}; });
+    EXPECT_THROW(rt->wait(), MyException);
+    EXPECT_NO_THROW(rt->wait());
+}
+
+TEST(CortexShardedRuntimeTest, WaitFromShard) {
+    auto rt = sharded_runtime::create(1, test_options());
+    bool thrown = false;
+
+    rt->submit(0, [&] {
+        try {
+            rt->wait();
+        } catch (const sharded_runtime::wait_from_shard&) {
+            thrown = true;
+        }
+    });
+    rt->wait();
+
+    EXPECT_TRUE(thrown);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,186 @@
+#include <cortex/basic_flow.hpp>
+#include <cortex/error.hpp>
+#include <cortex/execution.hpp>
+#include <cortex/fiber_local.hpp>
+#include <cortex/shared_stack.hpp>
+#include <cortex/stack_allocator.hpp>
+#include <cortex/this_coroutine.hpp>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+using namespace cortex;
+
+namespace {
+
+struct MyException : std::exception {};
+
+/// Owns an execution, which is neither copyable nor movable.
+struct holder {
+    holder(shared_stack& st, std::function<void(api::suspendable&)> body)
+        : exec(shared_execution::create(st, basic_flow::make(std::move(body)))) {}
+
+    shared_execution exec;
+};
+
+/// Fills a frame of `Size` bytes with a pattern, suspends, and returns the number of values that did not survive.
+template <std::size_t Size>
+int fill_and_suspend(api::suspendable& suspender, int seed, int rounds) {
+    // Volatile, so that the values really sit on the stack across the suspensions.
+    volatile int values[Size / sizeof(int)];
+    for (std::size_t i = 0; i < std::size(values); ++i) {
+        values[i] = seed + static_cast<int>(i);
+    }
+    for (int i = 0; i < rounds; ++i) {
+        suspender.suspend();
+    }
+    int mismatches = 0;
+    for (std::size_t i = 0; i < std::size(values); ++i) {
+        mismatches += values[i] == seed + static_cast<int>(i) ? 0 : 1;
+    }
+    return mismatches;
+}
+
+} // namespace
+
+TEST(CortexSharedStackTest, InvalidArguments) {
+    EXPECT_THROW(shared_stack::create(stack_allocator::create(1024)), execution::invalid_stack_size);
+
+    auto st = shared_stack::create(stack_allocator::create(256 * 1024));
+    EXPECT_THROW(shared_execution::create(*st, nullptr), execution::invalid_flow);
+    EXPECT_THROW(shared_execution::create_with_raw_flow(*st, nullptr), execution::invalid_flow);
+}
+
+TEST(CortexSharedStackTest, InterleavedExecutionsKeepTheirFrames) {
+    auto st = shared_stack::create(stack_allocator::create(256 * 1024));
+    std::vector<int> results(8, -1);
+    std::vector<std::unique_ptr<holder>> execs;
+    for (int i = 0; i < 8; ++i) {
+        execs.push_back(std::make_unique<holder>(*st, [&results, i](api::suspendable& suspender) {
+            results[static_cast<std::size_t>(i)] = fill_and_suspend<4096>(suspender, i * 1000, 10);
+        }));
+    }
+
+    for (int round = 0; round <= 10; ++round) {
+        for (auto& h : execs) {
+            ASSERT_FALSE(h->exec.is_completed());
+            h->exec.resume();
+        }
+    }
+
+    for (std::size_t i = 0; i < execs.size(); ++i) {
+        EXPECT_TRUE(execs[i]->exec.is_completed());
+        EXPECT_EQ(results[i], 0);
+    }
+}
+
+TEST(CortexSharedStackTest, SavesOnlyTheUsedStack) {
+    auto st = shared_stack::create(stack_allocator::create(1024 * 1024));
+    holder small(*st, [](api::suspendable& suspender) { fill_and_suspend<256>(suspender, 0, 1); });
+    holder large(*st, [](api::suspendable& suspender) { fill_and_suspend<64 * 1024>(suspender, 0, 1); });
+
+    EXPECT_EQ(small.exec.saved_size(), 0);
+    small.exec.resume();
+    // Still on the stack, nothing is saved until another execution needs it.
+    EXPECT_EQ(small.exec.saved_size(), 0);
+    large.exec.resume();
+    EXPECT_GT(small.exec.saved_size(), 256);
+    EXPECT_LT(small.exec.saved_size(), 8 * 1024);
+
+    small.exec.resume();
+    EXPECT_EQ(small.exec.saved_size(), 0);
+    EXPECT_GT(large.exec.saved_size(), 64 * 1024);
+    EXPECT_LT(large.exec.saved_size(), 80 * 1024);
+}
+
+TEST(CortexSharedStackTest, ResumeRethrows) {
+    auto st = shared_stack::create(stack_allocator::create(256 * 1024));
+    holder other(*st, [](api::suspendable& suspender) { fill_and_suspend<1024>(suspender, 0, 1); });
+    holder failing(*st, [](api::suspendable& suspender) {
+        suspender.suspend();
+        throw MyException();
+    });
+
+    failing.exec.resume();
+    other.exec.resume();
+    EXPECT_THROW(failing.exec.resume(), MyException);
+    EXPECT_TRUE(failing.exec.is_completed());
+    EXPECT_EQ(failing.exec.saved_size(), 0);
+}
+
+TEST(CortexSharedStackTest, DestroyUnwindsSavedExecution) {
+    auto st = shared_stack::create(stack_allocator::create(256 * 1024));
+    int destroyed = 0;
+    struct guard {
+        int& counter;
+        ~guard() {
+            ++counter;
+        }
+    };
+
+    auto first = std::make_unique<holder>(*st, [&](api::suspendable& suspender) {
+        guard g {destroyed};
+        suspender.suspend();
+        FAIL() << "Not resumed again.";
+    });
+    holder second(*st, [&](api::suspendable& suspender) {
+        guard g {destroyed};
+        suspender.suspend();
+    });
+
+    first->exec.resume();
+    second.exec.resume();
+    EXPECT_GT(first->exec.saved_size(), 0);
+
+    // Copied back over the frames of the second one, which is saved first.
+    first.reset();
+    EXPECT_EQ(destroyed, 1);
+    EXPECT_GT(second.exec.saved_size(), 0);
+    second.exec.resume();
+    EXPECT_TRUE(second.exec.is_completed());
+    EXPECT_EQ(destroyed, 2);
+}
+
+TEST(CortexSharedStackTest, NestedResumeOnSameStackThrows) {
+    auto st = shared_stack::create(stack_allocator::create(256 * 1024));
+    holder inner(*st, [](api::suspendable&) {});
+    holder outer(*st, [&](api::suspendable&) {
+        EXPECT_THROW(inner.exec.resume(), shared_execution::resume_on_shared_stack);
+    });
+
+    outer.exec.resume();
+    EXPECT_TRUE(outer.exec.is_completed());
+    inner.exec.resume();
+    EXPECT_TRUE(inner.exec.is_completed());
+}
+
+TEST(CortexSharedStackTest, CurrentExecutionAndLocals) {
+    auto st = shared_stack::create(stack_allocator::create(256 * 1024));
+    fiber_local<int> value;
+    std::vector<int> seen;
+    std::vector<std::unique_ptr<holder>> execs;
+    for (int i = 0; i < 3; ++i) {
+        execs.push_back(std::make_unique<holder>(*st, [&, i](api::suspendable&) {
+            *value = i;
+            this_coroutine::suspend();
+            seen.push_back(*value);
+        }));
+    }
+
+    for (int round = 0; round < 2; ++round) {
+        for (auto& h : execs) {
+            h->exec.resume();
+        }
+    }
+    EXPECT_EQ(seen, (std::vector<int> {0, 1, 2}));
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
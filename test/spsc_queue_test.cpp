@@ -0,0 +1,80 @@
+#include <cortex/error.hpp>
+#include <cortex/spsc_queue.hpp>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cortex;
+
+TEST(CortexSpscQueueTest, ZeroCapacity) {
+    EXPECT_THROW(spsc_queue<int>(0), invalid_argument_error);
+}
+
+TEST(CortexSpscQueueTest, CapacityIsRounded) {
+    spsc_queue<int> queue(5);
+    EXPECT_EQ(queue.capacity(), 8);
+}
+
+TEST(CortexSpscQueueTest, PushPop) {
+    spsc_queue<std::string> queue(2);
+    std::string a = "a";
+    std::string b = "b";
+    std::string c = "c";
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_TRUE(queue.try_push(a));
+    EXPECT_TRUE(queue.try_push(b));
+    EXPECT_FALSE(queue.try_push(c));
+    EXPECT_EQ(c, "c");
+
+    EXPECT_EQ(queue.try_pop(), "a");
+    EXPECT_TRUE(queue.try_push(c));
+    EXPECT_EQ(queue.try_pop(), "b");
+    EXPECT_EQ(queue.try_pop(), "c");
+    EXPECT_FALSE(queue.try_pop().has_value());
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(CortexSpscQueueTest, Bulk) {
+    spsc_queue<int> queue(4);
+    std::vector<int> items {1, 2, 3, 4, 5, 6};
+
+    auto rest = queue.try_push_bulk(items.begin(), items.end());
+    EXPECT_EQ(rest - items.begin(), 4);
+
+    std::vector<int> consumed;
+    EXPECT_EQ(queue.consume_all([&](int&& item) { consumed.push_back(item); }), 4);
+    EXPECT_EQ(consumed, (std::vector<int> {1, 2, 3, 4}));
+
+    rest = queue.try_push_bulk(rest, items.end());
+    EXPECT_EQ(rest, items.end());
+    EXPECT_EQ(queue.consume_all([&](int&& item) { consumed.push_back(item); }), 2);
+    EXPECT_EQ(consumed, (std::vector<int> {1, 2, 3, 4, 5, 6}));
+}
+
+TEST(CortexSpscQueueTest, ProducerConsumer) {
+    static constexpr int kItems = 1000000;
+    spsc_queue<int> queue(64);
+
+    std::thread producer([&] {
+        for (int i = 0; i < kItems; ++i) {
+            int item = i;
+            while (!queue.try_push(item)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    while (expected != kItems) {
+        queue.consume_all([&](int&& item) { EXPECT_EQ(item, expected++); });
+    }
+    producer.join();
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,306 @@
+#include <cortex/channel.hpp>
+#include <cortex/error.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/sharded_runtime.hpp>
+#include <cortex/task_group.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <thread>
+
+using namespace cortex;
+
+namespace {
+
+struct MyException : std::exception {};
+
+/// Counts the destructors run by unwound stacks.
+struct unwind_probe {
+    explicit unwind_probe(std::atomic<int>& counter)
+        : destroyed(counter) {}
+
+    unwind_probe(const unwind_probe&) = delete;
+    unwind_probe(unwind_probe&&) = delete;
+    unwind_probe& operator=(const unwind_probe&) = delete;
+    unwind_probe& operator=(unwind_probe&&) = delete;
+
+    ~unwind_probe() {
+        ++destroyed;
+    }
+
+    std::atomic<int>& destroyed;
+};
+
+} // namespace
+
+TEST(CortexTaskGroupTest, CreateOutsideOfFiber) {
+    EXPECT_THROW(task_group(), fiber::not_in_fiber);
+}
+
+TEST(CortexTaskGroupTest, NullRoutine) {
+    auto sched = work_stealing_scheduler::create(1);
+    task_group group(*sched);
+    EXPECT_THROW(group.spawn(nullptr), invalid_argument_error);
+}
+
+TEST(CortexTaskGroupTest, JoinWaitsForChildren) {
+    static constexpr int kChildren = 1000;
+    auto sched = work_stealing_scheduler::create(4);
+    std::atomic<int> finished {0};
+    int seen = 0;
+
+    sched->spawn([&] {
+        task_group group;
+        for (int i = 0; i < kChildren; ++i) {
+            group.spawn([&] {
+                fiber::yield();
+                ++finished;
+            });
+        }
+        group.join();
+        seen = finished.load();
+        EXPECT_EQ(group.size(), 0);
+    });
+    sched->wait();
+
+    EXPECT_EQ(seen, kChildren);
+}
+
+TEST(CortexTaskGroupTest, JoinRethrowsFirstFailure) {
+    auto sched = work_stealing_scheduler::create(2);
+    bool caught = false;
+
+    sched->spawn([&] {
+        task_group group;
+        group.spawn([] { throw MyException(); });
+        group.spawn([] {});
+        try {
+            group.join();
+        } catch (const MyException&) {
+            caught = true;
+        }
+        EXPECT_FALSE(group.is_cancelled());
+    });
+    // The failure went to the group, not to the scheduler.
+    EXPECT_NO_THROW(sched->wait());
+
+    EXPECT_TRUE(caught);
+}
+
+TEST(CortexTaskGroupTest, FailureCancelsSiblings) {
+    static constexpr int kSiblings = 16;
+    auto sched = work_stealing_scheduler::create(4);
+    std::atomic<int> destroyed {0};
+    std::atomic<int> started {0};
+    bool caught = false;
+
+    sched->spawn([&] {
+        task_group group;
+        for (int i = 0; i < kSiblings; ++i) {
+            group.spawn([&] {
+                const unwind_probe probe(destroyed);
+                ++started;
+                while (true) {
+                    fiber::yield();
+                }
+            });
+        }
+        group.spawn([&] {
+            while (started.load() != kSiblings) {
+                fiber::yield();
+            }
+            throw MyException();
+        });
+
+        try {
+            group.join();
+        } catch (const MyException&) {
+            caught = true;
+        }
+    });
+    sched->wait();
+
+    EXPECT_TRUE(caught);
+    EXPECT_EQ(destroyed.load(), kSiblings);
+}
+
+TEST(CortexTaskGroupTest, FailureCancelsParkedSibling) {
+    auto sched = work_stealing_scheduler::create(2);
+    std::atomic<int> destroyed {0};
+    std::atomic<bool> started {false};
+    bool caught = false;
+
+    sched->spawn([&] {
+        channel<int> never;
+        task_group group;
+        group.spawn([&] {
+            const unwind_probe probe(destroyed);
+            started = true;
+            // Nothing is ever sent, only the cancellation can wake the sibling.
+            [[maybe_unused]] const std::optional<int> value = never.receive();
+        });
+        group.spawn([&] {
+            while (!started.load()) {
+                fiber::yield();
+            }
+            // Gives the sibling time to park.
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            throw MyException();
+        });
+
+        try {
+            group.join();
+        } catch (const MyException&) {
+            caught = true;
+        }
+    });
+    sched->wait();
+
+    EXPECT_TRUE(caught);
+    EXPECT_EQ(destroyed.load(), 1);
+}
+
+TEST(CortexTaskGroupTest, CancelledGroupSkipsNewChildren) {
+    auto sched = work_stealing_scheduler::create(1);
+    bool ran = false;
+
+    sched->spawn([&] {
+        task_group group;
+        group.cancel();
+        EXPECT_TRUE(group.is_cancelled());
+        group.spawn([&] { ran = true; });
+        group.join();
+        EXPECT_FALSE(group.is_cancelled());
+    });
+    sched->wait();
+
+    EXPECT_FALSE(ran);
+}
+
+TEST(CortexTaskGroupTest, GroupIsReusableAfterJoin) {
+    auto sched = work_stealing_scheduler::create(2);
+    std::atomic<int> finished {0};
+
+    sched->spawn([&] {
+        task_group group;
+        group.spawn([] { throw MyException(); });
+        EXPECT_THROW(group.join(), MyException);
+
+        group.spawn([&] { ++finished; });
+        group.spawn([&] { ++finished; });
+        EXPECT_NO_THROW(group.join());
+    });
+    sched->wait();
+
+    EXPECT_EQ(finished.load(), 2);
+}
+
+TEST(CortexTaskGroupTest, DestructorCancelsAndJoins) {
+    auto sched = work_stealing_scheduler::create(2);
+    std::atomic<int> destroyed {0};
+    std::atomic<int> started {0};
+
+    sched->spawn([&] {
+        task_group group;
+        for (int i = 0; i < 8; ++i) {
+            group.spawn([&] {
+                const unwind_probe probe(destroyed);
+                ++started;
+                while (true) {
+                    fiber::yield();
+                }
+            });
+        }
+        // Children that have not started by now unwind before they run.
+        fiber::yield();
+    });
+    sched->wait();
+
+    EXPECT_EQ(destroyed.load(), started.load());
+}
+
+TEST(CortexTaskGroupTest, NestedGroups) {
+    auto sched = work_stealing_scheduler::create(4);
+    std::atomic<int> leaves {0};
+
+    sched->spawn([&] {
+        task_group outer;
+        for (int i = 0; i < 8; ++i) {
+            outer.spawn([&] {
+                task_group inner;
+                for (int j = 0; j < 8; ++j) {
+                    inner.spawn([&] { ++leaves; });
+                }
+                inner.join();
+            });
+        }
+        outer.join();
+    });
+    sched->wait();
+
+    EXPECT_EQ(leaves.load(), 64);
+}
+
+TEST(CortexTaskGroupTest, ChildrenOnShard) {
+    sharded_runtime::options opts;
+    opts.pin_threads = false;
+    auto rt = sharded_runtime::create(2, opts);
+    std::atomic<int> on_shard {0};
+    bool caught = false;
+
+    rt->submit(1, [&] {
+        task_group group;
+        for (int i = 0; i < 10; ++i) {
+            group.spawn([&] {
+                if (sharded_runtime::current_shard() == 1) {
+                    ++on_shard;
+                }
+            });
+        }
+        group.join();
+
+        group.spawn([] { throw MyException(); });
+        try {
+            group.join();
+        } catch (const MyException&) {
+            caught = true;
+        }
+    });
+    rt->wait();
+
+    EXPECT_TRUE(caught);
+    EXPECT_EQ(on_shard.load(), 10);
+}
+
+TEST(CortexTaskGroupTest, CancelledFiberUnwindsWithoutException) {
+    auto sched = work_stealing_scheduler::create(1);
+    std::atomic<int> destroyed {0};
+    std::atomic<fiber*> looping {nullptr};
+
+    sched->spawn([&] {
+        const unwind_probe probe(destroyed);
+        looping = fiber::current();
+        while (true) {
+            fiber::yield();
+        }
+    });
+    sched->spawn([&] {
+        while (looping.load() == nullptr) {
+            fiber::yield();
+        }
+        looping.load()->cancel();
+    });
+    EXPECT_NO_THROW(sched->wait());
+
+    EXPECT_EQ(destroyed.load(), 1);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,173 @@
+#include <cortex/basic_flow.hpp>
+#include <cortex/coroutine.hpp>
+#include <cortex/execution.hpp>
+#include <cortex/stack_allocator.hpp>
+#include <cortex/this_coroutine.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+using namespace cortex;
+
+namespace {
+
+/// Library code several frames down, unaware of the coroutine it runs on.
+void deep(int depth, int& steps) {
+    if (depth > 0) {
+        deep(depth - 1, steps);
+        return;
+    }
+
+    ++steps;
+    this_coroutine::suspend();
+    ++steps;
+}
+
+/// Counts the blocks taken from it and not given back.
+struct counting_resource : std::pmr::memory_resource {
+    std::size_t allocations = 0;
+    std::size_t outstanding = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations;
+        ++outstanding;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        --outstanding;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+} // namespace
+
+TEST(CortexThisCoroutineTest, OutsideOfExecutions) {
+    EXPECT_EQ(this_coroutine::get(), nullptr);
+    EXPECT_FALSE(this_coroutine::is_inside());
+    EXPECT_THROW(this_coroutine::suspend(), this_coroutine::not_in_coroutine);
+}
+
+TEST(CortexThisCoroutineTest, DeepSuspend) {
+    int steps = 0;
+    auto routine = coroutine::make_routine([&] {
+        EXPECT_TRUE(this_coroutine::is_inside());
+        deep(32, steps);
+    });
+    auto co = coroutine::create(routine.get());
+
+    co.resume();
+    EXPECT_EQ(steps, 1);
+    EXPECT_FALSE(this_coroutine::is_inside());
+
+    co.resume();
+    EXPECT_EQ(steps, 2);
+    EXPECT_TRUE(co.is_completed());
+}
+
+TEST(CortexThisCoroutineTest, NestedExecutions) {
+    static constexpr std::size_t stack_size = 1000000;
+    std::vector<int> trace;
+
+    auto inner = execution::create(stack_allocator::create(stack_size), basic_flow::make([&](api::suspendable& s) {
+                                       EXPECT_EQ(this_coroutine::get(), &s);
+                                       trace.push_back(2);
+                                       this_coroutine::suspend();
+                                       trace.push_back(5);
+                                   }));
+
+    auto outer = execution::create(stack_allocator::create(stack_size), basic_flow::make([&](api::suspendable& s) {
+                                       trace.push_back(1);
+                                       inner.resume();
+                                       // Back from the inner execution, which is not current anymore.
+                                       EXPECT_EQ(this_coroutine::get(), &s);
+                                       trace.push_back(3);
+                                       this_coroutine::suspend();
+                                       inner.resume();
+                                       trace.push_back(6);
+                                   }));
+
+    outer.resume();
+    trace.push_back(4);
+    outer.resume();
+
+    EXPECT_EQ(trace, (std::vector<int> {1, 2, 3, 4, 5, 6}));
+}
+
+TEST(CortexThisCoroutineTest, CancelledCoroutineUnwinds) {
+    bool after_suspend = false;
+    coroutine* self = nullptr;
+    auto routine = coroutine::make_routine([&] {
+        self->cancel();
+        this_coroutine::suspend();
+        after_suspend = true;
+    });
+    auto co = coroutine::create(routine.get());
+    self = &co;
+
+    co.resume();
+
+    EXPECT_TRUE(co.is_completed());
+    EXPECT_FALSE(after_suspend);
+}
+
+TEST(CortexThisCoroutineTest, FiberYields) {
+    auto sched = work_stealing_scheduler::create(1);
+    std::vector<int> trace;
+
+    sched->spawn([&] {
+        sched->spawn([&] { trace.push_back(2); });
+        trace.push_back(1);
+        // Yields, so the only worker runs the other fiber first.
+        this_coroutine::suspend();
+        trace.push_back(3);
+    });
+    sched->wait();
+
+    EXPECT_EQ(trace, (std::vector<int> {1, 2, 3}));
+}
+
+TEST(CortexThisCoroutineTest, MemoryResourceIsReleasedWithTheExecution) {
+    counting_resource upstream;
+    std::pmr::memory_resource* prev = std::pmr::set_default_resource(&upstream);
+    EXPECT_EQ(this_coroutine::memory_resource(), &upstream);
+
+    std::pmr::memory_resource* arena = nullptr;
+    auto routine = coroutine::make_routine([&] {
+        arena = this_coroutine::memory_resource();
+        for (int i = 0; i < 1000; ++i) {
+            // Never given back one by one, the blocks go once the coroutine is done.
+            [[maybe_unused]] void* p = arena->allocate(16, alignof(std::max_align_t));
+        }
+        std::pmr::vector<int> values(arena);
+        values.assign(100, 42);
+        this_coroutine::suspend();
+        EXPECT_EQ(this_coroutine::memory_resource(), arena);
+    });
+    auto co = coroutine::create(routine.get());
+
+    co.resume();
+    EXPECT_NE(arena, nullptr);
+    EXPECT_NE(arena, &upstream);
+    // Chained blocks, far fewer than the allocations.
+    EXPECT_GT(upstream.outstanding, 0);
+    EXPECT_LT(upstream.allocations, 16);
+
+    co.resume();
+    EXPECT_TRUE(co.is_completed());
+    EXPECT_EQ(upstream.outstanding, 0);
+    std::pmr::set_default_resource(prev);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,129 @@
+#include <cortex/error.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/timer_service.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace cortex;
+using namespace std::chrono_literals;
+
+TEST(CortexTimerServiceTest, NonPositiveResolution) {
+    EXPECT_THROW(timer_service::create(0ms), invalid_argument_error);
+}
+
+TEST(CortexTimerServiceTest, SleepOutsideOfFiber) {
+    auto timers = timer_service::create();
+    EXPECT_THROW(timers->sleep_for(1ms), fiber::not_in_fiber);
+}
+
+TEST(CortexTimerServiceTest, SleepForLastsAtLeastTheDuration) {
+    auto timers = timer_service::create();
+    auto sched = work_stealing_scheduler::create(1);
+    timer_service::clock::duration slept {};
+
+    sched->spawn([&] {
+        const auto start = timer_service::clock::now();
+        timers->sleep_for(20ms);
+        slept = timer_service::clock::now() - start;
+    });
+    sched->wait();
+
+    EXPECT_GE(slept, 20ms);
+    EXPECT_EQ(timers->pending(), 0);
+}
+
+TEST(CortexTimerServiceTest, SleepingFiberDoesNotBlockItsThread) {
+    auto timers = timer_service::create();
+    auto sched = work_stealing_scheduler::create(1);
+    std::atomic<bool> sleeper_done {false};
+    bool other_ran_first = false;
+
+    sched->spawn([&] {
+        timers->sleep_for(50ms);
+        sleeper_done = true;
+    });
+    sched->spawn([&] { other_ran_first = !sleeper_done.load(); });
+    sched->wait();
+
+    EXPECT_TRUE(other_ran_first);
+}
+
+TEST(CortexTimerServiceTest, WakesInDeadlineOrder) {
+    auto timers = timer_service::create();
+    auto sched = work_stealing_scheduler::create(1);
+    std::mutex mutex;
+    std::vector<int> order;
+
+    // Spawned in reverse, each sleep is 10 ms longer than the previous one.
+    for (int i = 4; i >= 0; --i) {
+        sched->spawn([&, i] {
+            timers->sleep_for(std::chrono::milliseconds(10 + 10 * i));
+            std::lock_guard lock(mutex);
+            order.push_back(i);
+        });
+    }
+    sched->wait();
+
+    EXPECT_EQ(order, (std::vector<int> {0, 1, 2, 3, 4}));
+}
+
+TEST(CortexTimerServiceTest, ManySleepingFibers) {
+    static constexpr int kFibers = 10000;
+    auto timers = timer_service::create();
+    auto sched = work_stealing_scheduler::create(2);
+    std::atomic<int> woken {0};
+
+    for (int i = 0; i < kFibers; ++i) {
+        sched->spawn([&, i] {
+            timers->sleep_for(std::chrono::milliseconds(1 + i % 50));
+            ++woken;
+        });
+    }
+    sched->wait();
+
+    EXPECT_EQ(woken.load(), kFibers);
+    EXPECT_EQ(timers->pending(), 0);
+}
+
+TEST(CortexTimerServiceTest, TimeoutFiresCallback) {
+    auto timers = timer_service::create();
+    std::atomic<bool> fired {false};
+
+    {
+        const timer_service::timeout t(
+            *timers, timer_service::clock::now() + 5ms, [](void* arg) { *static_cast<std::atomic<bool>*>(arg) = true; },
+            &fired);
+        while (!fired.load()) {
+            std::this_thread::yield();
+        }
+    }
+
+    EXPECT_EQ(timers->pending(), 0);
+}
+
+TEST(CortexTimerServiceTest, CancelledTimeoutNeverFires) {
+    auto timers = timer_service::create();
+    std::atomic<bool> fired {false};
+
+    {
+        const timer_service::timeout t(
+            *timers, timer_service::clock::now() + 20ms,
+            [](void* arg) { *static_cast<std::atomic<bool>*>(arg) = true; }, &fired);
+        EXPECT_EQ(timers->pending(), 1);
+    }
+    EXPECT_EQ(timers->pending(), 0);
+
+    std::this_thread::sleep_for(40ms);
+    EXPECT_FALSE(fired.load());
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,157 @@
+#include <cortex/timer_wheel.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+using namespace cortex;
+
+namespace {
+
+std::vector<timer_wheel::entry*> collect(timer_wheel::entry* expired) {
+    std::vector<timer_wheel::entry*> entries;
+    for (; expired != nullptr; expired = expired->next) {
+        entries.push_back(expired);
+    }
+    return entries;
+}
+
+} // namespace
+
+TEST(CortexTimerWheelTest, Empty) {
+    timer_wheel wheel;
+
+    EXPECT_TRUE(wheel.empty());
+    EXPECT_FALSE(wheel.next_deadline().has_value());
+    EXPECT_EQ(wheel.advance(1000), nullptr);
+    EXPECT_EQ(wheel.now(), 1000);
+}
+
+TEST(CortexTimerWheelTest, ExpiresAtDeadline) {
+    timer_wheel wheel;
+    timer_wheel::entry e;
+
+    wheel.schedule(e, 10);
+    EXPECT_EQ(wheel.size(), 1);
+    EXPECT_EQ(wheel.next_deadline(), 10);
+
+    EXPECT_EQ(wheel.advance(9), nullptr);
+    EXPECT_EQ(collect(wheel.advance(10)), std::vector<timer_wheel::entry*> {&e});
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(CortexTimerWheelTest, OverdueExpiresOnNextAdvance) {
+    timer_wheel wheel(100);
+    timer_wheel::entry e;
+
+    wheel.schedule(e, 50);
+    EXPECT_EQ(wheel.next_deadline(), 100);
+    EXPECT_EQ(collect(wheel.advance(100)), std::vector<timer_wheel::entry*> {&e});
+}
+
+TEST(CortexTimerWheelTest, Cancel) {
+    timer_wheel wheel;
+    timer_wheel::entry first;
+    timer_wheel::entry second;
+
+    wheel.schedule(first, 5000);
+    wheel.schedule(second, 5000);
+    EXPECT_TRUE(wheel.cancel(first));
+    EXPECT_FALSE(wheel.cancel(first));
+
+    EXPECT_EQ(collect(wheel.advance(5000)), std::vector<timer_wheel::entry*> {&second});
+    EXPECT_FALSE(wheel.cancel(second));
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(CortexTimerWheelTest, CancelLastEntryClearsSlot) {
+    timer_wheel wheel;
+    timer_wheel::entry e;
+
+    wheel.schedule(e, 70000);
+    EXPECT_TRUE(wheel.cancel(e));
+    EXPECT_FALSE(wheel.next_deadline().has_value());
+}
+
+TEST(CortexTimerWheelTest, CascadesThroughLevels) {
+    timer_wheel wheel;
+    std::vector<timer_wheel::tick_t> deadlines {1, 63, 64, 65, 4095, 4096, 262143, 262145, 16777217, 1073741825};
+    std::vector<timer_wheel::entry> entries(deadlines.size());
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        wheel.schedule(entries[i], deadlines[i]);
+    }
+
+    // Jump from one reported deadline to the next, every entry has to expire exactly at its tick.
+    std::size_t fired = 0;
+    while (const auto next = wheel.next_deadline()) {
+        for (timer_wheel::entry* e : collect(wheel.advance(*next))) {
+            EXPECT_EQ(e->deadline, *next);
+            ++fired;
+        }
+    }
+    EXPECT_EQ(fired, deadlines.size());
+}
+
+TEST(CortexTimerWheelTest, BeyondSpan) {
+    timer_wheel wheel(12345);
+    timer_wheel::entry e;
+    const timer_wheel::tick_t deadline = 12345 + 3 * timer_wheel::span + 7;
+
+    wheel.schedule(e, deadline);
+    EXPECT_EQ(wheel.advance(deadline - 1), nullptr);
+    EXPECT_EQ(collect(wheel.advance(deadline)), std::vector<timer_wheel::entry*> {&e});
+}
+
+TEST(CortexTimerWheelTest, LargeStepExpiresEverythingDue) {
+    timer_wheel wheel;
+    std::vector<timer_wheel::entry> entries(1000);
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        wheel.schedule(entries[i], 1 + i * 997);
+    }
+
+    const timer_wheel::tick_t now = 500000;
+    const auto expired = collect(wheel.advance(now));
+    const auto due = std::count_if(entries.begin(), entries.end(), [&](const auto& e) { return e.deadline <= now; });
+    EXPECT_EQ(static_cast<std::ptrdiff_t>(expired.size()), due);
+    EXPECT_EQ(wheel.size(), entries.size() - expired.size());
+    for (const timer_wheel::entry* e : expired) {
+        EXPECT_LE(e->deadline, now);
+    }
+}
+
+TEST(CortexTimerWheelTest, MillionTimers) {
+    static constexpr std::size_t kTimers = 1'000'000;
+    timer_wheel wheel;
+    std::vector<timer_wheel::entry> entries(kTimers);
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<timer_wheel::tick_t> deadline(1, 600'000);
+
+    for (auto& e : entries) {
+        wheel.schedule(e, deadline(rng));
+    }
+    // Every other timer is cancelled, as idle timeouts are when their connection shows activity.
+    for (std::size_t i = 0; i < kTimers; i += 2) {
+        EXPECT_TRUE(wheel.cancel(entries[i]));
+    }
+    EXPECT_EQ(wheel.size(), kTimers / 2);
+
+    std::size_t fired = 0;
+    timer_wheel::tick_t last = 0;
+    for (timer_wheel::tick_t now = 1000; now <= 600'000; now += 1000) {
+        for (timer_wheel::entry* e : collect(wheel.advance(now))) {
+            EXPECT_GT(e->deadline, last);
+            EXPECT_LE(e->deadline, now);
+            ++fired;
+        }
+        last = now;
+    }
+    EXPECT_EQ(fired, kTimers / 2);
+    EXPECT_TRUE(wheel.empty());
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
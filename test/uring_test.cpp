@@ -0,0 +1,238 @@
+#include <cortex/error.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/uring.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace cortex;
+
+namespace {
+
+std::array<int, 2> make_pipe() {
+    std::array<int, 2> fds {};
+    EXPECT_EQ(::pipe2(fds.data(), O_CLOEXEC), 0);
+    return fds;
+}
+
+int make_temporary_file() {
+    std::string path = "/tmp/cortex_uring_XXXXXX";
+    const int fd = ::mkstemp(path.data());
+    EXPECT_GE(fd, 0);
+    ::unlink(path.c_str());
+    return fd;
+}
+
+/// Listening socket on an ephemeral loopback port.
+int make_listener(sockaddr_in& address) {
+    const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    EXPECT_GE(fd, 0);
+
+    address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    EXPECT_EQ(::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    EXPECT_EQ(::listen(fd, 128), 0);
+
+    socklen_t length = sizeof(address);
+    EXPECT_EQ(::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length), 0);
+    return fd;
+}
+
+} // namespace
+
+TEST(CortexUringTest, ZeroEntries) {
+    EXPECT_THROW(uring::create(0), invalid_argument_error);
+}
+
+TEST(CortexUringTest, SubmitOutsideOfFiber) {
+    auto ring = uring::create();
+    auto [read_fd, write_fd] = make_pipe();
+    std::array<char, 16> buffer {};
+
+    EXPECT_THROW(ring->async_read(read_fd, buffer.data(), buffer.size()), fiber::not_in_fiber);
+
+    ::close(read_fd);
+    ::close(write_fd);
+}
+
+TEST(CortexUringTest, ReadParksUntilWrite) {
+    auto ring = uring::create();
+    auto sched = work_stealing_scheduler::create(2);
+    auto [read_fd, write_fd] = make_pipe();
+    std::atomic<bool> received {false};
+    std::string message;
+
+    sched->spawn([&] {
+        std::array<char, 16> buffer {};
+        const std::size_t size = ring->async_read(read_fd, buffer.data(), buffer.size());
+        message.assign(buffer.data(), size);
+        received = true;
+    });
+    sched->spawn([&] {
+        // Let the reader park first.
+        for (int i = 0; i < 100; ++i) {
+            fiber::yield();
+        }
+        EXPECT_FALSE(received.load());
+        EXPECT_EQ(ring->async_write(write_fd, "hello", 5), 5);
+    });
+    sched->wait();
+
+    EXPECT_EQ(message, "hello");
+    ::close(read_fd);
+    ::close(write_fd);
+}
+
+TEST(CortexUringTest, FileAtOffsets) {
+    static constexpr int kBlocks = 64;
+    static constexpr std::size_t kBlockSize = 4096;
+    auto ring = uring::create(8);
+    auto sched = work_stealing_scheduler::create(2);
+    const int fd = make_temporary_file();
+
+    // More writes in flight than submission entries.
+    for (int i = 0; i < kBlocks; ++i) {
+        sched->spawn([&, i] {
+            const std::vector<char> block(kBlockSize, static_cast<char>('a' + i % 26));
+            const std::uint64_t offset = static_cast<std::uint64_t>(i) * kBlockSize;
+            EXPECT_EQ(ring->async_write(fd, block.data(), block.size(), offset), kBlockSize);
+        });
+    }
+    sched->wait();
+
+    sched->spawn([&] { ring->async_fsync(fd); });
+    sched->wait();
+
+    std::atomic<int> matched {0};
+    for (int i = 0; i < kBlocks; ++i) {
+        sched->spawn([&, i] {
+            std::vector<char> block(kBlockSize);
+            const std::uint64_t offset = static_cast<std::uint64_t>(i) * kBlockSize;
+            ASSERT_EQ(ring->async_read(fd, block.data(), block.size(), offset), kBlockSize);
+            if (block == std::vector<char>(kBlockSize, static_cast<char>('a' + i % 26))) {
+                ++matched;
+            }
+        });
+    }
+    sched->wait();
+
+    EXPECT_EQ(matched.load(), kBlocks);
+    ::close(fd);
+}
+
+TEST(CortexUringTest, ErrorIsRethrown) {
+    auto ring = uring::create();
+    auto sched = work_stealing_scheduler::create(1);
+    int code = 0;
+
+    sched->spawn([&] {
+        std::array<char, 16> buffer {};
+        try {
+            ring->async_read(-1, buffer.data(), buffer.size());
+        } catch (const system_error& e) {
+            code = e.code();
+        }
+    });
+    sched->wait();
+
+    EXPECT_EQ(code, EBADF);
+}
+
+TEST(CortexUringTest, EchoOverLoopback) {
+    static constexpr int kClients = 8;
+    static constexpr int kMessages = 100;
+    auto ring = uring::create();
+    auto sched = work_stealing_scheduler::create(2);
+
+    sockaddr_in address {};
+    const int listener = make_listener(address);
+    std::atomic<int> echoed {0};
+
+    sched->spawn([&] {
+        for (int i = 0; i < kClients; ++i) {
+            const int connection = ring->async_accept(listener);
+            work_stealing_scheduler::current()->spawn([&ring, connection] {
+                std::array<char, 256> buffer {};
+                while (const std::size_t size = ring->async_read(connection, buffer.data(), buffer.size())) {
+                    ring->async_write(connection, buffer.data(), size);
+                }
+                ::close(connection);
+            });
+        }
+    });
+
+    for (int i = 0; i < kClients; ++i) {
+        sched->spawn([&, i] {
+            const int client = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            ring->async_connect(client, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+
+            for (int m = 0; m < kMessages; ++m) {
+                const std::string message = std::to_string(i) + ":" + std::to_string(m);
+                ASSERT_EQ(ring->async_write(client, message.data(), message.size()), message.size());
+
+                std::string reply(message.size(), '\0');
+                std::size_t received = 0;
+                while (received != reply.size()) {
+                    const std::size_t size = ring->async_read(client, reply.data() + received, reply.size() - received);
+                    ASSERT_NE(size, 0);
+                    received += size;
+                }
+                EXPECT_EQ(reply, message);
+                ++echoed;
+            }
+            ::close(client);
+        });
+    }
+    sched->wait();
+    ::close(listener);
+
+    EXPECT_EQ(echoed.load(), kClients * kMessages);
+}
+
+TEST(CortexUringTest, ConnectionRefused) {
+    auto ring = uring::create();
+    auto sched = work_stealing_scheduler::create(1);
+
+    // Bound but not listening.
+    sockaddr_in address {};
+    const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ASSERT_EQ(::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    socklen_t length = sizeof(address);
+    ASSERT_EQ(::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length), 0);
+
+    bool refused = false;
+    sched->spawn([&] {
+        const int client = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        try {
+            ring->async_connect(client, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+        } catch (const system_error& e) {
+            refused = e.code() == ECONNREFUSED;
+        }
+        ::close(client);
+    });
+    sched->wait();
+    ::close(fd);
+
+    EXPECT_TRUE(refused);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
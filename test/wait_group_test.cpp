@@ -0,0 +1,74 @@
+#include <cortex/fiber.hpp>
+#include <cortex/wait_group.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+using namespace cortex;
+
+TEST(CortexWaitGroupTest, NegativeCounter) {
+    EXPECT_THROW(wait_group(-1), wait_group::negative_counter);
+
+    wait_group wg;
+    EXPECT_TRUE(wg.try_wait());
+    EXPECT_THROW(wg.done(), wait_group::negative_counter);
+}
+
+TEST(CortexWaitGroupTest, ZeroDoesNotWait) {
+    wait_group wg;
+    EXPECT_NO_THROW(wg.wait());
+}
+
+TEST(CortexWaitGroupTest, WaitOutsideOfFiber) {
+    wait_group wg(1);
+    EXPECT_THROW(wg.wait(), fiber::not_in_fiber);
+}
+
+TEST(CortexWaitGroupTest, ForkJoin) {
+    auto sched = work_stealing_scheduler::create(4);
+    std::atomic<int> finished {0};
+    int seen = -1;
+
+    sched->spawn([&] {
+        wait_group wg;
+        for (int i = 0; i < 100; ++i) {
+            wg.add(1);
+            work_stealing_scheduler::current()->spawn([&] {
+                fiber::yield();
+                ++finished;
+                wg.done();
+            });
+        }
+        wg.wait();
+        seen = finished.load();
+    });
+    sched->wait();
+
+    EXPECT_EQ(seen, 100);
+}
+
+TEST(CortexWaitGroupTest, Latch) {
+    auto sched = work_stealing_scheduler::create(2);
+    wait_group latch(1);
+    std::atomic<int> passed {0};
+
+    for (int i = 0; i < 10; ++i) {
+        sched->spawn([&] {
+            latch.wait();
+            ++passed;
+        });
+    }
+    sched->spawn([&] {
+        EXPECT_EQ(passed.load(), 0);
+        latch.done();
+    });
+    sched->wait();
+
+    EXPECT_EQ(passed.load(), 10);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,115 @@
+#include <cortex/coroutine.hpp>
+#include <cortex/error.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/this_coroutine.hpp>
+#include <cortex/watchdog.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace cortex;
+
+namespace {
+
+using namespace std::chrono_literals;
+
+/// Keeps the processor busy without any switch.
+void hog(std::chrono::steady_clock::duration duration) {
+    const auto until = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < until) {
+    }
+}
+
+struct collector {
+    watchdog::options options(std::chrono::steady_clock::duration threshold) {
+        watchdog::options opts;
+        opts.threshold = threshold;
+        opts.interval = 5ms;
+        opts.handler = [this](const watchdog::report& r) {
+            const std::lock_guard lock(mutex);
+            reports.push_back(r);
+        };
+        return opts;
+    }
+
+    std::mutex mutex;
+    std::vector<watchdog::report> reports;
+};
+
+} // namespace
+
+TEST(CortexWatchdogTest, InvalidArguments) {
+    watchdog::options opts;
+    opts.threshold = 0ms;
+    EXPECT_THROW(watchdog::create(opts), invalid_argument_error);
+
+    auto dog = watchdog::create({});
+    EXPECT_THROW(watchdog::create({}), watchdog::already_running);
+}
+
+TEST(CortexWatchdogTest, ReportsHoggingFiber) {
+    collector c;
+    auto dog = watchdog::create(c.options(20ms));
+    auto sched = work_stealing_scheduler::create(1);
+
+    sched->spawn([] { hog(150ms); });
+    sched->wait();
+    dog.reset();
+
+    ASSERT_EQ(c.reports.size(), 1);
+    const watchdog::report& r = c.reports.front();
+    EXPECT_NE(r.execution, nullptr);
+    EXPECT_NE(r.thread, std::this_thread::get_id());
+    EXPECT_GE(r.running, 20ms);
+#if defined(__linux__)
+    EXPECT_FALSE(r.frames.empty());
+    EXPECT_NE(r.to_string().find("#0"), std::string::npos);
+#endif
+}
+
+TEST(CortexWatchdogTest, ReportsOncePerResume) {
+    collector c;
+    auto dog = watchdog::create(c.options(20ms));
+
+    auto routine = coroutine::make_routine([] {
+        hog(100ms);
+        this_coroutine::suspend();
+        hog(100ms);
+    });
+    auto co = coroutine::create(routine.get());
+    co.resume();
+    co.resume();
+    dog.reset();
+
+    ASSERT_EQ(c.reports.size(), 2);
+    EXPECT_EQ(c.reports[0].execution, c.reports[1].execution);
+    EXPECT_EQ(c.reports[0].thread, std::this_thread::get_id());
+}
+
+TEST(CortexWatchdogTest, QuietFibersAreNotReported) {
+    collector c;
+    auto dog = watchdog::create(c.options(50ms));
+    auto sched = work_stealing_scheduler::create(2);
+
+    for (int i = 0; i < 100; ++i) {
+        sched->spawn([] {
+            for (int step = 0; step < 10; ++step) {
+                hog(100us);
+                fiber::yield();
+            }
+        });
+    }
+    sched->wait();
+    dog.reset();
+
+    EXPECT_TRUE(c.reports.empty());
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
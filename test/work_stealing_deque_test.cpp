@@ -0,0 +1,107 @@
+#include <cortex/work_stealing_deque.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace cortex;
+
+TEST(CortexWorkStealingDequeTest, PopIsLifo) {
+    work_stealing_deque<int> deque;
+    int items[3] = {0, 1, 2};
+
+    EXPECT_EQ(deque.pop(), nullptr);
+    for (auto& item : items) {
+        deque.push(&item);
+    }
+
+    EXPECT_EQ(deque.size(), 3);
+    EXPECT_EQ(deque.pop(), &items[2]);
+    EXPECT_EQ(deque.pop(), &items[1]);
+    EXPECT_EQ(deque.pop(), &items[0]);
+    EXPECT_EQ(deque.pop(), nullptr);
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST(CortexWorkStealingDequeTest, StealIsFifo) {
+    work_stealing_deque<int> deque;
+    int items[3] = {0, 1, 2};
+
+    EXPECT_EQ(deque.steal(), nullptr);
+    for (auto& item : items) {
+        deque.push(&item);
+    }
+
+    EXPECT_EQ(deque.steal(), &items[0]);
+    EXPECT_EQ(deque.steal(), &items[1]);
+    EXPECT_EQ(deque.pop(), &items[2]);
+    EXPECT_EQ(deque.steal(), nullptr);
+}
+
+TEST(CortexWorkStealingDequeTest, Grows) {
+    work_stealing_deque<int> deque(2);
+    std::vector<int> items(1000);
+
+    for (auto& item : items) {
+        deque.push(&item);
+    }
+    EXPECT_EQ(deque.size(), items.size());
+
+    for (auto it = items.rbegin(); it != items.rend(); ++it) {
+        EXPECT_EQ(deque.pop(), &*it);
+    }
+}
+
+TEST(CortexWorkStealingDequeTest, EveryItemIsTakenOnce) {
+    static constexpr std::size_t kItems = 200000;
+    static constexpr std::size_t kThieves = 3;
+
+    work_stealing_deque<std::atomic<int>> deque(4);
+    std::vector<std::atomic<int>> items(kItems);
+    std::atomic<std::size_t> taken {0};
+    std::atomic<bool> done {false};
+
+    std::vector<std::thread> thieves;
+    for (std::size_t i = 0; i < kThieves; ++i) {
+        thieves.emplace_back([&] {
+            while (!done.load()) {
+                if (auto* item = deque.steal(); item != nullptr) {
+                    item->fetch_add(1);
+                    taken.fetch_add(1);
+                }
+            }
+        });
+    }
+
+    for (std::size_t i = 0; i < kItems; ++i) {
+        deque.push(&items[i]);
+        if (i % 3 == 0) {
+            if (auto* item = deque.pop(); item != nullptr) {
+                item->fetch_add(1);
+                taken.fetch_add(1);
+            }
+        }
+    }
+    while (auto* item = deque.pop()) {
+        item->fetch_add(1);
+        taken.fetch_add(1);
+    }
+
+    while (taken.load() != kItems) {
+        std::this_thread::yield();
+    }
+    done = true;
+    for (auto& t : thieves) {
+        t.join();
+    }
+
+    for (auto& item : items) {
+        EXPECT_EQ(item.load(), 1);
+    }
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,173 @@
+#include <cortex/error.hpp>
+#include <cortex/fiber.hpp>
+#include <cortex/work_stealing_scheduler.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace cortex;
+
+namespace {
+
+struct MyException : std::exception {};
+
+struct publish_args {
+    std::atomic<fiber*>* slot;
+    fiber* self;
+};
+
+void publish(void* arg) {
+    auto* args = static_cast<publish_args*>(arg);
+    args->slot->store(args->self);
+}
+
+} // namespace
+
+TEST(CortexWorkStealingSchedulerTest, ZeroWorkers) {
+    EXPECT_THROW(work_stealing_scheduler::create(0), invalid_argument_error);
+}
+
+TEST(CortexWorkStealingSchedulerTest, JustWorks) {
+    auto sched = work_stealing_scheduler::create(2);
+    std::atomic<int> counter {0};
+
+    for (int i = 0; i < 100; ++i) {
+        sched->spawn([&] {
+            EXPECT_NE(fiber::current(), nullptr);
+            EXPECT_EQ(work_stealing_scheduler::current(), sched.get());
+            ++counter;
+        });
+    }
+    sched->wait();
+
+    EXPECT_EQ(counter.load(), 100);
+    EXPECT_EQ(fiber::current(), nullptr);
+    EXPECT_EQ(work_stealing_scheduler::current(), nullptr);
+}
+
+TEST(CortexWorkStealingSchedulerTest, Yield) {
+    auto sched = work_stealing_scheduler::create(1);
+    std::vector<int> trace;
+
+    // Spawned from a fiber, so both are queued before either of them runs.
+    sched->spawn([&] {
+        for (int id = 0; id < 2; ++id) {
+            work_stealing_scheduler::current()->spawn([&trace, id] {
+                for (int i = 0; i < 3; ++i) {
+                    trace.push_back(id);
+                    fiber::yield();
+                }
+            });
+        }
+    });
+    sched->wait();
+
+    ASSERT_EQ(trace.size(), 6);
+    for (std::size_t i = 1; i < trace.size(); ++i) {
+        EXPECT_NE(trace[i], trace[i - 1]);
+    }
+}
+
+TEST(CortexWorkStealingSchedulerTest, YieldAcrossWorkers) {
+    auto sched = work_stealing_scheduler::create(4);
+    std::atomic<std::size_t> steps {0};
+
+    for (int i = 0; i < 64; ++i) {
+        sched->spawn([&] {
+            for (int j = 0; j < 100; ++j) {
+                // A yielded fiber may be resumed by any worker.
+                ++steps;
+                fiber::yield();
+            }
+        });
+    }
+    sched->wait();
+
+    EXPECT_EQ(steps.load(), 6400);
+}
+
+TEST(CortexWorkStealingSchedulerTest, YieldOutsideOfFiber) {
+    EXPECT_THROW(fiber::yield(), fiber::not_in_fiber);
+}
+
+TEST(CortexWorkStealingSchedulerTest, ParkAndWakeFromAnotherThread) {
+    auto sched = work_stealing_scheduler::create(2);
+    std::atomic<fiber*> parked {nullptr};
+    std::atomic<int> steps {0};
+
+    sched->spawn([&] {
+        ++steps;
+        // The hook runs once the fiber is switched out, only then it is safe to hand it to another thread.
+        publish_args args {&parked, fiber::current()};
+        args.self->park(&publish, &args);
+        ++steps;
+    });
+
+    fiber* f = nullptr;
+    while ((f = parked.load()) == nullptr) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(steps.load(), 1);
+
+    f->wake();
+    sched->wait();
+    EXPECT_EQ(steps.load(), 2);
+}
+
+TEST(CortexWorkStealingSchedulerTest, NestedSpawn) {
+    auto sched = work_stealing_scheduler::create(4);
+    std::atomic<std::size_t> nodes {0};
+
+    std::function<void(int)> tree = [&](int depth) {
+        ++nodes;
+        if (depth == 0) {
+            return;
+        }
+        for (int i = 0; i < 3; ++i) {
+            work_stealing_scheduler::current()->spawn([&tree, depth] { tree(depth - 1); });
+        }
+    };
+
+    sched->spawn([&] { tree(6); });
+    sched->wait();
+
+    // 1 + 3 + ... + 3^6
+    EXPECT_EQ(nodes.load(), 1093);
+}
+
+TEST(CortexWorkStealingSchedulerTest, Exception) {
+    auto sched = work_stealing_scheduler::create(2);
+    std::atomic<int> counter {0};
+
+    sched->spawn([] { throw MyException {}; });
+    sched->spawn([&] { ++counter; });
+
+    EXPECT_THROW(sched->wait(), MyException);
+    EXPECT_EQ(counter.load(), 1);
+    EXPECT_NO_THROW(sched->wait());
+}
+
+TEST(CortexWorkStealingSchedulerTest, WaitFromWorker) {
+    auto sched = work_stealing_scheduler::create(1);
+    bool thrown = false;
+
+    sched->spawn([&] {
+        try {
+            sched->wait();
+        } catch (const work_stealing_scheduler::wait_from_worker&) {
+            thrown = true;
+        }
+    });
+    sched->wait();
+
+    EXPECT_TRUE(thrown);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}